@@ -64,7 +64,7 @@ let package = Package(
         .testTarget(name: "JetpackStatsWidgetsCoreTests", dependencies: [.target(name: "JetpackStatsWidgetsCore")]),
         .testTarget(name: "DesignSystemTests", dependencies: [.target(name: "DesignSystem")]),
         .testTarget(name: "WordPressFluxTests", dependencies: ["WordPressFlux"]),
-        .testTarget(name: "WordPressSharedTests", dependencies: [.target(name: "WordPressShared")]),
+        .testTarget(name: "WordPressSharedTests", dependencies: [.target(name: "WordPressShared")], resources: [.process("Resources")]),
         .testTarget(name: "WordPressSharedObjCTests", dependencies: [.target(name: "WordPressShared")], resources: [.process("Resources")]),
         .testTarget(name: "WordPressUITests", dependencies: [.target(name: "WordPressUI")]),
     ]
@@ -51,17 +51,36 @@ import WordPressSharedObjC
             return string
         }
 
-        var content = string
-        content = removeForbiddenTags(content)
-        content = normalizeParagraphs(content)
-        content = removeInlineStyles(content)
+        // The tag rewrites are applied in one scan, equivalent to running
+        // `removeForbiddenTags`, `normalizeParagraphs` and `removeInlineStyles`
+        // one after the other. The other passes only run when their markers
+        // are present.
+        var content = RichContentScanner.rewrite(string, applying: [.forbiddenTags, .paragraphs, .inlineStyles])
         content = (content as NSString).replacingHTMLEmoticonsWithEmoji() as String
-        content = formatGutenbergGallery(content)
-        content = resizeGalleryImageURL(content, isPrivateSite: isPrivate)
-        content = formatVideoTags(content)
+        if content.range(of: "gallery-item", options: .caseInsensitive) != nil {
+            content = formatGutenbergGallery(content)
+        }
+        if content.range(of: "data-orig-file", options: .caseInsensitive) != nil {
+            content = resizeGalleryImageURL(content, isPrivateSite: isPrivate)
+        }
+        if content.range(of: "<video", options: .caseInsensitive) != nil {
+            content = formatVideoTags(content)
+        }
         return content
     }
 
+    /// Removes forbidden HTML tags and inline style attributes from the specified string.
+    /// Equivalent to `removeInlineStyles(removeForbiddenTags(string))`, in a single pass.
+    ///
+    /// - Parameters:
+    ///     - string: The content string to format.
+    ///
+    /// - Returns: The formatted string.
+    ///
+    @objc public class func removeForbiddenTagsAndInlineStyles(_ string: String) -> String {
+        return RichContentScanner.rewrite(string, applying: [.forbiddenTags, .inlineStyles])
+    }
+
     /// Removes forbidden HTML tags from the specified string.
     ///
     /// - Parameters:
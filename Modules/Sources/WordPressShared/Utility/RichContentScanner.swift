@@ -0,0 +1,408 @@
+import Foundation
+
+/// Applies the markup rewrites of `RichContentFormatter` in a single forward scan over the
+/// UTF-16 code units of a document, writing into one preallocated output buffer.
+///
+/// Every rewrite mirrors one of the formatter's regular expressions, and the scanner keeps
+/// just enough state to reproduce the result of running those expressions one after the
+/// other. For well-formed markup the output is identical to the chained passes.
+///
+struct RichContentScanner {
+
+    struct Rewrites: OptionSet {
+        let rawValue: Int
+
+        /// Removes `<style>` and `<script>` blocks, and Gutenberg comments wrapped in paragraphs.
+        static let forbiddenTags = Rewrites(rawValue: 1 << 0)
+
+        /// Converts DIV tags to P tags, collapses duplicate P tags and removes new lines
+        /// outside of `<pre>` blocks.
+        static let paragraphs = Rewrites(rawValue: 1 << 1)
+
+        /// Removes `style="..."` attributes.
+        static let inlineStyles = Rewrites(rawValue: 1 << 2)
+    }
+
+    /// Returns `string` with the specified rewrites applied.
+    ///
+    static func rewrite(_ string: String, applying rewrites: Rewrites) -> String {
+        guard !string.isEmpty, !rewrites.isEmpty else {
+            return string
+        }
+
+        var scanner = RichContentScanner(source: Array(string.utf16), rewrites: rewrites)
+        let output = scanner.run()
+        return String(utf16CodeUnits: output, count: output.count)
+    }
+
+    // MARK: - State
+
+    private let source: [UInt16]
+    private let rewrites: Rewrites
+    private var output: [UInt16] = []
+
+    private var closingAngleBracket: Lookahead
+    private var closingQuote: Lookahead
+    private var styleBlockEnd: Lookahead
+    private var scriptBlockEnd: Lookahead
+    private var preBlockEnd: Lookahead
+
+    /// Output offset of a `<p...>` tag followed by nothing but whitespace so far. The next
+    /// `<p...>` tag collapses both into a single `<p>` (`<p[^>]*>\s*<p[^>]*>`).
+    private var openParagraphCandidate: Int?
+
+    /// Output offset of a `</p>` tag followed by nothing but whitespace so far (`</p>\s*</p>`).
+    private var closeParagraphCandidate: Int?
+
+    /// A `<p...>` tag being copied: where it starts in the output, and where its `>` is in the source.
+    private var pendingOpenParagraph: (outputOffset: Int, end: Int)?
+
+    /// Output offset of the tag that opened the current `<pre>` block, if any.
+    private var preBlockStart: Int?
+
+    private init(source: [UInt16], rewrites: Rewrites) {
+        self.source = source
+        self.rewrites = rewrites
+        closingAngleBracket = Lookahead(pattern: Pattern.greaterThan, source: source)
+        closingQuote = Lookahead(pattern: Pattern.quote, source: source)
+        styleBlockEnd = Lookahead(pattern: Pattern.styleClose, source: source)
+        scriptBlockEnd = Lookahead(pattern: Pattern.scriptClose, source: source)
+        preBlockEnd = Lookahead(pattern: Pattern.preClose, source: source)
+        output.reserveCapacity(source.count)
+    }
+
+    // MARK: - Scanning
+
+    private mutating func run() -> [UInt16] {
+        let removesNewLines = rewrites.contains(.paragraphs)
+        let removesInlineStyles = rewrites.contains(.inlineStyles)
+        var index = 0
+
+        while index < source.count {
+            let unit = source[index]
+
+            if unit == Unit.lessThan, let next = rewriteTag(at: index) {
+                index = next
+                continue
+            }
+
+            if removesInlineStyles, unit == Unit.lowercaseS || unit == Unit.uppercaseS, let next = removeInlineStyle(at: index) {
+                index = next
+                continue
+            }
+
+            if !(removesNewLines && unit == Unit.newline && preBlockStart == nil) {
+                append(unit)
+            }
+
+            if let pending = pendingOpenParagraph, pending.end == index {
+                openParagraphCandidate = pending.outputOffset
+                pendingOpenParagraph = nil
+            } else if !Self.isWhitespace(unit) {
+                openParagraphCandidate = nil
+                closeParagraphCandidate = nil
+            }
+
+            index += 1
+        }
+
+        return output
+    }
+
+    /// Handles a `<` at `index`. Returns the offset to resume scanning from if the source was
+    /// consumed, or `nil` if the `<` should be copied to the output.
+    ///
+    private mutating func rewriteTag(at index: Int) -> Int? {
+        if rewrites.contains(.forbiddenTags) {
+            var end = forbiddenBlockEnd(at: index)
+            if end == nil {
+                end = blockCommentParagraphEnd(at: index)
+            }
+            if let end {
+                cancelPendingOpenParagraph(endingBefore: end)
+                return end
+            }
+        }
+
+        if rewrites.contains(.paragraphs) {
+            if let next = rewriteParagraphTag(at: index) {
+                return next
+            }
+
+            if preBlockStart != nil && matches(Pattern.preClose, at: index) {
+                preBlockStart = nil
+            }
+        }
+
+        return nil
+    }
+
+    /// `<style[^>]*?>[\s\S]*?</style>` and `<script[^>]*?>[\s\S]*?</script>`
+    ///
+    private mutating func forbiddenBlockEnd(at index: Int) -> Int? {
+        if matches(Pattern.styleOpen, at: index) {
+            guard let tagEnd = closingAngleBracket.next(from: index + Pattern.styleOpen.count),
+                  let blockEnd = styleBlockEnd.next(from: tagEnd + 1) else {
+                return nil
+            }
+            return blockEnd + Pattern.styleClose.count
+        }
+
+        if matches(Pattern.scriptOpen, at: index) {
+            guard let tagEnd = closingAngleBracket.next(from: index + Pattern.scriptOpen.count),
+                  let blockEnd = scriptBlockEnd.next(from: tagEnd + 1) else {
+                return nil
+            }
+            return blockEnd + Pattern.scriptClose.count
+        }
+
+        return nil
+    }
+
+    /// `<p><!-- /?wp:.+? /?--></p>[\n]?`
+    ///
+    private mutating func blockCommentParagraphEnd(at index: Int) -> Int? {
+        guard matches(Pattern.commentParagraphOpen, at: index) else {
+            return nil
+        }
+
+        var cursor = index + Pattern.commentParagraphOpen.count
+        if cursor < source.count && source[cursor] == Unit.slash {
+            cursor += 1
+        }
+        guard matches(Pattern.blockNamespace, at: cursor) else {
+            return nil
+        }
+        cursor += Pattern.blockNamespace.count
+
+        // `.+?` is the shortest run of at least one character that doesn't cross a new line.
+        var end: Int?
+        var candidate = cursor + 1
+        while candidate <= source.count && source[candidate - 1] != Unit.newline {
+            if matches(Pattern.selfClosingCommentParagraphClose, at: candidate) {
+                end = candidate + Pattern.selfClosingCommentParagraphClose.count
+                break
+            }
+            if matches(Pattern.commentParagraphClose, at: candidate) {
+                end = candidate + Pattern.commentParagraphClose.count
+                break
+            }
+            candidate += 1
+        }
+
+        guard var end else {
+            return nil
+        }
+
+        // Style and script blocks are removed first, so the optional new line may follow them.
+        while let blockEnd = forbiddenBlockEnd(at: end) {
+            end = blockEnd
+        }
+        if end < source.count && source[end] == Unit.newline {
+            end += 1
+        }
+        return end
+    }
+
+    /// `<div[^>]*>` → `<p>`, `</div>` → `</p>`, `<p[^>]*>\s*<p[^>]*>` → `<p>` and `</p>\s*</p>` → `</p>`.
+    /// Also tracks `<pre[^>]*>[\s\S]*?</pre>` blocks, inside which new lines are preserved.
+    ///
+    private mutating func rewriteParagraphTag(at index: Int) -> Int? {
+        let isDivClose = matches(Pattern.divClose, at: index)
+        if isDivClose || matches(Pattern.paragraphClose, at: index) {
+            let end = index + (isDivClose ? Pattern.divClose.count : Pattern.paragraphClose.count)
+            openParagraphCandidate = nil
+            if let candidate = closeParagraphCandidate {
+                truncateOutput(to: candidate)
+                append(Pattern.paragraphClose)
+                closeParagraphCandidate = nil
+            } else {
+                closeParagraphCandidate = output.count
+                append(isDivClose ? Pattern.paragraphClose[...] : source[index..<end])
+            }
+            cancelPendingOpenParagraph(endingBefore: end)
+            return end
+        }
+
+        if matches(Pattern.divOpen, at: index), let tagEnd = closingAngleBracket.next(from: index + Pattern.divOpen.count) {
+            closeParagraphCandidate = nil
+            if let candidate = openParagraphCandidate {
+                truncateOutput(to: candidate)
+                append(Pattern.paragraphOpen)
+                openParagraphCandidate = nil
+            } else {
+                openParagraphCandidate = output.count
+                append(Pattern.paragraphOpen)
+            }
+            cancelPendingOpenParagraph(endingBefore: tagEnd + 1)
+            return tagEnd + 1
+        }
+
+        if matches(Pattern.paragraphOpenPrefix, at: index), let tagEnd = closingAngleBracket.next(from: index + Pattern.paragraphOpenPrefix.count) {
+            if let candidate = openParagraphCandidate {
+                truncateOutput(to: candidate)
+                append(Pattern.paragraphOpen)
+                openParagraphCandidate = nil
+                closeParagraphCandidate = nil
+                pendingOpenParagraph = nil
+                return tagEnd + 1
+            }
+
+            // The tag is copied unit by unit, so other rewrites still apply to its attributes.
+            pendingOpenParagraph = (output.count, tagEnd)
+            if preBlockStart == nil && matches(Pattern.preOpen, at: index) && preBlockEnd.next(from: tagEnd + 1) != nil {
+                preBlockStart = output.count
+            }
+        }
+
+        return nil
+    }
+
+    /// `\s*style="[^"]*"`
+    ///
+    private mutating func removeInlineStyle(at index: Int) -> Int? {
+        guard matches(Pattern.styleAttribute, at: index),
+              let end = closingQuote.next(from: index + Pattern.styleAttribute.count) else {
+            return nil
+        }
+
+        while let last = output.last, Self.isWhitespace(last) {
+            output.removeLast()
+        }
+        openParagraphCandidate = nil
+        closeParagraphCandidate = nil
+        cancelPendingOpenParagraph(endingBefore: end + 1)
+        return end + 1
+    }
+
+    // MARK: - Output
+
+    private mutating func append(_ unit: UInt16) {
+        output.append(unit)
+    }
+
+    private mutating func append<Units: Sequence>(_ units: Units) where Units.Element == UInt16 {
+        output.append(contentsOf: units)
+    }
+
+    private mutating func truncateOutput(to offset: Int) {
+        output.removeSubrange(offset...)
+
+        if let start = preBlockStart, offset <= start {
+            preBlockStart = nil
+        }
+    }
+
+    private mutating func cancelPendingOpenParagraph(endingBefore offset: Int) {
+        if let pending = pendingOpenParagraph, pending.end < offset {
+            pendingOpenParagraph = nil
+        }
+    }
+
+    // MARK: - Matching
+
+    private func matches(_ pattern: [UInt16], at index: Int) -> Bool {
+        Self.matches(pattern, in: source, at: index)
+    }
+
+    /// Case-insensitive (ASCII) comparison against a lowercase pattern.
+    ///
+    fileprivate static func matches(_ pattern: [UInt16], in source: [UInt16], at index: Int) -> Bool {
+        guard index >= 0, index + pattern.count <= source.count else {
+            return false
+        }
+        for offset in 0..<pattern.count {
+            var unit = source[index + offset]
+            if unit >= Unit.uppercaseA && unit <= Unit.uppercaseZ {
+                unit += Unit.lowercaseA - Unit.uppercaseA
+            }
+            if unit != pattern[offset] {
+                return false
+            }
+        }
+        return true
+    }
+
+    /// Matches `\s` in `NSRegularExpression` patterns (the Unicode `White_Space` property).
+    ///
+    private static func isWhitespace(_ unit: UInt16) -> Bool {
+        switch unit {
+        case 0x09...0x0D, 0x20, 0x85, 0xA0, 0x1680, 0x2000...0x200A, 0x2028, 0x2029, 0x202F, 0x205F, 0x3000:
+            return true
+        default:
+            return false
+        }
+    }
+}
+
+// MARK: - Lookahead
+
+/// Finds the next occurrence of a pattern at or after an offset. The last result is
+/// remembered, so repeated queries made while scanning forward stay linear overall.
+///
+private struct Lookahead {
+    let pattern: [UInt16]
+    let source: [UInt16]
+    var lastQuery = Int.max
+    var lastMatch: Int?
+    var exhaustedFrom: Int?
+
+    mutating func next(from index: Int) -> Int? {
+        if let exhaustedFrom, index >= exhaustedFrom {
+            return nil
+        }
+        if let lastMatch, lastQuery <= index, lastMatch >= index {
+            return lastMatch
+        }
+
+        var cursor = index
+        while cursor + pattern.count <= source.count {
+            if RichContentScanner.matches(pattern, in: source, at: cursor) {
+                lastQuery = index
+                lastMatch = cursor
+                return cursor
+            }
+            cursor += 1
+        }
+
+        exhaustedFrom = index
+        return nil
+    }
+}
+
+// MARK: - Constants
+
+private enum Unit {
+    static let newline = UInt16(UInt8(ascii: "\n"))
+    static let slash = UInt16(UInt8(ascii: "/"))
+    static let lessThan = UInt16(UInt8(ascii: "<"))
+    static let greaterThan = UInt16(UInt8(ascii: ">"))
+    static let lowercaseS = UInt16(UInt8(ascii: "s"))
+    static let uppercaseS = UInt16(UInt8(ascii: "S"))
+    static let lowercaseA = UInt16(UInt8(ascii: "a"))
+    static let uppercaseA = UInt16(UInt8(ascii: "A"))
+    static let uppercaseZ = UInt16(UInt8(ascii: "Z"))
+}
+
+/// Lowercase patterns, compared case-insensitively unless noted otherwise.
+///
+private enum Pattern {
+    static let greaterThan = Array(">".utf16)
+    static let quote = Array("\"".utf16)
+    static let styleOpen = Array("<style".utf16)
+    static let styleClose = Array("</style>".utf16)
+    static let scriptOpen = Array("<script".utf16)
+    static let scriptClose = Array("</script>".utf16)
+    static let commentParagraphOpen = Array("<p><!-- ".utf16)
+    static let blockNamespace = Array("wp:".utf16)
+    static let commentParagraphClose = Array(" --></p>".utf16)
+    static let selfClosingCommentParagraphClose = Array(" /--></p>".utf16)
+    static let divOpen = Array("<div".utf16)
+    static let divClose = Array("</div>".utf16)
+    static let paragraphOpenPrefix = Array("<p".utf16)
+    static let paragraphOpen = Array("<p>".utf16)
+    static let paragraphClose = Array("</p>".utf16)
+    static let preOpen = Array("<pre".utf16)
+    static let preClose = Array("</pre>".utf16)
+    static let styleAttribute = Array("style=\"".utf16)
+}
@@ -1,5 +1,4 @@
 #import "DisplayableImageHelper.h"
-#import "NSString+Util.h"
 
 static const NSInteger FeaturedImageMinimumWidth = 150;
 
@@ -7,6 +6,225 @@ static NSString * const AttachmentsDictionaryKeyWidth = @"width";
 static NSString * const AttachmentsDictionaryKeyURL = @"URL";
 static NSString * const AttachmentsDictionaryKeyMimeType = @"mime_type";
 
+/// The `size-*` classes WordPress adds to inserted images, from least to most preferred.
+typedef NS_ENUM(NSInteger, DisplayableImageSizeClass) {
+    DisplayableImageSizeClassNone = 0,
+    DisplayableImageSizeClassMedium,
+    DisplayableImageSizeClassLarge,
+    DisplayableImageSizeClassFull,
+};
+
+/// The attributes of an `<img>` tag used to pick an image, as ranges of the scanned buffer.
+typedef struct {
+    NSRange src;
+    NSRange srcset;
+    NSRange width;
+    NSRange className;
+} DisplayableImageTag;
+
+static inline BOOL DisplayableImageIsWhitespace(unichar c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+static inline BOOL DisplayableImageIsDigit(unichar c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/// Case-insensitively checks whether `buffer` has the lowercase ASCII `string` at `index`.
+static BOOL DisplayableImageMatches(const unichar *buffer, NSUInteger length, NSUInteger index, const char *string)
+{
+    for (NSUInteger i = 0; string[i] != '\0'; i++) {
+        if (index + i >= length) {
+            return NO;
+        }
+        unichar c = buffer[index + i];
+        if (c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+        if (c != (unichar)string[i]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+static BOOL DisplayableImageRangeIsEqual(const unichar *buffer, NSRange range, const char *string)
+{
+    return range.length == strlen(string) && DisplayableImageMatches(buffer, NSMaxRange(range), range.location, string);
+}
+
+static BOOL DisplayableImageRangeContains(const unichar *buffer, NSRange range, const char *string)
+{
+    if (range.location == NSNotFound) {
+        return NO;
+    }
+    size_t count = strlen(string);
+    for (NSUInteger i = range.location; i + count <= NSMaxRange(range); i++) {
+        if (DisplayableImageMatches(buffer, NSMaxRange(range), i, string)) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+/// Reads the leading digits of `range`, ignoring leading whitespace, like `-[NSString integerValue]`.
+static NSInteger DisplayableImageIntegerValue(const unichar *buffer, NSRange range)
+{
+    if (range.location == NSNotFound) {
+        return 0;
+    }
+    NSUInteger i = range.location;
+    NSUInteger end = NSMaxRange(range);
+    while (i < end && DisplayableImageIsWhitespace(buffer[i])) {
+        i++;
+    }
+    NSInteger value = 0;
+    for (; i < end && DisplayableImageIsDigit(buffer[i]); i++) {
+        if (value > (NSIntegerMax - 9) / 10) {
+            return NSIntegerMax;
+        }
+        value = value * 10 + (buffer[i] - '0');
+    }
+    return value;
+}
+
+/// Reads the `w` query parameter that Photon and resized images carry in their URL.
+static NSInteger DisplayableImageQueryWidth(const unichar *buffer, NSRange src)
+{
+    NSUInteger end = NSMaxRange(src);
+    NSUInteger i = src.location;
+    while (i < end && buffer[i] != '?') {
+        i++;
+    }
+    // `;` covers an HTML-encoded `&amp;`
+    for (; i + 2 < end; i++) {
+        unichar c = buffer[i];
+        if ((c == '?' || c == '&' || c == ';') && buffer[i + 1] == 'w' && buffer[i + 2] == '=') {
+            return DisplayableImageIntegerValue(buffer, NSMakeRange(i + 3, end - i - 3));
+        }
+    }
+    return 0;
+}
+
+/// Returns the largest width descriptor (e.g. `1024w`) of a `srcset` attribute.
+static NSInteger DisplayableImageSrcsetWidth(const unichar *buffer, NSRange srcset)
+{
+    if (srcset.location == NSNotFound) {
+        return 0;
+    }
+    NSInteger largest = 0;
+    NSUInteger end = NSMaxRange(srcset);
+    for (NSUInteger i = srcset.location; i < end; i++) {
+        if (!DisplayableImageIsWhitespace(buffer[i])) {
+            continue;
+        }
+        NSUInteger start = i + 1;
+        NSUInteger j = start;
+        while (j < end && DisplayableImageIsDigit(buffer[j])) {
+            j++;
+        }
+        if (j == start || j >= end || buffer[j] != 'w') {
+            continue;
+        }
+        BOOL isDescriptorEnd = j + 1 == end || buffer[j + 1] == ',' || DisplayableImageIsWhitespace(buffer[j + 1]);
+        if (isDescriptorEnd) {
+            largest = MAX(largest, DisplayableImageIntegerValue(buffer, NSMakeRange(start, j - start)));
+        }
+    }
+    return largest;
+}
+
+static DisplayableImageSizeClass DisplayableImageSizeClassOf(const unichar *buffer, NSRange className)
+{
+    if (DisplayableImageRangeContains(buffer, className, "size-full")) {
+        return DisplayableImageSizeClassFull;
+    }
+    if (DisplayableImageRangeContains(buffer, className, "size-large")) {
+        return DisplayableImageSizeClassLarge;
+    }
+    if (DisplayableImageRangeContains(buffer, className, "size-medium")) {
+        return DisplayableImageSizeClassMedium;
+    }
+    return DisplayableImageSizeClassNone;
+}
+
+/// WordPress emoji, and `.svg` images which can't be displayed in a `UIImageView`.
+static BOOL DisplayableImageIsIgnoredSource(const unichar *buffer, NSRange src)
+{
+    return DisplayableImageRangeContains(buffer, src, "/images/core/emoji/") ||
+        DisplayableImageRangeContains(buffer, src, "/wp-includes/images/smilies/") ||
+        DisplayableImageRangeContains(buffer, src, "/wp-content/mu-plugins/wpcom-smileys/") ||
+        DisplayableImageRangeContains(buffer, src, ".svg");
+}
+
+/// Scans the attributes of a tag, starting right after its name, up to the closing `>`.
+/// Returns the index of the first character after the tag.
+static NSUInteger DisplayableImageScanTag(const unichar *buffer, NSUInteger length, NSUInteger index, DisplayableImageTag *tag)
+{
+    NSRange notFound = NSMakeRange(NSNotFound, 0);
+    *tag = (DisplayableImageTag){ notFound, notFound, notFound, notFound };
+
+    NSUInteger i = index;
+    while (i < length) {
+        while (i < length && (DisplayableImageIsWhitespace(buffer[i]) || buffer[i] == '/')) {
+            i++;
+        }
+        if (i >= length) {
+            break;
+        }
+        if (buffer[i] == '>') {
+            return i + 1;
+        }
+
+        NSUInteger nameStart = i;
+        while (i < length && !DisplayableImageIsWhitespace(buffer[i]) && buffer[i] != '=' && buffer[i] != '>' && buffer[i] != '/') {
+            i++;
+        }
+        NSRange name = NSMakeRange(nameStart, i - nameStart);
+        while (i < length && DisplayableImageIsWhitespace(buffer[i])) {
+            i++;
+        }
+        if (i >= length || buffer[i] != '=') {
+            // An attribute without a value
+            continue;
+        }
+        i++;
+        while (i < length && DisplayableImageIsWhitespace(buffer[i])) {
+            i++;
+        }
+
+        NSRange value;
+        if (i < length && (buffer[i] == '"' || buffer[i] == '\'')) {
+            unichar quote = buffer[i++];
+            NSUInteger valueStart = i;
+            while (i < length && buffer[i] != quote) {
+                i++;
+            }
+            value = NSMakeRange(valueStart, i - valueStart);
+            i++;
+        } else {
+            NSUInteger valueStart = i;
+            while (i < length && !DisplayableImageIsWhitespace(buffer[i]) && buffer[i] != '>') {
+                i++;
+            }
+            value = NSMakeRange(valueStart, i - valueStart);
+        }
+
+        if (DisplayableImageRangeIsEqual(buffer, name, "src") && tag->src.location == NSNotFound) {
+            tag->src = value;
+        } else if (DisplayableImageRangeIsEqual(buffer, name, "srcset")) {
+            tag->srcset = value;
+        } else if (DisplayableImageRangeIsEqual(buffer, name, "width")) {
+            tag->width = value;
+        } else if (DisplayableImageRangeIsEqual(buffer, name, "class")) {
+            tag->className = value;
+        }
+    }
+    return length;
+}
+
 @implementation DisplayableImageHelper
 
 + (NSInteger)widthOfAttachment:(NSDictionary *)attachment {
@@ -16,10 +234,7 @@ static NSString * const AttachmentsDictionaryKeyMimeType = @"mime_type";
         NSNumber *number = (NSNumber *)obj;
         result = [number integerValue];
     } else if ([obj isKindOfClass:NSString.class]) {
-        NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-        numberFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
-        NSNumber *number= [numberFormatter numberFromString:(NSString *)obj];
-        result = [number integerValue];
+        result = [(NSString *)obj integerValue];
     }
     return result;
 }
@@ -83,49 +298,76 @@ static NSString * const AttachmentsDictionaryKeyMimeType = @"mime_type";
 {
     NSString *imageSrc = @"";
     // If there is no image tag in the content, just bail.
-    if (!content || [content rangeOfString:@"<img"].location == NSNotFound) {
+    if (!content || [content rangeOfString:@"<img" options:NSCaseInsensitiveSearch].location == NSNotFound) {
+        return imageSrc;
+    }
+
+    NSUInteger length = [content length];
+    unichar *buffer = malloc(length * sizeof(unichar));
+    if (buffer == NULL) {
         return imageSrc;
     }
+    [content getCharacters:buffer range:NSMakeRange(0, length)];
+
+    // Visit every image tag once, in order. The first one that is wide enough wins,
+    // otherwise fall back to the image with the largest size class.
+    NSRange sizeClassSrc = NSMakeRange(NSNotFound, 0);
+    DisplayableImageSizeClass bestSizeClass = DisplayableImageSizeClassNone;
+    // The block editor puts the size class on the `<figure>` around the image.
+    DisplayableImageSizeClass figureSizeClass = DisplayableImageSizeClassNone;
+
+    NSUInteger i = 0;
+    while (i < length) {
+        BOOL isFigureTag = buffer[i] == '<' &&
+            DisplayableImageMatches(buffer, length, i + 1, "figure") &&
+            i + 7 < length && DisplayableImageIsWhitespace(buffer[i + 7]);
+        if (isFigureTag) {
+            DisplayableImageTag tag;
+            i = DisplayableImageScanTag(buffer, length, i + 7, &tag);
+            figureSizeClass = DisplayableImageSizeClassOf(buffer, tag.className);
+            continue;
+        }
 
-    // Get all the things
-    static NSRegularExpression *regex;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        NSError *error;
-        NSString *imgPattern = @"<img(\\s+.*?)(?:src\\s*=\\s*(?:'|\")(.*?)(?:'|\"))(.*?)>";
-        regex = [NSRegularExpression regularExpressionWithPattern:imgPattern options:NSRegularExpressionCaseInsensitive error:&error];
-    });
-
-    // Find all the image tags in the content passed.
-    NSArray *matches = [regex matchesInString:content options:0 range:NSMakeRange(0, [content length])];
-
-    for (NSTextCheckingResult *match in matches) {
-        NSString *tag = [content substringWithRange:match.range];
-        NSString *src = [self extractSrcFromImgTag:tag];
-
-        // Ignore WordPress emoji images
-        if ([src rangeOfString:@"/images/core/emoji/"].location != NSNotFound ||
-            [src rangeOfString:@"/wp-includes/images/smilies/"].location != NSNotFound ||
-            [src rangeOfString:@"/wp-content/mu-plugins/wpcom-smileys/"].location != NSNotFound) {
+        BOOL isImageTag = buffer[i] == '<' &&
+            DisplayableImageMatches(buffer, length, i + 1, "img") &&
+            i + 4 < length && DisplayableImageIsWhitespace(buffer[i + 4]);
+        if (!isImageTag) {
+            i++;
             continue;
         }
 
-        // Ignore .svg images since we can't display them in a UIImageView
-        if ([src rangeOfString:@".svg"].location != NSNotFound) {
+        DisplayableImageTag tag;
+        i = DisplayableImageScanTag(buffer, length, i + 4, &tag);
+        DisplayableImageSizeClass enclosingSizeClass = figureSizeClass;
+        figureSizeClass = DisplayableImageSizeClassNone;
+        if (tag.src.location == NSNotFound || DisplayableImageIsIgnoredSource(buffer, tag.src)) {
             continue;
         }
 
-        // Check the tag for a good width
-        NSInteger width = MAX([self widthFromElementAttribute:tag], [self widthFromQueryString:src]);
+        NSInteger width = MAX(DisplayableImageIntegerValue(buffer, tag.width), DisplayableImageQueryWidth(buffer, tag.src));
+        width = MAX(width, DisplayableImageSrcsetWidth(buffer, tag.srcset));
         if (width > FeaturedImageMinimumWidth) {
-            imageSrc = src;
+            imageSrc = [content substringWithRange:tag.src];
             break;
         }
+
+        DisplayableImageSizeClass sizeClass = MAX(DisplayableImageSizeClassOf(buffer, tag.className), enclosingSizeClass);
+        if (sizeClass > bestSizeClass) {
+            bestSizeClass = sizeClass;
+            sizeClassSrc = tag.src;
+        }
     }
-    if (imageSrc.length == 0) {
-        imageSrc = [self searchContentBySizeClassForImageToFeature:content];
+
+    if (imageSrc.length == 0 && sizeClassSrc.location != NSNotFound) {
+        // Drop the query, which usually asks for a smaller version of the image.
+        NSUInteger end = sizeClassSrc.location;
+        while (end < NSMaxRange(sizeClassSrc) && buffer[end] != '?') {
+            end++;
+        }
+        imageSrc = [content substringWithRange:NSMakeRange(sizeClassSrc.location, end - sizeClassSrc.location)];
     }
 
+    free(buffer);
     return imageSrc;
 }
 
@@ -133,149 +375,65 @@ static NSString * const AttachmentsDictionaryKeyMimeType = @"mime_type";
 {
     NSMutableSet *resultSet = [NSMutableSet set];
     // If there is no gallery shortcode in the content, just bail.
-    if (!content || [content rangeOfString:@"[gallery "].location == NSNotFound) {
+    if (!content || [content rangeOfString:@"[gallery " options:NSCaseInsensitiveSearch].location == NSNotFound) {
         return resultSet;
     }
 
-    // Get all the things
-    static NSRegularExpression *regexGallery;
-    static dispatch_once_t onceTokenRegexGallery;
-    dispatch_once(&onceTokenRegexGallery, ^{
-        NSError *error;
-        NSString *galleryPattern = @"\\[gallery[^]]+ids=\"([0-9,]*)\"[^]]*\\]";
-        regexGallery = [NSRegularExpression regularExpressionWithPattern:galleryPattern options:NSRegularExpressionCaseInsensitive error:&error];
-    });
-
-    // Find all the gallery shortcodes in the content passed.
-    NSArray *matches = [regexGallery matchesInString:content options:0 range:NSMakeRange(0, [content length])];
+    NSUInteger length = [content length];
+    unichar *buffer = malloc(length * sizeof(unichar));
+    if (buffer == NULL) {
+        return resultSet;
+    }
+    [content getCharacters:buffer range:NSMakeRange(0, length)];
 
-    for (NSTextCheckingResult *match in matches) {
-        if (match.numberOfRanges < 2) {
+    for (NSUInteger i = 0; i < length; i++) {
+        if (buffer[i] != '[' || !DisplayableImageMatches(buffer, length, i + 1, "gallery")) {
             continue;
         }
-        NSString *tag = [content substringWithRange:[match rangeAtIndex:1]];
-        NSSet *tagIds = [self idsFromGallery:tag];
-        [resultSet unionSet:tagIds];
-    }
-    return resultSet;
-}
-
-/**
- Extract the path to an image from an image tag.
- 
- @param tag An image tag.
- @return The value of the src param.
- */
-+ (NSString *)extractSrcFromImgTag:(NSString *)tag
-{
-    static NSRegularExpression *regex;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        NSError *error;
-        NSString *srcPattern = @"src\\s*=\\s*(?:'|\")(.*?)(?:'|\")";
-        regex = [NSRegularExpression regularExpressionWithPattern:srcPattern options:NSRegularExpressionCaseInsensitive error:&error];
-    });
-
-    NSRange srcRng = [regex rangeOfFirstMatchInString:tag options:0 range:NSMakeRange(0, [tag length])];
-    NSString *src = [tag substringWithRange:srcRng];
-    NSCharacterSet *charSet = [NSCharacterSet characterSetWithCharactersInString:@"\"'="];
-    NSRange quoteRng = [src rangeOfCharacterFromSet:charSet];
-    src = [src substringFromIndex:quoteRng.location];
-    src = [src stringByTrimmingCharactersInSet:charSet];
-    return src;
-}
+        NSUInteger end = i + 8;
+        while (end < length && buffer[end] != ']') {
+            end++;
+        }
+        if (end == length) {
+            break;
+        }
 
-/**
- Search the passed string for an image that is a good candidate to feature.
- @param content The content string to search.
- @return The url path for the image or an empty string.
- */
-+ (NSString *)searchContentBySizeClassForImageToFeature:(NSString *)content
-{
-    NSString *str = @"";
-    // If there is no image tag in the content, just bail.
-    if (!content || [content rangeOfString:@"<img"].location == NSNotFound) {
-        return str;
-    }
-    // If there is not a large or full sized image, just bail.
-    NSString *className = @"size-full";
-    NSRange range = [content rangeOfString:className];
-    if (range.location == NSNotFound) {
-        className = @"size-large";
-        range = [content rangeOfString:className];
-        if (range.location == NSNotFound) {
-            className = @"size-medium";
-            range = [content rangeOfString:className];
-            if (range.location == NSNotFound) {
-                return str;
+        // WordPress uses the last `ids` attribute when a shortcode repeats it. Keep the last one that only lists numbers.
+        NSRange ids = NSMakeRange(NSNotFound, 0);
+        for (NSUInteger j = i + 9; j + 5 <= end; j++) {
+            if (!DisplayableImageMatches(buffer, end, j, "ids=\"")) {
+                continue;
+            }
+            NSUInteger valueStart = j + 5;
+            NSUInteger valueEnd = valueStart;
+            while (valueEnd < end && (DisplayableImageIsDigit(buffer[valueEnd]) || buffer[valueEnd] == ',')) {
+                valueEnd++;
+            }
+            if (valueEnd < end && buffer[valueEnd] == '"') {
+                ids = NSMakeRange(valueStart, valueEnd - valueStart);
             }
         }
-    }
-    // find the start of the image
-    range = [content rangeOfString:@"<img" options:NSBackwardsSearch | NSCaseInsensitiveSearch range:NSMakeRange(0, range.location)];
-    if (range.location == NSNotFound) {
-        return str;
-    }
-    // Build the regex once and keep it around for subsequent calls.
-    static NSRegularExpression *regex;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        NSError *error;
-        NSString *pattern = @"src=\"\\S+\"";
-        regex = [NSRegularExpression regularExpressionWithPattern:pattern options:NSRegularExpressionCaseInsensitive error:&error];
-    });
-    NSInteger length = [content length] - range.location;
-    range = [regex rangeOfFirstMatchInString:content options:0 range:NSMakeRange(range.location, length)];
-    if (range.location == NSNotFound) {
-        return str;
-    }
-    range = NSMakeRange(range.location+5, range.length-6);
-    str = [content substringWithRange:range];
-    str = [[str componentsSeparatedByString:@"?"] objectAtIndex:0];
-    return str;
-}
 
-+ (NSInteger)widthFromElementAttribute:(NSString *)tag
-{
-    NSRange rng = [tag rangeOfString:@"width=\""];
-    if (rng.location == NSNotFound) {
-        return 0;
-    }
-    NSInteger startingIdx = rng.location + rng.length;
-    rng = [tag rangeOfString:@"\"" options:NSCaseInsensitiveSearch range:NSMakeRange(startingIdx, [tag length] - startingIdx)];
-    if (rng.location == NSNotFound) {
-        return 0;
-    }
-
-    NSString *widthStr = [tag substringWithRange:NSMakeRange(startingIdx, rng.location - startingIdx)];
-    return [widthStr integerValue];
-}
-
-+ (NSInteger)widthFromQueryString:(NSString *)src
-{
-    NSURL *url = [NSURL URLWithString:src];
-    NSString *query = [url query];
-    NSRange rng = [query rangeOfString:@"w="];
-    if (rng.location == NSNotFound) {
-        return 0;
-    }
-
-    NSString *str = [query substringFromIndex:rng.location + rng.length];
-    NSString *widthStr = [[str componentsSeparatedByString:@"&"] firstObject];
-
-    return [widthStr integerValue];
-}
-
-+ (NSSet *)idsFromGallery:(NSString *)idsStr
-{
-    NSArray * imageIds = [idsStr componentsSeparatedByString:@","];
-    NSMutableSet *result = [NSMutableSet set];
-    for (NSString *imageIdStr in imageIds) {
-        NSNumber *numberId = [imageIdStr numericValue];
-        if (numberId) {
-            [result addObject:numberId];
+        if (ids.location != NSNotFound) {
+            unsigned long long value = 0;
+            BOOL hasDigits = NO;
+            for (NSUInteger k = ids.location; k <= NSMaxRange(ids); k++) {
+                if (k < NSMaxRange(ids) && DisplayableImageIsDigit(buffer[k])) {
+                    value = value * 10 + (buffer[k] - '0');
+                    hasDigits = YES;
+                } else {
+                    if (hasDigits) {
+                        [resultSet addObject:@(value)];
+                    }
+                    value = 0;
+                    hasDigits = NO;
+                }
+            }
         }
+        i = end;
     }
-    return result;
+
+    free(buffer);
+    return resultSet;
 }
 @end
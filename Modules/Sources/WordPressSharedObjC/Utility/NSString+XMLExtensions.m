@@ -5,295 +5,349 @@
 
 
 typedef struct {
-	__unsafe_unretained NSString *escapeSequence;
+	const char *name;
 	unichar uchar;
 } HTMLEscapeMap;
 
+// The longest entity name in the table below (`thetasym`).
+static const NSUInteger kHTMLEscapeMaxNameLength = 8;
+
 
 // Taken from http://www.w3.org/TR/xhtml1/dtds.html#a_dtd_Special_characters
-// Ordered by uchar lowest to highest for bsearching
-static HTMLEscapeMap gAsciiHTMLEscapeMap[] = {
-	// A.2.2. Special characters
-	{ @"&quot;", 34 },
-	{ @"&amp;", 38 },
-	{ @"&apos;", 39 },
-	{ @"&lt;", 60 },
-	{ @"&gt;", 62 },
-	
-    // A.2.1. Latin-1 characters
-	{ @"&nbsp;", 160 }, 
-	{ @"&iexcl;", 161 }, 
-	{ @"&cent;", 162 }, 
-	{ @"&pound;", 163 }, 
-	{ @"&curren;", 164 }, 
-	{ @"&yen;", 165 }, 
-	{ @"&brvbar;", 166 }, 
-	{ @"&sect;", 167 }, 
-	{ @"&uml;", 168 }, 
-	{ @"&copy;", 169 }, 
-	{ @"&ordf;", 170 }, 
-	{ @"&laquo;", 171 }, 
-	{ @"&not;", 172 }, 
-	{ @"&shy;", 173 }, 
-	{ @"&reg;", 174 }, 
-	{ @"&macr;", 175 }, 
-	{ @"&deg;", 176 }, 
-	{ @"&plusmn;", 177 }, 
-	{ @"&sup2;", 178 }, 
-	{ @"&sup3;", 179 }, 
-	{ @"&acute;", 180 }, 
-	{ @"&micro;", 181 }, 
-	{ @"&para;", 182 }, 
-	{ @"&middot;", 183 }, 
-	{ @"&cedil;", 184 }, 
-	{ @"&sup1;", 185 }, 
-	{ @"&ordm;", 186 }, 
-	{ @"&raquo;", 187 }, 
-	{ @"&frac14;", 188 }, 
-	{ @"&frac12;", 189 }, 
-	{ @"&frac34;", 190 }, 
-	{ @"&iquest;", 191 }, 
-	{ @"&Agrave;", 192 }, 
-	{ @"&Aacute;", 193 }, 
-	{ @"&Acirc;", 194 }, 
-	{ @"&Atilde;", 195 }, 
-	{ @"&Auml;", 196 }, 
-	{ @"&Aring;", 197 }, 
-	{ @"&AElig;", 198 }, 
-	{ @"&Ccedil;", 199 }, 
-	{ @"&Egrave;", 200 }, 
-	{ @"&Eacute;", 201 }, 
-	{ @"&Ecirc;", 202 }, 
-	{ @"&Euml;", 203 }, 
-	{ @"&Igrave;", 204 }, 
-	{ @"&Iacute;", 205 }, 
-	{ @"&Icirc;", 206 }, 
-	{ @"&Iuml;", 207 }, 
-	{ @"&ETH;", 208 }, 
-	{ @"&Ntilde;", 209 }, 
-	{ @"&Ograve;", 210 }, 
-	{ @"&Oacute;", 211 }, 
-	{ @"&Ocirc;", 212 }, 
-	{ @"&Otilde;", 213 }, 
-	{ @"&Ouml;", 214 }, 
-	{ @"&times;", 215 }, 
-	{ @"&Oslash;", 216 }, 
-	{ @"&Ugrave;", 217 }, 
-	{ @"&Uacute;", 218 }, 
-	{ @"&Ucirc;", 219 }, 
-	{ @"&Uuml;", 220 }, 
-	{ @"&Yacute;", 221 }, 
-	{ @"&THORN;", 222 }, 
-	{ @"&szlig;", 223 }, 
-	{ @"&agrave;", 224 }, 
-	{ @"&aacute;", 225 }, 
-	{ @"&acirc;", 226 }, 
-	{ @"&atilde;", 227 }, 
-	{ @"&auml;", 228 }, 
-	{ @"&aring;", 229 }, 
-	{ @"&aelig;", 230 }, 
-	{ @"&ccedil;", 231 }, 
-	{ @"&egrave;", 232 }, 
-	{ @"&eacute;", 233 }, 
-	{ @"&ecirc;", 234 }, 
-	{ @"&euml;", 235 }, 
-	{ @"&igrave;", 236 }, 
-	{ @"&iacute;", 237 }, 
-	{ @"&icirc;", 238 }, 
-	{ @"&iuml;", 239 }, 
-	{ @"&eth;", 240 }, 
-	{ @"&ntilde;", 241 }, 
-	{ @"&ograve;", 242 }, 
-	{ @"&oacute;", 243 }, 
-	{ @"&ocirc;", 244 }, 
-	{ @"&otilde;", 245 }, 
-	{ @"&ouml;", 246 }, 
-	{ @"&divide;", 247 }, 
-	{ @"&oslash;", 248 }, 
-	{ @"&ugrave;", 249 }, 
-	{ @"&uacute;", 250 }, 
-	{ @"&ucirc;", 251 }, 
-	{ @"&uuml;", 252 }, 
-	{ @"&yacute;", 253 }, 
-	{ @"&thorn;", 254 }, 
-	{ @"&yuml;", 255 },
-	
-	// A.2.2. Special characters cont'd
-	{ @"&OElig;", 338 },
-	{ @"&oelig;", 339 },
-	{ @"&Scaron;", 352 },
-	{ @"&scaron;", 353 },
-	{ @"&Yuml;", 376 },
-	
-	// A.2.3. Symbols
-	{ @"&fnof;", 402 }, 
-	
-	// A.2.2. Special characters cont'd
-	{ @"&circ;", 710 },
-	{ @"&tilde;", 732 },
-	
-	// A.2.3. Symbols cont'd
-	{ @"&Alpha;", 913 }, 
-	{ @"&Beta;", 914 }, 
-	{ @"&Gamma;", 915 }, 
-	{ @"&Delta;", 916 }, 
-	{ @"&Epsilon;", 917 }, 
-	{ @"&Zeta;", 918 }, 
-	{ @"&Eta;", 919 }, 
-	{ @"&Theta;", 920 }, 
-	{ @"&Iota;", 921 }, 
-	{ @"&Kappa;", 922 }, 
-	{ @"&Lambda;", 923 }, 
-	{ @"&Mu;", 924 }, 
-	{ @"&Nu;", 925 }, 
-	{ @"&Xi;", 926 }, 
-	{ @"&Omicron;", 927 }, 
-	{ @"&Pi;", 928 }, 
-	{ @"&Rho;", 929 }, 
-	{ @"&Sigma;", 931 }, 
-	{ @"&Tau;", 932 }, 
-	{ @"&Upsilon;", 933 }, 
-	{ @"&Phi;", 934 }, 
-	{ @"&Chi;", 935 }, 
-	{ @"&Psi;", 936 }, 
-	{ @"&Omega;", 937 }, 
-	{ @"&alpha;", 945 }, 
-	{ @"&beta;", 946 }, 
-	{ @"&gamma;", 947 }, 
-	{ @"&delta;", 948 }, 
-	{ @"&epsilon;", 949 }, 
-	{ @"&zeta;", 950 }, 
-	{ @"&eta;", 951 }, 
-	{ @"&theta;", 952 }, 
-	{ @"&iota;", 953 }, 
-	{ @"&kappa;", 954 }, 
-	{ @"&lambda;", 955 }, 
-	{ @"&mu;", 956 }, 
-	{ @"&nu;", 957 }, 
-	{ @"&xi;", 958 }, 
-	{ @"&omicron;", 959 }, 
-	{ @"&pi;", 960 }, 
-	{ @"&rho;", 961 }, 
-	{ @"&sigmaf;", 962 }, 
-	{ @"&sigma;", 963 }, 
-	{ @"&tau;", 964 }, 
-	{ @"&upsilon;", 965 }, 
-	{ @"&phi;", 966 }, 
-	{ @"&chi;", 967 }, 
-	{ @"&psi;", 968 }, 
-	{ @"&omega;", 969 }, 
-	{ @"&thetasym;", 977 }, 
-	{ @"&upsih;", 978 }, 
-	{ @"&piv;", 982 }, 
-	
-	// A.2.2. Special characters cont'd
-	{ @"&ensp;", 8194 },
-	{ @"&emsp;", 8195 },
-	{ @"&thinsp;", 8201 },
-	{ @"&zwnj;", 8204 },
-	{ @"&zwj;", 8205 },
-	{ @"&lrm;", 8206 },
-	{ @"&rlm;", 8207 },
-	{ @"&ndash;", 8211 },
-	{ @"&mdash;", 8212 },
-	{ @"&lsquo;", 8216 },
-	{ @"&rsquo;", 8217 },
-	{ @"&sbquo;", 8218 },
-	{ @"&ldquo;", 8220 },
-	{ @"&rdquo;", 8221 },
-	{ @"&bdquo;", 8222 },
-	{ @"&dagger;", 8224 },
-	{ @"&Dagger;", 8225 },
-    // A.2.3. Symbols cont'd  
-	{ @"&bull;", 8226 }, 
-	{ @"&hellip;", 8230 }, 
-	
-	// A.2.2. Special characters cont'd
-	{ @"&permil;", 8240 },
-	
-	// A.2.3. Symbols cont'd  
-	{ @"&prime;", 8242 }, 
-	{ @"&Prime;", 8243 }, 
-	
-	// A.2.2. Special characters cont'd
-	{ @"&lsaquo;", 8249 },
-	{ @"&rsaquo;", 8250 },
-	
-	// A.2.3. Symbols cont'd  
-	{ @"&oline;", 8254 }, 
-	{ @"&frasl;", 8260 }, 
-	
-	// A.2.2. Special characters cont'd
-	{ @"&euro;", 8364 },
-	
-	// A.2.3. Symbols cont'd  
-	{ @"&image;", 8465 },
-	{ @"&weierp;", 8472 }, 
-	{ @"&real;", 8476 }, 
-	{ @"&trade;", 8482 }, 
-	{ @"&alefsym;", 8501 }, 
-	{ @"&larr;", 8592 }, 
-	{ @"&uarr;", 8593 }, 
-	{ @"&rarr;", 8594 }, 
-	{ @"&darr;", 8595 }, 
-	{ @"&harr;", 8596 }, 
-	{ @"&crarr;", 8629 }, 
-	{ @"&lArr;", 8656 }, 
-	{ @"&uArr;", 8657 }, 
-	{ @"&rArr;", 8658 }, 
-	{ @"&dArr;", 8659 }, 
-	{ @"&hArr;", 8660 }, 
-	{ @"&forall;", 8704 }, 
-	{ @"&part;", 8706 }, 
-	{ @"&exist;", 8707 }, 
-	{ @"&empty;", 8709 }, 
-	{ @"&nabla;", 8711 }, 
-	{ @"&isin;", 8712 }, 
-	{ @"&notin;", 8713 }, 
-	{ @"&ni;", 8715 }, 
-	{ @"&prod;", 8719 }, 
-	{ @"&sum;", 8721 }, 
-	{ @"&minus;", 8722 }, 
-	{ @"&lowast;", 8727 }, 
-	{ @"&radic;", 8730 }, 
-	{ @"&prop;", 8733 }, 
-	{ @"&infin;", 8734 }, 
-	{ @"&ang;", 8736 }, 
-	{ @"&and;", 8743 }, 
-	{ @"&or;", 8744 }, 
-	{ @"&cap;", 8745 }, 
-	{ @"&cup;", 8746 }, 
-	{ @"&int;", 8747 }, 
-	{ @"&there4;", 8756 }, 
-	{ @"&sim;", 8764 }, 
-	{ @"&cong;", 8773 }, 
-	{ @"&asymp;", 8776 }, 
-	{ @"&ne;", 8800 }, 
-	{ @"&equiv;", 8801 }, 
-	{ @"&le;", 8804 }, 
-	{ @"&ge;", 8805 }, 
-	{ @"&sub;", 8834 }, 
-	{ @"&sup;", 8835 }, 
-	{ @"&nsub;", 8836 }, 
-	{ @"&sube;", 8838 }, 
-	{ @"&supe;", 8839 }, 
-	{ @"&oplus;", 8853 }, 
-	{ @"&otimes;", 8855 }, 
-	{ @"&perp;", 8869 }, 
-	{ @"&sdot;", 8901 }, 
-	{ @"&lceil;", 8968 }, 
-	{ @"&rceil;", 8969 }, 
-	{ @"&lfloor;", 8970 }, 
-	{ @"&rfloor;", 8971 }, 
-	{ @"&lang;", 9001 }, 
-	{ @"&rang;", 9002 }, 
-	{ @"&loz;", 9674 }, 
-	{ @"&spades;", 9824 }, 
-	{ @"&clubs;", 9827 }, 
-	{ @"&hearts;", 9829 }, 
-	{ @"&diams;", 9830 }
+// Names are stored without the surrounding `&` and `;`, ordered by `strcmp` for bsearching.
+static const HTMLEscapeMap gAsciiHTMLEscapeMap[] = {
+	{ "AElig", 198 },
+	{ "Aacute", 193 },
+	{ "Acirc", 194 },
+	{ "Agrave", 192 },
+	{ "Alpha", 913 },
+	{ "Aring", 197 },
+	{ "Atilde", 195 },
+	{ "Auml", 196 },
+	{ "Beta", 914 },
+	{ "Ccedil", 199 },
+	{ "Chi", 935 },
+	{ "Dagger", 8225 },
+	{ "Delta", 916 },
+	{ "ETH", 208 },
+	{ "Eacute", 201 },
+	{ "Ecirc", 202 },
+	{ "Egrave", 200 },
+	{ "Epsilon", 917 },
+	{ "Eta", 919 },
+	{ "Euml", 203 },
+	{ "Gamma", 915 },
+	{ "Iacute", 205 },
+	{ "Icirc", 206 },
+	{ "Igrave", 204 },
+	{ "Iota", 921 },
+	{ "Iuml", 207 },
+	{ "Kappa", 922 },
+	{ "Lambda", 923 },
+	{ "Mu", 924 },
+	{ "Ntilde", 209 },
+	{ "Nu", 925 },
+	{ "OElig", 338 },
+	{ "Oacute", 211 },
+	{ "Ocirc", 212 },
+	{ "Ograve", 210 },
+	{ "Omega", 937 },
+	{ "Omicron", 927 },
+	{ "Oslash", 216 },
+	{ "Otilde", 213 },
+	{ "Ouml", 214 },
+	{ "Phi", 934 },
+	{ "Pi", 928 },
+	{ "Prime", 8243 },
+	{ "Psi", 936 },
+	{ "Rho", 929 },
+	{ "Scaron", 352 },
+	{ "Sigma", 931 },
+	{ "THORN", 222 },
+	{ "Tau", 932 },
+	{ "Theta", 920 },
+	{ "Uacute", 218 },
+	{ "Ucirc", 219 },
+	{ "Ugrave", 217 },
+	{ "Upsilon", 933 },
+	{ "Uuml", 220 },
+	{ "Xi", 926 },
+	{ "Yacute", 221 },
+	{ "Yuml", 376 },
+	{ "Zeta", 918 },
+	{ "aacute", 225 },
+	{ "acirc", 226 },
+	{ "acute", 180 },
+	{ "aelig", 230 },
+	{ "agrave", 224 },
+	{ "alefsym", 8501 },
+	{ "alpha", 945 },
+	{ "amp", 38 },
+	{ "and", 8743 },
+	{ "ang", 8736 },
+	{ "apos", 39 },
+	{ "aring", 229 },
+	{ "asymp", 8776 },
+	{ "atilde", 227 },
+	{ "auml", 228 },
+	{ "bdquo", 8222 },
+	{ "beta", 946 },
+	{ "brvbar", 166 },
+	{ "bull", 8226 },
+	{ "cap", 8745 },
+	{ "ccedil", 231 },
+	{ "cedil", 184 },
+	{ "cent", 162 },
+	{ "chi", 967 },
+	{ "circ", 710 },
+	{ "clubs", 9827 },
+	{ "cong", 8773 },
+	{ "copy", 169 },
+	{ "crarr", 8629 },
+	{ "cup", 8746 },
+	{ "curren", 164 },
+	{ "dArr", 8659 },
+	{ "dagger", 8224 },
+	{ "darr", 8595 },
+	{ "deg", 176 },
+	{ "delta", 948 },
+	{ "diams", 9830 },
+	{ "divide", 247 },
+	{ "eacute", 233 },
+	{ "ecirc", 234 },
+	{ "egrave", 232 },
+	{ "empty", 8709 },
+	{ "emsp", 8195 },
+	{ "ensp", 8194 },
+	{ "epsilon", 949 },
+	{ "equiv", 8801 },
+	{ "eta", 951 },
+	{ "eth", 240 },
+	{ "euml", 235 },
+	{ "euro", 8364 },
+	{ "exist", 8707 },
+	{ "fnof", 402 },
+	{ "forall", 8704 },
+	{ "frac12", 189 },
+	{ "frac14", 188 },
+	{ "frac34", 190 },
+	{ "frasl", 8260 },
+	{ "gamma", 947 },
+	{ "ge", 8805 },
+	{ "gt", 62 },
+	{ "hArr", 8660 },
+	{ "harr", 8596 },
+	{ "hearts", 9829 },
+	{ "hellip", 8230 },
+	{ "iacute", 237 },
+	{ "icirc", 238 },
+	{ "iexcl", 161 },
+	{ "igrave", 236 },
+	{ "image", 8465 },
+	{ "infin", 8734 },
+	{ "int", 8747 },
+	{ "iota", 953 },
+	{ "iquest", 191 },
+	{ "isin", 8712 },
+	{ "iuml", 239 },
+	{ "kappa", 954 },
+	{ "lArr", 8656 },
+	{ "lambda", 955 },
+	{ "lang", 9001 },
+	{ "laquo", 171 },
+	{ "larr", 8592 },
+	{ "lceil", 8968 },
+	{ "ldquo", 8220 },
+	{ "le", 8804 },
+	{ "lfloor", 8970 },
+	{ "lowast", 8727 },
+	{ "loz", 9674 },
+	{ "lrm", 8206 },
+	{ "lsaquo", 8249 },
+	{ "lsquo", 8216 },
+	{ "lt", 60 },
+	{ "macr", 175 },
+	{ "mdash", 8212 },
+	{ "micro", 181 },
+	{ "middot", 183 },
+	{ "minus", 8722 },
+	{ "mu", 956 },
+	{ "nabla", 8711 },
+	{ "nbsp", 160 },
+	{ "ndash", 8211 },
+	{ "ne", 8800 },
+	{ "ni", 8715 },
+	{ "not", 172 },
+	{ "notin", 8713 },
+	{ "nsub", 8836 },
+	{ "ntilde", 241 },
+	{ "nu", 957 },
+	{ "oacute", 243 },
+	{ "ocirc", 244 },
+	{ "oelig", 339 },
+	{ "ograve", 242 },
+	{ "oline", 8254 },
+	{ "omega", 969 },
+	{ "omicron", 959 },
+	{ "oplus", 8853 },
+	{ "or", 8744 },
+	{ "ordf", 170 },
+	{ "ordm", 186 },
+	{ "oslash", 248 },
+	{ "otilde", 245 },
+	{ "otimes", 8855 },
+	{ "ouml", 246 },
+	{ "para", 182 },
+	{ "part", 8706 },
+	{ "permil", 8240 },
+	{ "perp", 8869 },
+	{ "phi", 966 },
+	{ "pi", 960 },
+	{ "piv", 982 },
+	{ "plusmn", 177 },
+	{ "pound", 163 },
+	{ "prime", 8242 },
+	{ "prod", 8719 },
+	{ "prop", 8733 },
+	{ "psi", 968 },
+	{ "quot", 34 },
+	{ "rArr", 8658 },
+	{ "radic", 8730 },
+	{ "rang", 9002 },
+	{ "raquo", 187 },
+	{ "rarr", 8594 },
+	{ "rceil", 8969 },
+	{ "rdquo", 8221 },
+	{ "real", 8476 },
+	{ "reg", 174 },
+	{ "rfloor", 8971 },
+	{ "rho", 961 },
+	{ "rlm", 8207 },
+	{ "rsaquo", 8250 },
+	{ "rsquo", 8217 },
+	{ "sbquo", 8218 },
+	{ "scaron", 353 },
+	{ "sdot", 8901 },
+	{ "sect", 167 },
+	{ "shy", 173 },
+	{ "sigma", 963 },
+	{ "sigmaf", 962 },
+	{ "sim", 8764 },
+	{ "spades", 9824 },
+	{ "sub", 8834 },
+	{ "sube", 8838 },
+	{ "sum", 8721 },
+	{ "sup", 8835 },
+	{ "sup1", 185 },
+	{ "sup2", 178 },
+	{ "sup3", 179 },
+	{ "supe", 8839 },
+	{ "szlig", 223 },
+	{ "tau", 964 },
+	{ "there4", 8756 },
+	{ "theta", 952 },
+	{ "thetasym", 977 },
+	{ "thinsp", 8201 },
+	{ "thorn", 254 },
+	{ "tilde", 732 },
+	{ "times", 215 },
+	{ "trade", 8482 },
+	{ "uArr", 8657 },
+	{ "uacute", 250 },
+	{ "uarr", 8593 },
+	{ "ucirc", 251 },
+	{ "ugrave", 249 },
+	{ "uml", 168 },
+	{ "upsih", 978 },
+	{ "upsilon", 965 },
+	{ "uuml", 252 },
+	{ "weierp", 8472 },
+	{ "xi", 958 },
+	{ "yacute", 253 },
+	{ "yen", 165 },
+	{ "yuml", 255 },
+	{ "zeta", 950 },
+	{ "zwj", 8205 },
+	{ "zwnj", 8204 }
 };
 
+static int HTMLEscapeMapCompare(const void *key, const void *element)
+{
+	return strcmp((const char *)key, ((const HTMLEscapeMap *)element)->name);
+}
+
+
+/// Decodes a single `&...;` sequence spanning `[start, end]` (both inclusive) in `buffer`.
+/// Returns the number of UTF-16 code units written to `output` (0, 1 or 2), where 0 means
+/// the sequence isn't a known entity and must be left untouched.
+static NSUInteger HTMLDecodeEscapeSequence(const unichar *buffer, NSUInteger start, NSUInteger end, unichar output[2])
+{
+	NSUInteger cursor = start + 1;
+
+	if (buffer[cursor] == '#') {
+		cursor++;
+		BOOL isHex = (buffer[cursor] == 'x' || buffer[cursor] == 'X');
+		if (isHex) {
+			cursor++;
+		}
+		if (cursor == end) {
+			return 0;
+		}
+
+		// A sequence is at most 10 characters long, so the value can't overflow.
+		uint32_t value = 0;
+		for (; cursor < end; cursor++) {
+			unichar c = buffer[cursor];
+			if (c >= '0' && c <= '9') {
+				value = value * (isHex ? 16 : 10) + (c - '0');
+			} else if (isHex && c >= 'a' && c <= 'f') {
+				value = value * 16 + (c - 'a' + 10);
+			} else if (isHex && c >= 'A' && c <= 'F') {
+				value = value * 16 + (c - 'A' + 10);
+			} else {
+				return 0;
+			}
+		}
+
+		if (value == 0 || value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF)) {
+			return 0;
+		}
+		if (value > 0xFFFF) {
+			value -= 0x10000;
+			output[0] = (unichar)(0xD800 + (value >> 10));
+			output[1] = (unichar)(0xDC00 + (value & 0x3FF));
+			return 2;
+		}
+		output[0] = (unichar)value;
+		return 1;
+	}
+
+	NSUInteger nameLength = end - cursor;
+	if (nameLength > kHTMLEscapeMaxNameLength) {
+		return 0;
+	}
+	char name[kHTMLEscapeMaxNameLength + 1];
+	for (NSUInteger i = 0; i < nameLength; i++) {
+		unichar c = buffer[cursor + i];
+		if (c == 0 || c > 127) {
+			return 0;
+		}
+		name[i] = (char)c;
+	}
+	name[nameLength] = '\0';
+
+	const HTMLEscapeMap *match = bsearch(name,
+										 gAsciiHTMLEscapeMap,
+										 sizeof(gAsciiHTMLEscapeMap) / sizeof(HTMLEscapeMap),
+										 sizeof(HTMLEscapeMap),
+										 HTMLEscapeMapCompare);
+	if (match == NULL) {
+		return 0;
+	}
+	output[0] = match->uchar;
+	return 1;
+}
+
 
 @implementation NSString (XMLExtensions)
 
@@ -321,73 +375,66 @@ static HTMLEscapeMap gAsciiHTMLEscapeMap[] = {
 + (NSString *) decodeXMLCharactersIn:(NSString *)original {
 	if (![original isKindOfClass:[NSString class]] || !original)
         return @"";
-	
-    NSString *source = [NSString stringWithString:original];
-	
-	NSRange range = NSMakeRange(0, [source length]);
-	NSRange subrange = [source rangeOfString:@"&" options:NSBackwardsSearch range:range];
-	
+
 	// if no ampersands, we've got a quick way out
-	if (subrange.length == 0) return source;
-	NSMutableString *finalString = [NSMutableString stringWithString:source];
-	do {
-		NSRange semiColonRange = NSMakeRange(subrange.location, NSMaxRange(range) - subrange.location);
-		semiColonRange = [source rangeOfString:@";" options:0 range:semiColonRange];
-		range = NSMakeRange(0, subrange.location);
-		// if we don't find a semicolon in the range, we don't have a sequence
-		if (semiColonRange.location == NSNotFound) {
+	if ([original rangeOfString:@"&"].location == NSNotFound) {
+		return [NSString stringWithString:original];
+	}
+
+	// Every sequence is at least as long as its decoded form (4 characters for `&lt;`,
+	// at most 2 UTF-16 code units for `&#x1F600;`), so the result is written back into
+	// the same buffer in a single forward pass.
+	NSUInteger length = [original length];
+	unichar *buffer = malloc(length * sizeof(unichar));
+	if (buffer == NULL) {
+		return [NSString stringWithString:original];
+	}
+	[original getCharacters:buffer range:NSMakeRange(0, length)];
+
+	NSUInteger readIndex = 0;
+	NSUInteger writeIndex = 0;
+	while (readIndex < length) {
+		unichar c = buffer[readIndex];
+		if (c != '&') {
+			buffer[writeIndex++] = c;
+			readIndex++;
 			continue;
 		}
-		NSRange escapeRange = NSMakeRange(subrange.location, semiColonRange.location - subrange.location + 1);
-		NSString *escapeString = [source substringWithRange:escapeRange];
-		NSUInteger length = [escapeString length];
-		// a squence must be longer than 3 (&lt;) and less than 11 (&thetasym;)
-		if (length > 3 && length < 11) {
-			if ([escapeString characterAtIndex:1] == '#') {
-				unichar char2 = [escapeString characterAtIndex:2];
-				if (char2 == 'x' || char2 == 'X') {
-					// Hex escape squences &#xa3;
-					NSString *hexSequence = [escapeString substringWithRange:NSMakeRange(3, length - 4)];
-					NSScanner *scanner = [NSScanner scannerWithString:hexSequence];
-					unsigned value;
-					if ([scanner scanHexInt:&value] && 
-						value < USHRT_MAX &&
-						value > 0 
-						&& [scanner scanLocation] == length - 4) {
-						unichar uchar = value;
-						NSString *charString = [NSString stringWithCharacters:&uchar length:1];
-						[finalString replaceCharactersInRange:escapeRange withString:charString];
-					}
-					
-				} else {
-					// Decimal Sequences &#123;
-					NSString *numberSequence = [escapeString substringWithRange:NSMakeRange(2, length - 3)];
-					NSScanner *scanner = [NSScanner scannerWithString:numberSequence];
-					int value;
-					if ([scanner scanInt:&value] && 
-						value < USHRT_MAX &&
-						value > 0 
-						&& [scanner scanLocation] == length - 3) {
-						unichar uchar = value;
-						NSString *charString = [NSString stringWithCharacters:&uchar length:1];
-						[finalString replaceCharactersInRange:escapeRange withString:charString];
-					}
-				}
-			} else {
-				// "standard" sequences
-				for (unsigned i = 0; i < sizeof(gAsciiHTMLEscapeMap) / sizeof(HTMLEscapeMap); ++i) {
-					if ([escapeString isEqualToString:gAsciiHTMLEscapeMap[i].escapeSequence]) {
-						[finalString replaceCharactersInRange:escapeRange withString:[NSString stringWithCharacters:&gAsciiHTMLEscapeMap[i].uchar length:1]];
-						break;
-					}
-				}
+
+		// A sequence is terminated by the first `;` before the next `&`, and must be
+		// longer than 3 (&lt;) and less than 11 (&thetasym;) characters.
+		NSUInteger semicolonIndex = NSNotFound;
+		NSUInteger limit = MIN(length, readIndex + 10);
+		for (NSUInteger i = readIndex + 1; i < limit; i++) {
+			if (buffer[i] == ';') {
+				semicolonIndex = i;
+				break;
+			}
+			if (buffer[i] == '&') {
+				break;
 			}
 		}
-	
-	} while ((subrange = [source rangeOfString:@"&" options:NSBackwardsSearch range:range]).length != 0);
 
-	return finalString;
-} 
+		unichar decoded[2];
+		NSUInteger decodedLength = 0;
+		if (semicolonIndex != NSNotFound && semicolonIndex - readIndex >= 3) {
+			decodedLength = HTMLDecodeEscapeSequence(buffer, readIndex, semicolonIndex, decoded);
+		}
+
+		if (decodedLength == 0) {
+			buffer[writeIndex++] = c;
+			readIndex++;
+			continue;
+		}
+
+		for (NSUInteger i = 0; i < decodedLength; i++) {
+			buffer[writeIndex++] = decoded[i];
+		}
+		readIndex = semicolonIndex + 1;
+	}
+
+	return [[NSString alloc] initWithCharactersNoCopy:buffer length:writeIndex freeWhenDone:YES];
+}
 
 - (NSString *)stringByDecodingXMLCharacters {
     return [NSString decodeXMLCharactersIn:self];
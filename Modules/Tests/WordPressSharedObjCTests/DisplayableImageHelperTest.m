@@ -90,6 +90,15 @@ static NSString * const PathForAttachmentD = @"http://www.example.com/exampleD.p
     XCTAssertTrue([idsSet containsObject:@(900)], "It should find 900");
 }
 
+- (void)testSearchPostContentForAttachmentIdsInGalleriesUsesTheLastIds
+{
+    NSSet *idsSet = [DisplayableImageHelper searchPostContentForAttachmentIdsInGalleries:@"[gallery ids=\"1,2\" link=\"file\" ids=\"3,4\"]"];
+    XCTAssertEqualObjects(idsSet, ([NSSet setWithObjects:@(3), @(4), nil]));
+
+    idsSet = [DisplayableImageHelper searchPostContentForAttachmentIdsInGalleries:@"[gallery ids=\"1,2\" ids=\"a,b\"]"];
+    XCTAssertEqualObjects(idsSet, ([NSSet setWithObjects:@(1), @(2), nil]), @"It should skip the ids that aren't numbers");
+}
+
 - (void)testSearchPostContentForImageToDisplay
 {
     NSString *imageSrc= [DisplayableImageHelper searchPostContentForImageToDisplay:@"Img100<img width=\"100\" src=\"http://photo.com/100.jpg\" /> Img200 <img width=\"200\" src=\"http://photo.com/200.jpg\" /> Img300<img width=\"300\" src=\"http://photo.com/300.jpg\" /> "];
@@ -105,4 +114,40 @@ static NSString * const PathForAttachmentD = @"http://www.example.com/exampleD.p
     XCTAssertTrue(imageSrc.length == 0, @"It shouldn't find an image since the width is too small");
 }
 
+- (void)testSearchPostContentForImageToDisplayReadsWidthFromQueryAndSrcset
+{
+    NSString *imageSrc = [DisplayableImageHelper searchPostContentForImageToDisplay:@"<img src=\"http://photo.com/a.jpg?h=100&amp;w=640\" />"];
+    XCTAssertEqualObjects(imageSrc, @"http://photo.com/a.jpg?h=100&amp;w=640");
+
+    imageSrc = [DisplayableImageHelper searchPostContentForImageToDisplay:@"<img srcset=\"http://photo.com/b-100.jpg 100w, http://photo.com/b.jpg 1024w\" src=\"http://photo.com/b-100.jpg\" />"];
+    XCTAssertEqualObjects(imageSrc, @"http://photo.com/b-100.jpg");
+}
+
+- (void)testSearchPostContentForImageToDisplaySkipsEmojiAndSVG
+{
+    NSString *imageSrc = [DisplayableImageHelper searchPostContentForImageToDisplay:@"<img width=\"300\" src=\"https://s.w.org/images/core/emoji/72x72/1f600.png\" /><img width=\"300\" src=\"http://photo.com/logo.svg\" /><img data-src=\"http://photo.com/lazy.jpg\" width=\"300\" src=\"http://photo.com/300.jpg\" />"];
+    XCTAssertEqualObjects(imageSrc, @"http://photo.com/300.jpg");
+}
+
+- (void)testSearchPostContentForImageToDisplayFallsBackToSizeClass
+{
+    NSString *imageSrc = [DisplayableImageHelper searchPostContentForImageToDisplay:@"<img class=\"size-medium\" src=\"http://photo.com/medium.jpg\" /><img class=\"wp-image-1 size-large\" src=\"http://photo.com/large.jpg?resize=100\" />"];
+    XCTAssertEqualObjects(imageSrc, @"http://photo.com/large.jpg");
+}
+
+- (void)testSearchPostContentForImageToDisplayFallsBackToFigureSizeClass
+{
+    NSString *imageSrc = [DisplayableImageHelper searchPostContentForImageToDisplay:@"<img class=\"size-medium\" src=\"http://photo.com/medium.jpg\" /><figure class=\"wp-block-image size-large\"><img src=\"http://photo.com/large.jpg?w=100\" alt=\"\" /></figure><img src=\"http://photo.com/other.jpg\" />"];
+    XCTAssertEqualObjects(imageSrc, @"http://photo.com/large.jpg");
+}
+
+- (void)testSearchPostContentForImageToDisplayWithTruncatedSrcset
+{
+    NSString *imageSrc = [DisplayableImageHelper searchPostContentForImageToDisplay:@"<img src=\"http://photo.com/a.jpg\" srcset=\"http://photo.com/a.jpg 1024"];
+    XCTAssertEqualObjects(imageSrc, @"");
+
+    imageSrc = [DisplayableImageHelper searchPostContentForImageToDisplay:@"<img src=\"http://photo.com/a.jpg\" srcset=\"http://photo.com/a.jpg 1024w"];
+    XCTAssertEqualObjects(imageSrc, @"http://photo.com/a.jpg");
+}
+
 @end
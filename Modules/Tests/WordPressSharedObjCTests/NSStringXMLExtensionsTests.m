@@ -0,0 +1,77 @@
+#import <XCTest/XCTest.h>
+#import "NSString+XMLExtensions.h"
+
+@interface NSStringXMLExtensionsTests : XCTestCase
+
+@end
+
+@implementation NSStringXMLExtensionsTests
+
+- (void)testDecodingWithoutEntitiesReturnsTheSameString
+{
+    NSString *source = @"The quick brown fox jumps over the lazy dog.";
+    XCTAssertEqualObjects([source stringByDecodingXMLCharacters], source);
+    XCTAssertEqualObjects([NSString decodeXMLCharactersIn:(NSString *)[NSNull null]], @"");
+}
+
+- (void)testDecodingNamedEntities
+{
+    XCTAssertEqualObjects([@"Fish &amp; Chips" stringByDecodingXMLCharacters], @"Fish & Chips");
+    XCTAssertEqualObjects([@"&lt;p&gt;&quot;Hi&quot;&lt;/p&gt;" stringByDecodingXMLCharacters], @"<p>\"Hi\"</p>");
+    XCTAssertEqualObjects([@"&AElig;&aelig;&thetasym;&frac14;" stringByDecodingXMLCharacters], @"Ææϑ¼");
+    XCTAssertEqualObjects([@"&bogus; &AMP;" stringByDecodingXMLCharacters], @"&bogus; &AMP;");
+}
+
+- (void)testDecodingNumericEntities
+{
+    XCTAssertEqualObjects([@"&#65;&#x42;&#X43;" stringByDecodingXMLCharacters], @"ABC");
+    XCTAssertEqualObjects([@"It&#8217;s" stringByDecodingXMLCharacters], @"It’s");
+    XCTAssertEqualObjects([@"&#0; &#; &#x; &#xZZ; &#xD800;" stringByDecodingXMLCharacters], @"&#0; &#; &#x; &#xZZ; &#xD800;");
+}
+
+- (void)testDecodingAstralCodePointsEmitsSurrogatePairs
+{
+    XCTAssertEqualObjects([@"&#x1F600; &#128512;" stringByDecodingXMLCharacters], @"😀 😀");
+    XCTAssertEqualObjects([@"&#x110000;" stringByDecodingXMLCharacters], @"&#x110000;");
+}
+
+- (void)testDecodingDoesNotDecodeTwice
+{
+    XCTAssertEqualObjects([@"&amp;lt;" stringByDecodingXMLCharacters], @"&lt;");
+    XCTAssertEqualObjects([@"&amp;amp;" stringByDecodingXMLCharacters], @"&amp;");
+}
+
+- (void)testDecodingIgnoresUnterminatedSequences
+{
+    XCTAssertEqualObjects([@"&lt & &gt;" stringByDecodingXMLCharacters], @"&lt & >");
+    XCTAssertEqualObjects([@"x&&lt;;" stringByDecodingXMLCharacters], @"x&<;");
+    XCTAssertEqualObjects([@"&; &lt" stringByDecodingXMLCharacters], @"&; &lt");
+    XCTAssertEqualObjects([@"&averyveryverylongname;" stringByDecodingXMLCharacters], @"&averyveryverylongname;");
+}
+
+- (void)testDecodingRejectsNamesWithEmbeddedNulls
+{
+    unichar characters[] = {'&', 'l', 't', 0, ';'};
+    NSString *string = [NSString stringWithCharacters:characters length:sizeof(characters) / sizeof(unichar)];
+    XCTAssertEqualObjects([string stringByDecodingXMLCharacters], string);
+}
+
+- (void)testDecodingPerformance
+{
+    NSURL *url = [SWIFTPM_MODULE_BUNDLE URLForResource:@"reader-post-bodies" withExtension:@"html"];
+    NSString *bodies = [NSString stringWithContentsOfURL:url encoding:NSUTF8StringEncoding error:nil];
+    XCTAssertNotNil(bodies);
+
+    NSMutableArray<NSString *> *corpus = [NSMutableArray arrayWithCapacity:200];
+    for (int i = 0; i < 200; i++) {
+        [corpus addObject:[bodies stringByAppendingFormat:@" %d", i]];
+    }
+
+    [self measureBlock:^{
+        for (NSString *body in corpus) {
+            [body stringByDecodingXMLCharacters];
+        }
+    }];
+}
+
+@end
@@ -69,4 +69,56 @@ class RichContentFormatterTests: XCTestCase {
         let sanitizedStr3 = RichContentFormatter.formatVideoTags(str3) as NSString
         XCTAssert(!sanitizedStr3.contains("controls controls"))
     }
+
+    func testFormatContentRewritesMatchChainedRegexPasses() throws {
+        let galleryItem = "<li class=\"blocks-gallery-item\"><figure><img src=\"https://example.com/wp-content/uploads/2017/05/IMG_1364.jpg\" alt=\"\" class=\"wp-image-103\" /></figure></li>"
+        let samples = try loadCorpus() + [
+            "<div><p>test</p></div><pre>\n\ntest\n\n</pre>\n<p><div>test</div></p>\n",
+            "<script>alert();</script><style>body{color:#000;}</style><p><!-- wp:paragraph {\"fontSize\":\"large\"}--></p><p><!-- /wp:paragraph --></p>\n<img>",
+            "<p><!-- wp:image /--></p><script>x</script>\n<p style=\"color: red\">text</p>\n\n<p class=\"a\">\n<p>b</p>\n</p></div>",
+            "<VIDEO autoplay style=\"width: 100%\"></video><video controls></video><pre class=\"code\">\n<div>\n</div>\n</pre>",
+            "<p>Hi <img src=\"https://s.w.org/images/smilies/icon_smile.gif\" alt=\":)\" class=\"wp-smiley\" /></p>\n<video src=\"movie.mp4\"></video>",
+            "<p>Gallery</p>\n<ul class=\"wp-block-gallery columns-2\">\(galleryItem)\(galleryItem)</ul>\n<div><video></video></div>",
+            "<div class=\"gallery\"><img src=\"https://example.files.wordpress.com/a.jpg?w=150\" data-orig-file=\"https://example.files.wordpress.com/a.jpg\" data-orig-size=\"1024,768\" /></div>",
+        ]
+
+        for sample in samples {
+            let scanned = RichContentScanner.rewrite(sample, applying: [.forbiddenTags, .paragraphs, .inlineStyles])
+            let chainedRewrites = RichContentFormatter.removeInlineStyles(
+                RichContentFormatter.normalizeParagraphs(
+                    RichContentFormatter.removeForbiddenTags(sample)
+                )
+            )
+            XCTAssertEqual(scanned, chainedRewrites)
+
+            for isPrivateSite in [false, true] {
+                var chained = chainedRewrites
+                chained = (chained as NSString).replacingHTMLEmoticonsWithEmoji() as String
+                chained = RichContentFormatter.formatGutenbergGallery(chained)
+                chained = RichContentFormatter.resizeGalleryImageURL(chained, isPrivateSite: isPrivateSite)
+                chained = RichContentFormatter.formatVideoTags(chained)
+                XCTAssertEqual(RichContentFormatter.formatContentString(sample, isPrivateSite: isPrivateSite), chained)
+            }
+
+            let sanitized = RichContentFormatter.removeInlineStyles(RichContentFormatter.removeForbiddenTags(sample))
+            XCTAssertEqual(RichContentFormatter.removeForbiddenTagsAndInlineStyles(sample), sanitized)
+        }
+    }
+
+    func testFormatContentStringPerformance() throws {
+        let corpus = try loadCorpus()
+
+        measure {
+            for content in corpus {
+                _ = RichContentFormatter.formatContentString(content, isPrivateSite: false)
+            }
+        }
+    }
+
+    /// Post bodies collected from the API fixtures.
+    ///
+    private func loadCorpus() throws -> [String] {
+        let url = try XCTUnwrap(Bundle.module.url(forResource: "rich-content-corpus", withExtension: "json"))
+        return try JSONDecoder().decode([String].self, from: Data(contentsOf: url))
+    }
 }
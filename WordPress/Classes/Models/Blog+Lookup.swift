@@ -101,6 +101,28 @@ public extension Blog {
         return blogToReturn
     }
 
+    /// Lookup a Blog of an account by its WordPress.com ID
+    ///
+    /// - Parameters:
+    ///   - dotComID: The WordPress.com ID of the blog.
+    ///   - account: The account the blog belongs to.
+    /// - Returns: The `Blog` object associated with the given `dotComID`, if it exists.
+    @objc(lookupWithDotComID:inAccount:)
+    static func lookup(dotComID: NSNumber, in account: WPAccount) -> Blog? {
+        guard let context = account.managedObjectContext else {
+            return nil
+        }
+
+        let predicate = NSPredicate(format: "account == %@ AND blogID == %@", account, dotComID)
+        if let blog = context.lookup(Blog.self, key: [account.objectID, dotComID] as [AnyHashable], matching: predicate) {
+            return blog
+        }
+
+        // The `dotComID` of a Jetpack blog falls back to its site ID until its `blogID` is set.
+        let blogsWithoutID = NSPredicate(format: "account == %@ AND (blogID == nil OR blogID == 0)", account)
+        return context.allObjects(ofType: Blog.self, matching: blogsWithoutID).first { $0.dotComID == dotComID }
+    }
+
     @objc(countInContext:)
     static func count(in context: NSManagedObjectContext) -> Int {
         BlogQuery().count(in: context)
@@ -148,7 +170,7 @@ public extension Blog {
     /// - Parameter id: The comment id
     /// - Returns: The `Comment` object associated with the given id, or `nil` if none is found.
     func comment(withID id: Int32) -> Comment? {
-        (comments as? Set<Comment>)?.first { $0.commentID == id }
+        managedObjectContext?.lookup(Comment.self, key: [objectID, id] as [AnyHashable], matching: NSPredicate(format: "blog == %@ AND commentID == %d", self, id))
     }
 
 }
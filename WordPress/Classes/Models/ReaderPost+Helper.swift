@@ -16,7 +16,7 @@ extension ReaderPost {
     /// - Parameter id: The comment id
     /// - Returns: The `Comment` object associated with the given id, or `nil` if none is found.
     func comment(withID id: Int32) -> Comment? {
-        return (comments as? Set<Comment>)?.first { $0.commentID == id }
+        managedObjectContext?.lookup(Comment.self, key: [objectID, id] as [AnyHashable], matching: NSPredicate(format: "post == %@ AND commentID == %d", self, id))
     }
 
     /// Get a cached site's ReaderPost with the specified ID.
@@ -25,10 +25,8 @@ extension ReaderPost {
     /// - Parameter siteID: ID of the site the post belongs to.
     /// - Returns: the matching `ReaderPost`, or `nil` if none is found.
     static func lookup(withID postID: NSNumber, forSiteWithID siteID: NSNumber, in context: NSManagedObjectContext) throws -> ReaderPost? {
-        let request = NSFetchRequest<ReaderPost>(entityName: ReaderPost.classNameWithoutNamespaces())
-        request.predicate = NSPredicate(format: "postID = %@ AND siteID = %@", postID, siteID)
-        request.fetchLimit = 1
-        return try context.fetch(request).first
+        let predicate = NSPredicate(format: "postID = %@ AND siteID = %@", postID, siteID)
+        return context.lookup(ReaderPost.self, key: [postID, siteID] as [AnyHashable], matching: predicate)
     }
 
     /// Get a cached site's ReaderPost with the specified ID.
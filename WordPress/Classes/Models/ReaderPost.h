@@ -77,6 +77,10 @@ extern NSString * const ReaderPostStoredCommentTextKey;
 
 + (instancetype)createOrReplaceFromRemotePost:(RemoteReaderPost *)remotePost forTopic:(ReaderAbstractTopic *)topic context:(NSManagedObjectContext *) managedObjectContext;
 
+// Upserts a whole page of remote posts with a single fetch. Returns the posts
+// in the same order as `remotePosts`.
++ (NSArray<ReaderPost *> *)createOrReplaceFromRemotePosts:(NSArray<RemoteReaderPost *> *)remotePosts forTopic:(ReaderAbstractTopic *)topic context:(NSManagedObjectContext *)managedObjectContext;
+
 - (BOOL)isCrossPost;
 - (BOOL)isPrivate;
 - (BOOL)isP2Type;
@@ -74,21 +74,129 @@ static NSString * const SourceAttributionStandardTaxonomy = @"standard-pick";
 + (instancetype)createOrReplaceFromRemotePost:(RemoteReaderPost *)remotePost
                                      forTopic:(ReaderAbstractTopic *)topic
                                       context:(NSManagedObjectContext *) managedObjectContext
+{
+    NSString *content = [RichContentFormatter removeForbiddenTagsAndInlineStyles:remotePost.content];
+    return [self createOrReplaceFromRemotePost:remotePost
+                              sanitizedContent:content
+                                      forTopic:topic
+                                       context:managedObjectContext];
+}
+
++ (ReaderPost *)createOrReplaceFromRemotePost:(RemoteReaderPost *)remotePost
+                             sanitizedContent:(NSString *)content
+                                     forTopic:(ReaderAbstractTopic *)topic
+                                      context:(NSManagedObjectContext *)managedObjectContext
 {
     NSError *error;
-    ReaderPost *post;
     NSString *globalID = remotePost.globalID;
     NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] initWithEntityName:@"ReaderPost"];
     fetchRequest.predicate = [NSPredicate predicateWithFormat:@"globalID = %@ AND (topic = %@ OR topic = NULL)", globalID, topic];
     NSArray *arr = [managedObjectContext executeFetchRequest:fetchRequest error:&error];
 
-    BOOL existing = false;
     if (error) {
         DDLogError(@"Error fetching an existing reader post. - %@", error);
-    } else if ([arr count] > 0) {
-        post = (ReaderPost *)[arr objectAtIndex:0];
-        existing = YES;
-    } else {
+        return nil;
+    }
+
+    return [self updateOrInsertPost:[arr firstObject]
+                     fromRemotePost:remotePost
+                   sanitizedContent:content
+                           forTopic:topic
+                            context:managedObjectContext];
+}
+
++ (NSArray<ReaderPost *> *)createOrReplaceFromRemotePosts:(NSArray<RemoteReaderPost *> *)remotePosts
+                                                 forTopic:(ReaderAbstractTopic *)topic
+                                                  context:(NSManagedObjectContext *)managedObjectContext
+{
+    if ([remotePosts count] == 0) {
+        return @[];
+    }
+
+    // Sanitizing the content is the expensive part of an upsert and doesn't
+    // touch Core Data, so it's done up front across all cores.
+    NSArray<NSString *> *contents = [self sanitizedContentForRemotePosts:remotePosts];
+
+    NSMutableSet<NSString *> *globalIDs = [NSMutableSet setWithCapacity:[remotePosts count]];
+    for (RemoteReaderPost *remotePost in remotePosts) {
+        if (remotePost.globalID) {
+            [globalIDs addObject:remotePost.globalID];
+        }
+    }
+
+    NSError *error;
+    NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] initWithEntityName:@"ReaderPost"];
+    fetchRequest.predicate = [NSPredicate predicateWithFormat:@"globalID IN %@ AND (topic = %@ OR topic = NULL)", globalIDs, topic];
+    fetchRequest.returnsObjectsAsFaults = NO;
+    NSArray<ReaderPost *> *arr = [managedObjectContext executeFetchRequest:fetchRequest error:&error];
+    if (error) {
+        // Don't drop the whole page over one failed fetch; merge the posts one at a time instead.
+        DDLogError(@"Error fetching existing reader posts, falling back to per-post merges. - %@", error);
+        NSMutableArray<ReaderPost *> *posts = [NSMutableArray arrayWithCapacity:[remotePosts count]];
+        [remotePosts enumerateObjectsUsingBlock:^(RemoteReaderPost *remotePost, NSUInteger idx, BOOL *stop) {
+            ReaderPost *post = [self createOrReplaceFromRemotePost:remotePost
+                                                  sanitizedContent:contents[idx]
+                                                          forTopic:topic
+                                                           context:managedObjectContext];
+            if (post) {
+                [posts addObject:post];
+            }
+        }];
+        return posts;
+    }
+
+    NSMutableDictionary<NSString *, ReaderPost *> *postsByGlobalID = [NSMutableDictionary dictionaryWithCapacity:[remotePosts count]];
+    for (ReaderPost *post in arr) {
+        if (!postsByGlobalID[post.globalID]) {
+            postsByGlobalID[post.globalID] = post;
+        }
+    }
+
+    NSMutableArray<ReaderPost *> *posts = [NSMutableArray arrayWithCapacity:[remotePosts count]];
+    [remotePosts enumerateObjectsUsingBlock:^(RemoteReaderPost *remotePost, NSUInteger idx, BOOL *stop) {
+        ReaderPost *existingPost = remotePost.globalID ? postsByGlobalID[remotePost.globalID] : nil;
+        ReaderPost *post = [self updateOrInsertPost:existingPost
+                                     fromRemotePost:remotePost
+                                   sanitizedContent:contents[idx]
+                                           forTopic:topic
+                                            context:managedObjectContext];
+        // A page can list the same post twice; the second copy updates the first.
+        if (remotePost.globalID) {
+            postsByGlobalID[remotePost.globalID] = post;
+        }
+        [posts addObject:post];
+    }];
+
+    return posts;
+}
+
++ (NSArray<NSString *> *)sanitizedContentForRemotePosts:(NSArray<RemoteReaderPost *> *)remotePosts
+{
+    NSUInteger count = [remotePosts count];
+    NSString * __strong *contents = (NSString * __strong *)calloc(count, sizeof(NSString *));
+
+    dispatch_apply(count, DISPATCH_APPLY_AUTO, ^(size_t idx) {
+        contents[idx] = [RichContentFormatter removeForbiddenTagsAndInlineStyles:remotePosts[idx].content];
+    });
+
+    NSArray<NSString *> *result = [NSArray arrayWithObjects:contents count:count];
+    for (NSUInteger idx = 0; idx < count; idx++) {
+        contents[idx] = nil;
+    }
+    free(contents);
+
+    return result;
+}
+
++ (ReaderPost *)updateOrInsertPost:(ReaderPost *)existingPost
+                    fromRemotePost:(RemoteReaderPost *)remotePost
+                  sanitizedContent:(NSString *)content
+                          forTopic:(ReaderAbstractTopic *)topic
+                           context:(NSManagedObjectContext *)managedObjectContext
+{
+    ReaderPost *post = existingPost;
+    BOOL existing = post != nil;
+    if (!existing) {
         post = [NSEntityDescription insertNewObjectForEntityForName:@"ReaderPost"
                                              inManagedObjectContext:managedObjectContext];
     }
@@ -185,7 +293,7 @@ static NSString * const SourceAttributionStandardTaxonomy = @"standard-pick";
         post.sourceAttribution = nil;
     }
 
-    post.content = [RichContentFormatter removeInlineStyles:[RichContentFormatter removeForbiddenTags:remotePost.content]];
+    post.content = content;
 
     // assign the topic last.
     post.topic = topic;
@@ -69,160 +69,148 @@ NSString *const WPBlogSettingsUpdatedNotification = @"WPBlogSettingsUpdatedNotif
 
 - (void)syncBlogAndAllMetadata:(Blog *)blog completionHandler:(void (^)(void))completionHandler
 {
-    // Create a dispatch group. We'll use this to monitor completion of the various
-    // remote calls and to execute the completionHandler.
-    dispatch_group_t syncGroup = dispatch_group_create();
+    // The remote calls are run by the shared scheduler, which limits how many of them run at the same time
+    // across all the blogs being synced. Each task calls `done` when its call has ended with success or failure.
+    BlogSyncPlan *plan = [[BlogSyncPlan alloc] initWithBlog:blog];
 
     NSManagedObjectID *blogObjectID = blog.objectID;
     id<BlogServiceRemote> remote = [self remoteForBlog:blog];
 
     if ([remote isKindOfClass:[BlogServiceRemoteXMLRPC class]]) {
-        dispatch_group_enter(syncGroup);
         BlogServiceRemoteXMLRPC *xmlrpcRemote = remote;
-        [xmlrpcRemote syncBlogOptionsWithSuccess:[self optionsHandlerWithBlogObjectID:blogObjectID
-                                                                    completionHandler:^{
-                                                                        dispatch_group_leave(syncGroup);
-                                                                    }]
-                                         failure:^(NSError *error) {
-                                             DDLogError(@"Failed syncing options for blog %@: %@", blog.url, error);
-                                             dispatch_group_leave(syncGroup);
-                                         }];
+        [plan addTaskNamed:@"options" priority:BlogSyncTaskPriorityHigh dependencies:@[] work:^(void (^done)(void)) {
+            [xmlrpcRemote syncBlogOptionsWithSuccess:[self optionsHandlerWithBlogObjectID:blogObjectID
+                                                                        completionHandler:done]
+                                             failure:^(NSError *error) {
+                                                 DDLogError(@"Failed syncing options for blog %@: %@", blog.url, error);
+                                                 done();
+                                             }];
+        }];
     }
 
     if ([remote isKindOfClass:[BlogServiceRemoteREST class]]) {
-        dispatch_group_enter(syncGroup);
         BlogServiceRemoteREST *restRemote = remote;
-        [restRemote syncBlogWithSuccess:[self blogDetailsHandlerWithBlogObjectID:blogObjectID
-                                                               completionHandler:^{
-                                                                   dispatch_group_leave(syncGroup);
-                                                               }]
-                                failure:^(NSError *error) {
-                                    DDLogError(@"Failed syncing site details for blog %@: %@", blog.url, error);
-                                    dispatch_group_leave(syncGroup);
-                                }];
-
-        dispatch_group_enter(syncGroup);
-        [restRemote syncBlogSettingsWithSuccess:^(RemoteBlogSettings *settings) {
-            [self.coreDataStack performAndSaveUsingBlock:^(NSManagedObjectContext *context) {
-                Blog *blogInContext = (Blog *)[context existingObjectWithID:blogObjectID error:nil];
-                if (blogInContext) {
-                    [self updateSettings:blogInContext.settings withRemoteSettings:settings];
-                }
-            } completion:^{
-                dispatch_group_leave(syncGroup);
-            } onQueue:dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0)];
-        } failure:^(NSError *error) {
-            DDLogError(@"Failed syncing settings for blog %@: %@", blog.url, error);
-            dispatch_group_leave(syncGroup);
+        [plan addTaskNamed:@"options" priority:BlogSyncTaskPriorityHigh dependencies:@[] work:^(void (^done)(void)) {
+            [restRemote syncBlogWithSuccess:[self blogDetailsHandlerWithBlogObjectID:blogObjectID
+                                                                   completionHandler:done]
+                                    failure:^(NSError *error) {
+                                        DDLogError(@"Failed syncing site details for blog %@: %@", blog.url, error);
+                                        done();
+                                    }];
+        }];
+
+        [plan addTaskNamed:@"settings" priority:BlogSyncTaskPriorityHigh dependencies:@[] work:^(void (^done)(void)) {
+            [restRemote syncBlogSettingsWithSuccess:^(RemoteBlogSettings *settings) {
+                [self.coreDataStack performAndSaveUsingBlock:^(NSManagedObjectContext *context) {
+                    Blog *blogInContext = (Blog *)[context existingObjectWithID:blogObjectID error:nil];
+                    if (blogInContext) {
+                        [self updateSettings:blogInContext.settings withRemoteSettings:settings];
+                    }
+                } completion:done onQueue:dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0)];
+            } failure:^(NSError *error) {
+                DDLogError(@"Failed syncing settings for blog %@: %@", blog.url, error);
+                done();
+            }];
         }];
     }
 
-    dispatch_group_enter(syncGroup);
-    [remote syncPostFormatsWithSuccess:[self postFormatsHandlerWithBlogObjectID:blogObjectID
-                                                              completionHandler:^{
-                                                                  dispatch_group_leave(syncGroup);
-                                                              }]
-                               failure:^(NSError *error) {
-                                   DDLogError(@"Failed syncing post formats for blog %@: %@", blog.url, error);
-                                   dispatch_group_leave(syncGroup);
-                               }];
-
-    PostCategoryService *categoryService = [[PostCategoryService alloc] initWithCoreDataStack:self.coreDataStack];
-    dispatch_group_enter(syncGroup);
-    [categoryService syncCategoriesForBlog:blog
-                                   success:^{
-                                       dispatch_group_leave(syncGroup);
-                                   }
+    [plan addTaskNamed:@"postFormats" priority:BlogSyncTaskPriorityNormal dependencies:@[] work:^(void (^done)(void)) {
+        [remote syncPostFormatsWithSuccess:[self postFormatsHandlerWithBlogObjectID:blogObjectID
+                                                                  completionHandler:done]
                                    failure:^(NSError *error) {
-                                       DDLogError(@"Failed syncing categories for blog %@: %@", blog.url, error);
-                                       dispatch_group_leave(syncGroup);
+                                       DDLogError(@"Failed syncing post formats for blog %@: %@", blog.url, error);
+                                       done();
                                    }];
+    }];
 
-    SharingSyncService *sharingService = [[SharingSyncService alloc] initWithCoreDataStack:self.coreDataStack];
-    dispatch_group_enter(syncGroup);
-    [sharingService syncPublicizeConnectionsForBlog:blog
-                                            success:^{
-                                                dispatch_group_leave(syncGroup);
-                                            }
-                                            failure:^(NSError *error) {
-                                                DDLogError(@"Failed syncing publicize connections for blog %@: %@", blog.url, error);
-                                                dispatch_group_leave(syncGroup);
-                                            }];
-
-    SharingService *publicizeService = [[SharingService alloc] initWithContextManager:[ContextManager sharedInstance]];
-    dispatch_group_enter(syncGroup);
-    [publicizeService syncPublicizeServicesForBlog:blog success:^{
-        dispatch_group_leave(syncGroup);
-    } failure:^(NSError * _Nullable error) {
-        DDLogError(@"Failed syncing publicize services for blog %@: %@", blog.url, error);
-        dispatch_group_leave(syncGroup);
+    [plan addTaskNamed:@"categories" priority:BlogSyncTaskPriorityNormal dependencies:@[] work:^(void (^done)(void)) {
+        PostCategoryService *categoryService = [[PostCategoryService alloc] initWithCoreDataStack:self.coreDataStack];
+        [categoryService syncCategoriesForBlog:blog
+                                       success:done
+                                       failure:^(NSError *error) {
+                                           DDLogError(@"Failed syncing categories for blog %@: %@", blog.url, error);
+                                           done();
+                                       }];
     }];
 
-    if ([RemoteFeature enabled:RemoteFeatureFlagJetpackSocialImprovements] && blog.dotComID != nil) {
-        JetpackSocialService *jetpackSocialService = [[JetpackSocialService alloc] initWithContextManager:ContextManager.sharedInstance];
-        dispatch_group_enter(syncGroup);
-        [jetpackSocialService syncSharingLimitWithDotComID:blog.dotComID success:^{
-            dispatch_group_leave(syncGroup);
-        } failure:^(NSError * _Nullable error) {
-            DDLogError(@"Failed syncing publicize sharing limit for blog %@: %@", blog.url, error);
-            dispatch_group_leave(syncGroup);
+    [plan addTaskNamed:@"authors" priority:BlogSyncTaskPriorityNormal dependencies:@[] work:^(void (^done)(void)) {
+        [remote getAllAuthorsWithSuccess:^(NSArray<RemoteUser *> *users) {
+            [self updateMultiAuthor:users forBlog:blogObjectID completionHandler:done];
+        } failure:^(NSError *error) {
+            DDLogError(@"Failed checking multi-author status for blog %@: %@", blog.url, error);
+            done();
         }];
-    }
+    }];
 
-    dispatch_group_enter(syncGroup);
-    [remote getAllAuthorsWithSuccess:^(NSArray<RemoteUser *> *users) {
-        [self updateMultiAuthor:users forBlog:blogObjectID completionHandler:^{
-            dispatch_group_leave(syncGroup);
+    // The editor settings depend on the Jetpack and Gutenberg options synced with the blog details.
+    [plan addTaskNamed:@"editorSettings" priority:BlogSyncTaskPriorityNormal dependencies:@[@"options"] work:^(void (^done)(void)) {
+        EditorSettingsService *editorService = [[EditorSettingsService alloc] initWithCoreDataStack:self.coreDataStack];
+        [editorService syncEditorSettingsForBlog:blog success:done failure:^(NSError * _Nonnull __unused error) {
+            DDLogError(@"Failed to sync Editor settings");
+            done();
         }];
-    } failure:^(NSError *error) {
-        DDLogError(@"Failed checking multi-author status for blog %@: %@", blog.url, error);
-        dispatch_group_leave(syncGroup);
     }];
 
-    PlanService *planService = [[PlanService alloc] initWithCoreDataStack:self.coreDataStack];
-    dispatch_group_enter(syncGroup);
-    [planService getWpcomPlans:blog.account
-                       success:^{
-        dispatch_group_leave(syncGroup);
-    } failure:^(NSError *error) {
-        DDLogError(@"Failed updating plans: %@", error);
-        dispatch_group_leave(syncGroup);
+    [plan addTaskNamed:@"publicizeConnections" priority:BlogSyncTaskPriorityLow dependencies:@[] work:^(void (^done)(void)) {
+        SharingSyncService *sharingService = [[SharingSyncService alloc] initWithCoreDataStack:self.coreDataStack];
+        [sharingService syncPublicizeConnectionsForBlog:blog
+                                                success:done
+                                                failure:^(NSError *error) {
+                                                    DDLogError(@"Failed syncing publicize connections for blog %@: %@", blog.url, error);
+                                                    done();
+                                                }];
     }];
 
-    dispatch_group_enter(syncGroup);
-    [planService plansWithPricesForBlog:blog success:^{
-        dispatch_group_leave(syncGroup);
-    } failure:^(NSError *error) {
-        DDLogError(@"Failed checking domain credit for site %@: %@", blog.url, error);
-        dispatch_group_leave(syncGroup);
+    [plan addTaskNamed:@"publicizeServices" priority:BlogSyncTaskPriorityLow dependencies:@[] work:^(void (^done)(void)) {
+        SharingService *publicizeService = [[SharingService alloc] initWithContextManager:[ContextManager sharedInstance]];
+        [publicizeService syncPublicizeServicesForBlog:blog success:done failure:^(NSError * _Nullable error) {
+            DDLogError(@"Failed syncing publicize services for blog %@: %@", blog.url, error);
+            done();
+        }];
     }];
 
-    EditorSettingsService *editorService = [[EditorSettingsService alloc] initWithCoreDataStack:self.coreDataStack];
-    dispatch_group_enter(syncGroup);
-    [editorService syncEditorSettingsForBlog:blog success:^{
-        dispatch_group_leave(syncGroup);
-    } failure:^(NSError * _Nonnull __unused error) {
-        DDLogError(@"Failed to sync Editor settings");
-        dispatch_group_leave(syncGroup);
+    if ([RemoteFeature enabled:RemoteFeatureFlagJetpackSocialImprovements] && blog.dotComID != nil) {
+        NSNumber *dotComID = blog.dotComID;
+        [plan addTaskNamed:@"sharingLimit" priority:BlogSyncTaskPriorityLow dependencies:@[] work:^(void (^done)(void)) {
+            JetpackSocialService *jetpackSocialService = [[JetpackSocialService alloc] initWithContextManager:ContextManager.sharedInstance];
+            [jetpackSocialService syncSharingLimitWithDotComID:dotComID success:done failure:^(NSError * _Nullable error) {
+                DDLogError(@"Failed syncing publicize sharing limit for blog %@: %@", blog.url, error);
+                done();
+            }];
+        }];
+    }
+
+    // The plans are the same for all the blogs of an account, so they're only fetched once when several blogs are synced.
+    WPAccount *account = blog.account;
+    [plan addAccountTaskNamed:@"wpcomPlans" account:account priority:BlogSyncTaskPriorityLow work:^(void (^done)(void)) {
+        PlanService *planService = [[PlanService alloc] initWithCoreDataStack:self.coreDataStack];
+        [planService getWpcomPlans:account
+                           success:done
+                           failure:^(NSError *error) {
+            DDLogError(@"Failed updating plans: %@", error);
+            done();
+        }];
     }];
-    
+
+    [plan addTaskNamed:@"planPrices" priority:BlogSyncTaskPriorityLow dependencies:@[] work:^(void (^done)(void)) {
+        PlanService *planService = [[PlanService alloc] initWithCoreDataStack:self.coreDataStack];
+        [planService plansWithPricesForBlog:blog success:done failure:^(NSError *error) {
+            DDLogError(@"Failed checking domain credit for site %@: %@", blog.url, error);
+            done();
+        }];
+    }];
+
     if ([FreeToPaidPlansDashboardCardHelper isFeatureEnabled]) {
-        dispatch_group_enter(syncGroup);
-        [self refreshDomainsFor:blog success:^{
-            dispatch_group_leave(syncGroup);
-        } failure:^(NSError * _Nonnull error) {
-            DDLogError(@"Failed refreshing domains: %@", error);
-            dispatch_group_leave(syncGroup);
+        [plan addTaskNamed:@"domains" priority:BlogSyncTaskPriorityLow dependencies:@[] work:^(void (^done)(void)) {
+            [self refreshDomainsFor:blog success:done failure:^(NSError * _Nonnull error) {
+                DDLogError(@"Failed refreshing domains: %@", error);
+                done();
+            }];
         }];
     }
-    
-    // When everything has left the syncGroup (all calls have ended with success
-    // or failure) perform the completionHandler
-    dispatch_group_notify(syncGroup, dispatch_get_main_queue(),^{
-        if (completionHandler) {
-            completionHandler();
-        }
-    });
+
+    // When all the tasks have ended with success or failure, perform the completionHandler
+    [[BlogSyncScheduler sharedInstance] run:plan completion:completionHandler];
 }
 
 - (void)syncSettingsForBlog:(Blog *)blog
@@ -373,8 +361,10 @@ NSString *const WPBlogSettingsUpdatedNotification = @"WPBlogSettingsUpdatedNotif
 - (Blog *)findBlogWithDotComID:(NSNumber *)dotComID
                      inAccount:(WPAccount *)account
 {
-    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"dotComID = %@", dotComID];
-    return [[account.blogs filteredSetUsingPredicate:predicate] anyObject];
+    if (!account || !dotComID) {
+        return nil;
+    }
+    return [Blog lookupWithDotComID:dotComID inAccount:account];
 }
 
 - (void)removeBlog:(Blog *)blog
@@ -0,0 +1,243 @@
+import Foundation
+import os
+
+@objc enum BlogSyncTaskPriority: Int {
+    case low
+    case normal
+    case high
+}
+
+/// A set of remote calls which sync a blog, and the order they need to run in.
+///
+/// Each task calls its `done` block once it has finished, whether it succeeded or failed. A task
+/// only starts once the tasks it depends on have finished.
+///
+@objc final class BlogSyncPlan: NSObject {
+    typealias Work = (_ done: @escaping () -> Void) -> Void
+
+    struct Task {
+        let key: String
+        let name: String
+        let priority: BlogSyncTaskPriority
+        let dependencies: [String]
+        let work: Work
+    }
+
+    private let identifier: String
+    private(set) var tasks: [Task] = []
+
+    @objc init(blog: Blog) {
+        self.identifier = blog.objectID.uriRepresentation().absoluteString
+    }
+
+    /// Adds a task which syncs the blog.
+    ///
+    /// - Parameters:
+    ///   - name: The name of the task, unique within the plan.
+    ///   - priority: Tasks with a higher priority start first.
+    ///   - dependencies: The names of the tasks of this plan which need to finish before this one starts.
+    ///   - work: The remote call. It must call its `done` block once it has finished.
+    @objc func addTask(named name: String, priority: BlogSyncTaskPriority, dependencies: [String], work: @escaping Work) {
+        assert(!tasks.contains { $0.name == name }, "Duplicate task \(name)")
+        assert(dependencies.allSatisfy { dependency in tasks.contains { $0.name == dependency } }, "Dependencies must be added first")
+
+        let key = "\(identifier)/\(name)"
+        tasks.append(Task(key: key, name: name, priority: priority, dependencies: dependencies.map { "\(identifier)/\($0)" }, work: work))
+    }
+
+    /// Adds a task which syncs data shared by all the blogs of an account.
+    ///
+    /// The task isn't run again if the same task of another plan is still waiting or running.
+    @objc func addAccountTask(named name: String, account: WPAccount?, priority: BlogSyncTaskPriority, work: @escaping Work) {
+        let accountIdentifier = account?.objectID.uriRepresentation().absoluteString ?? "no-account"
+        tasks.append(Task(key: "\(accountIdentifier)/\(name)", name: name, priority: priority, dependencies: [], work: work))
+    }
+}
+
+/// Runs the remote calls of the blog sync plans with a bounded concurrency, so that syncing a lot of blogs
+/// doesn't flood the network and the Core Data writer.
+///
+/// The tasks of all plans share the same slots. Among the tasks that are ready, the one with the highest
+/// priority, then the oldest one, starts first. A task that is already waiting or running, like the ones shared
+/// by the blogs of an account, isn't added twice.
+///
+/// Every task is recorded as a "Blog Sync Task" signpost interval.
+///
+@objc final class BlogSyncScheduler: NSObject {
+
+    struct Metrics: CustomStringConvertible {
+        var tasks = 0
+        var deduplicated = 0
+        /// The time spent waiting for a slot or for dependencies.
+        var waitDuration: TimeInterval = 0
+        var runDuration: TimeInterval = 0
+        var longestTask: (name: String, duration: TimeInterval)?
+
+        var description: String {
+            let wait = String(format: "%.0f", waitDuration * 1000)
+            let run = String(format: "%.0f", runDuration * 1000)
+            let longest = longestTask.map { "\($0.name) \(String(format: "%.0f", $0.duration * 1000)) ms" } ?? "-"
+            return "tasks: \(tasks), deduplicated: \(deduplicated), wait: \(wait) ms, run: \(run) ms, longest: \(longest)"
+        }
+    }
+
+    @objc(sharedInstance)
+    static let shared = BlogSyncScheduler(maxConcurrentTasks: 4)
+
+    let maxConcurrentTasks: Int
+
+    private let queue = DispatchQueue(label: "org.wordpress.BlogSyncScheduler")
+    private let workQueue: DispatchQueue
+    private let signposter = OSSignposter(subsystem: "org.wordpress", category: "BlogSync")
+
+    // The properties below are only accessed on `queue`.
+    private var waiting: [ScheduledTask] = []
+    private var scheduledTasks: [String: ScheduledTask] = [:]
+    private var runningCount = 0
+    private var _metrics = Metrics()
+
+    /// - Parameters:
+    ///   - maxConcurrentTasks: The maximum number of tasks running at the same time.
+    ///   - workQueue: The queue on which the tasks start. The main queue by default, since the tasks use the
+    ///         blogs of the main context.
+    init(maxConcurrentTasks: Int, workQueue: DispatchQueue = .main) {
+        precondition(maxConcurrentTasks > 0)
+        self.maxConcurrentTasks = maxConcurrentTasks
+        self.workQueue = workQueue
+    }
+
+    var metrics: Metrics {
+        queue.sync { _metrics }
+    }
+
+    /// Schedules the tasks of the plan.
+    ///
+    /// - Parameters:
+    ///   - plan: The tasks to run.
+    ///   - completion: A block called on the main queue once all the tasks of the plan have finished.
+    @objc func run(_ plan: BlogSyncPlan, completion: (() -> Void)?) {
+        let group = DispatchGroup()
+        let tasks = plan.tasks
+        tasks.forEach { _ in group.enter() }
+
+        queue.async {
+            for task in tasks {
+                self.schedule(task) { group.leave() }
+            }
+            self.startReadyTasks()
+        }
+
+        group.notify(queue: .main) {
+            completion?()
+        }
+    }
+
+    // MARK: - Private
+
+    private func schedule(_ task: BlogSyncPlan.Task, completion: @escaping () -> Void) {
+        dispatchPrecondition(condition: .onQueue(queue))
+
+        if let scheduled = scheduledTasks[task.key] {
+            scheduled.completions.append(completion)
+            _metrics.deduplicated += 1
+            return
+        }
+
+        let scheduled = ScheduledTask(task: task)
+        // Dependencies that have already finished aren't waited for.
+        scheduled.pendingDependencies = Set(task.dependencies.filter { scheduledTasks[$0] != nil })
+        scheduled.completions.append(completion)
+        scheduledTasks[task.key] = scheduled
+        waiting.append(scheduled)
+    }
+
+    private func startReadyTasks() {
+        dispatchPrecondition(condition: .onQueue(queue))
+
+        while runningCount < maxConcurrentTasks, let index = indexOfNextReadyTask() {
+            let scheduled = waiting.remove(at: index)
+            start(scheduled)
+        }
+    }
+
+    /// The waiting tasks are in the order they were added, so the first one with the highest priority is picked.
+    private func indexOfNextReadyTask() -> Int? {
+        var next: (index: Int, task: ScheduledTask)?
+        for (index, task) in waiting.enumerated() where task.pendingDependencies.isEmpty {
+            guard let current = next?.task else {
+                next = (index, task)
+                continue
+            }
+            if task.task.priority.rawValue > current.task.priority.rawValue {
+                next = (index, task)
+            }
+        }
+        return next?.index
+    }
+
+    private func start(_ scheduled: ScheduledTask) {
+        runningCount += 1
+        scheduled.startTime = CFAbsoluteTimeGetCurrent()
+
+        let name = scheduled.task.name
+        let signpostState = signposter.beginInterval("Blog Sync Task", id: signposter.makeSignpostID(), "\(name, privacy: .public)")
+        let work = scheduled.task.work
+
+        workQueue.async {
+            work {
+                self.queue.async {
+                    self.finish(scheduled, signpostState: signpostState)
+                }
+            }
+        }
+    }
+
+    private func finish(_ scheduled: ScheduledTask, signpostState: OSSignpostIntervalState) {
+        dispatchPrecondition(condition: .onQueue(queue))
+
+        guard scheduledTasks[scheduled.task.key] === scheduled else {
+            assertionFailure("The task \(scheduled.task.name) called its done block more than once")
+            return
+        }
+        signposter.endInterval("Blog Sync Task", signpostState)
+
+        runningCount -= 1
+        scheduledTasks[scheduled.task.key] = nil
+        for task in waiting {
+            task.pendingDependencies.remove(scheduled.task.key)
+        }
+
+        record(scheduled)
+        scheduled.completions.forEach { $0() }
+
+        startReadyTasks()
+    }
+
+    private func record(_ scheduled: ScheduledTask) {
+        let now = CFAbsoluteTimeGetCurrent()
+        let startTime = scheduled.startTime ?? now
+        let wait = startTime - scheduled.enqueueTime
+        let duration = now - startTime
+
+        _metrics.tasks += 1
+        _metrics.waitDuration += wait
+        _metrics.runDuration += duration
+        if duration > (_metrics.longestTask?.duration ?? 0) {
+            _metrics.longestTask = (scheduled.task.name, duration)
+        }
+
+        DDLogDebug("BlogSyncScheduler: \(scheduled.task.key) waited \(String(format: "%.0f", wait * 1000)) ms, ran for \(String(format: "%.0f", duration * 1000)) ms")
+    }
+}
+
+private final class ScheduledTask {
+    let task: BlogSyncPlan.Task
+    let enqueueTime = CFAbsoluteTimeGetCurrent()
+    var startTime: CFAbsoluteTime?
+    var pendingDependencies: Set<String> = []
+    var completions: [() -> Void] = []
+
+    init(task: BlogSyncPlan.Task) {
+        self.task = task
+    }
+}
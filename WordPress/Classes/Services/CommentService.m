@@ -986,25 +986,31 @@ static NSTimeInterval const CommentsRefreshTimeoutInSeconds = 60 * 5; // 5 minut
 {
     NSParameterAssert(blog.managedObjectContext != nil);
 
-    NSMutableArray *commentsToKeep = [NSMutableArray array];
+    // Purging needs every cached comment, otherwise only the ones in this page are looked up.
+    NSPredicate *predicate = purgeExisting
+        ? [NSPredicate predicateWithFormat:@"blog = %@", blog]
+        : [NSPredicate predicateWithFormat:@"blog = %@ AND commentID IN %@", blog, [self commentIDsFromRemoteComments:comments]];
+    NSArray<Comment *> *existingComments = [self commentsMatchingPredicate:predicate inContext:blog.managedObjectContext];
+    NSMutableDictionary<NSNumber *, Comment *> *commentsByID = [self commentsByIDFromComments:existingComments];
+
+    NSMutableSet<Comment *> *commentsToKeep = [NSMutableSet setWithCapacity:comments.count];
     for (RemoteComment *remoteComment in comments) {
-        Comment *comment = [blog commentWithID:remoteComment.commentID];
+        NSNumber *commentID = @([remoteComment.commentID intValue]);
+        Comment *comment = commentsByID[commentID];
         if (!comment) {
             comment = [self createCommentForBlog:blog];
+            commentsByID[commentID] = comment;
         }
         [self updateComment:comment withRemoteComment:remoteComment];
         [commentsToKeep addObject:comment];
     }
 
     if (purgeExisting) {
-        NSSet *existingComments = blog.comments;
-        if (existingComments.count > 0) {
-            for (Comment *comment in existingComments) {
-                // Don't delete unpublished comments
-                if (![commentsToKeep containsObject:comment] && comment.commentID != 0) {
-                    DDLogInfo(@"Deleting Comment: %@", comment);
-                    [blog.managedObjectContext deleteObject:comment];
-                }
+        for (Comment *comment in existingComments) {
+            // Don't delete unpublished comments
+            if (![commentsToKeep containsObject:comment] && comment.commentID != 0) {
+                DDLogInfo(@"Deleting Comment: %@", comment);
+                [blog.managedObjectContext deleteObject:comment];
             }
         }
     }
@@ -1012,6 +1018,42 @@ static NSTimeInterval const CommentsRefreshTimeoutInSeconds = 60 * 5; // 5 minut
     [self deleteUnownedCommentsInContext:blog.managedObjectContext];
 }
 
+- (NSArray<NSNumber *> *)commentIDsFromRemoteComments:(NSArray<RemoteComment *> *)comments
+{
+    NSMutableArray<NSNumber *> *commentIDs = [NSMutableArray arrayWithCapacity:comments.count];
+    for (RemoteComment *remoteComment in comments) {
+        [commentIDs addObject:@([remoteComment.commentID intValue])];
+    }
+    return commentIDs;
+}
+
+// Fetches the matching comments, including unsaved ones, with a single request
+- (NSArray<Comment *> *)commentsMatchingPredicate:(NSPredicate *)predicate inContext:(NSManagedObjectContext *)context
+{
+    NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] initWithEntityName:NSStringFromClass([Comment class])];
+    fetchRequest.predicate = predicate;
+    fetchRequest.returnsObjectsAsFaults = NO;
+
+    NSError *error;
+    NSArray<Comment *> *results = [context executeFetchRequest:fetchRequest error:&error];
+    if (error) {
+        DDLogError(@"Error fetching comments matching %@: %@", predicate, error);
+    }
+    return results ?: @[];
+}
+
+// Indexes comments by commentID. Unpublished comments, whose commentID is 0, are left out.
+- (NSMutableDictionary<NSNumber *, Comment *> *)commentsByIDFromComments:(NSArray<Comment *> *)comments
+{
+    NSMutableDictionary<NSNumber *, Comment *> *commentsByID = [NSMutableDictionary dictionaryWithCapacity:comments.count];
+    for (Comment *comment in comments) {
+        if (comment.commentID != 0) {
+            commentsByID[@(comment.commentID)] = comment;
+        }
+    }
+    return commentsByID;
+}
+
 #pragma mark - Post centric methods
 
 - (NSMutableArray *)ancestorsForCommentWithParentID:(NSNumber *)parentID andCurrentAncestors:(NSArray *)currentAncestors
@@ -1173,17 +1215,26 @@ static NSTimeInterval const CommentsRefreshTimeoutInSeconds = 60 * 5; // 5 minut
         return NO;
     }
 
+    // The first page purges every cached comment missing from it, so it needs all of them.
+    NSPredicate *predicate = page == 1
+        ? [NSPredicate predicateWithFormat:@"post = %@", post]
+        : [NSPredicate predicateWithFormat:@"post = %@ AND commentID IN %@", post, [self commentIDsFromRemoteComments:comments]];
+    NSArray<Comment *> *existingComments = [self commentsMatchingPredicate:predicate inContext:post.managedObjectContext];
+    NSMutableDictionary<NSNumber *, Comment *> *commentsByID = [self commentsByIDFromComments:existingComments];
+
     NSMutableSet<NSNumber *> *visibleCommentIds = [NSMutableSet new];
     NSMutableArray *ancestors = [NSMutableArray array];
-    NSMutableArray *commentsToKeep = [NSMutableArray array];
+    NSMutableSet<Comment *> *commentsToKeep = [NSMutableSet setWithCapacity:comments.count];
     NSString *entityName = NSStringFromClass([Comment class]);
     NSUInteger newCommentCount = 0;
 
     for (RemoteComment *remoteComment in comments) {
-        Comment *comment = [post commentWithID:remoteComment.commentID];
+        NSNumber *commentID = @([remoteComment.commentID intValue]);
+        Comment *comment = commentsByID[commentID];
         if (!comment) {
             newCommentCount++;
             comment = [NSEntityDescription insertNewObjectForEntityForName:entityName inManagedObjectContext:post.managedObjectContext];
+            commentsByID[commentID] = comment;
         }
 
         [self updateComment:comment withRemoteComment:remoteComment];
@@ -1213,7 +1264,7 @@ static NSTimeInterval const CommentsRefreshTimeoutInSeconds = 60 * 5; // 5 minut
     // cached and missing from the comments just synced. This provides for a clean slate and
     // helps avoid certain cases where some pages might not be resynced, creating gaps in the content.
     if (page == 1) {
-        [self deleteCommentsMissingFromHierarchicalComments:commentsToKeep forPost:post];
+        [self deleteComments:existingComments missingFromHierarchicalComments:commentsToKeep];
         [self deleteUnownedCommentsInContext:post.managedObjectContext];
     }
 
@@ -1226,11 +1277,11 @@ static NSTimeInterval const CommentsRefreshTimeoutInSeconds = 60 * 5; // 5 minut
 }
 
 // Does not save context
-- (void)deleteCommentsMissingFromHierarchicalComments:(NSArray *)commentsToKeep forPost:(ReaderPost *)post
+- (void)deleteComments:(NSArray<Comment *> *)comments missingFromHierarchicalComments:(NSSet<Comment *> *)commentsToKeep
 {
-    for (Comment *comment in post.comments) {
+    for (Comment *comment in comments) {
         if (![commentsToKeep containsObject:comment]) {
-            [post.managedObjectContext deleteObject:comment];
+            [comment.managedObjectContext deleteObject:comment];
         }
     }
 }
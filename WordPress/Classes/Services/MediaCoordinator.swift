@@ -42,9 +42,18 @@ class MediaCoordinator: NSObject {
 
     private let mediaServiceFactory: MediaService.Factory
 
-    init(_ mediaServiceFactory: MediaService.Factory = MediaService.Factory(), coreDataStack: CoreDataStackSwift = ContextManager.shared) {
+    /// Limits the number of concurrent uploads, and decides which upload starts next.
+    let uploadScheduler: MediaUploadScheduler
+
+    /// The delay before the first automated retry of a failed upload. It doubles with every failure.
+    private static let automatedRetryBaseDelay: TimeInterval = 2
+
+    init(_ mediaServiceFactory: MediaService.Factory = MediaService.Factory(),
+         coreDataStack: CoreDataStackSwift = ContextManager.shared,
+         uploadScheduler: MediaUploadScheduler = MediaUploadScheduler()) {
         self.mediaServiceFactory = mediaServiceFactory
         self.coreDataStack = coreDataStack
+        self.uploadScheduler = uploadScheduler
 
         super.init()
 
@@ -79,6 +88,15 @@ class MediaCoordinator: NSObject {
         return isPushingAllPendingMedia
     }
 
+    /// Starts the uploads of the media of the given post before the other ones, e.g. while
+    /// the post is open in the editor.
+    ///
+    /// - parameter post: The post to prioritize, or `nil` to stop prioritizing a post.
+    ///
+    func prioritizeUploads(for post: AbstractPost?) {
+        uploadScheduler.prioritizedGroup = post?.original().objectID
+    }
+
     /// - returns: The progress coordinator for the specified post. If a coordinator
     ///            does not exist, one will be created.
     private func coordinator(for post: AbstractPost) -> MediaProgressCoordinator {
@@ -366,10 +384,14 @@ class MediaCoordinator: NSObject {
     private func uploadMedia(_ media: Media, automatedRetry: Bool = false) -> Progress {
         let resultProgress = Progress.discreteProgress(totalUnitCount: 100)
 
+        var uploadCompletion: ((_ bytes: Int64, _ succeeded: Bool) -> Void)?
+
         let success: () -> Void = {
+            uploadCompletion?(media.filesize?.int64Value ?? 0, true)
             self.end(media)
         }
         let failure: (Error?) -> Void = { error in
+            uploadCompletion?(0, false)
             // Ideally the upload service should always return an error.  This may be easier to enforce
             // if we update the service to Swift, but in the meanwhile I'm instantiating an unknown upload
             // error whenever the service doesn't provide one.
@@ -395,10 +417,39 @@ class MediaCoordinator: NSObject {
         // the successfully uploaded media is shown as a "local" assets incorrectly (see the issue comment linked below).
         // https://github.com/wordpress-mobile/WordPress-iOS/issues/20298#issuecomment-1465319707
         let service = self.mediaServiceFactory.create(coreDataStack.mainContext)
-        var progress: Progress? = nil
-        service.uploadMedia(media, automatedRetry: automatedRetry, progress: &progress, success: success, failure: failure)
-        if let progress {
-            resultProgress.addChild(progress, withPendingUnitCount: resultProgress.totalUnitCount)
+
+        // The automated retries of media that keep failing are delayed exponentially.
+        let failureCount = automatedRetry ? media.autoUploadFailureCount.intValue : 0
+        let delay = failureCount > 0 ? MediaCoordinator.automatedRetryBaseDelay * pow(2, Double(failureCount - 1)) : 0
+        let group: AnyHashable = (media.posts?.first as? AbstractPost)?.original().objectID ?? "library"
+
+        // The media is marked as uploading right away, so that it isn't queued again while waiting to start.
+        media.remoteStatus = .pushing
+
+        // The media of unknown size are uploaded last.
+        let size = media.filesize?.int64Value ?? Int64.max
+        let progressCoordinator = coordinator(for: media)
+        let uploadID = media.uploadID
+        // Checked once, right before the upload starts. The observers were already told about
+        // a cancellation or deletion, so the upload is dropped without reporting a failure.
+        let isCancelled: () -> Bool = {
+            let isDeleted = media.isDeleted || media.managedObjectContext == nil
+            guard resultProgress.isCancelled || isDeleted else {
+                return false
+            }
+            if !isDeleted {
+                media.remoteStatus = .failed
+            }
+            progressCoordinator.attach(error: NSError(domain: NSURLErrorDomain, code: NSURLErrorCancelled), toMediaID: uploadID)
+            return true
+        }
+        uploadScheduler.enqueue(group: group, size: size, delay: delay, isCancelled: isCancelled) { completion in
+            uploadCompletion = completion
+            var progress: Progress? = nil
+            service.uploadMedia(media, automatedRetry: automatedRetry, progress: &progress, success: success, failure: failure)
+            if let progress {
+                resultProgress.addChild(progress, withPendingUnitCount: resultProgress.totalUnitCount)
+            }
         }
 
         uploading(media, progress: resultProgress)
@@ -516,7 +567,29 @@ class MediaCoordinator: NSObject {
 
     typealias ObserverBlock = (Media, MediaState) -> Void
 
-    private var mediaObservers = [UUID: MediaObserver]()
+    struct ObserverMetrics: CustomStringConvertible {
+        /// The number of updates delivered to observers.
+        var delivered = 0
+        /// The number of progress updates replaced by a newer one before being delivered.
+        var coalesced = 0
+
+        var description: String {
+            "delivered: \(delivered), coalesced: \(coalesced)"
+        }
+    }
+
+    /// The progress updates are delivered at most once per frame.
+    private static let progressCoalescingInterval: TimeInterval = 1.0 / 60
+
+    // The properties below are only accessed on `queue`.
+    private var mediaObservers = MediaObserverRegistry()
+    private var pendingProgress = [NSManagedObjectID: PendingProgress]()
+    private var isProgressDeliveryScheduled = false
+    private var _observerMetrics = ObserverMetrics()
+
+    var observerMetrics: ObserverMetrics {
+        queue.sync { _observerMetrics }
+    }
 
     /// Add an observer to receive updates when media items are updated.
     ///
@@ -539,7 +612,7 @@ class MediaCoordinator: NSObject {
         )
 
         queue.async {
-            self.mediaObservers[uuid] = observer
+            self.mediaObservers.add(observer, uuid: uuid)
         }
 
         return uuid
@@ -563,7 +636,7 @@ class MediaCoordinator: NSObject {
         let observer = MediaObserver(subject: .post(id: original.objectID), onUpdate: onUpdate)
 
         queue.async {
-            self.mediaObservers[uuid] = observer
+            self.mediaObservers.add(observer, uuid: uuid)
         }
 
         return uuid
@@ -576,7 +649,7 @@ class MediaCoordinator: NSObject {
     @objc
     func removeObserver(withUUID uuid: UUID) {
         queue.async {
-            self.mediaObservers[uuid] = nil
+            self.mediaObservers.remove(uuid: uuid)
         }
     }
 
@@ -624,27 +697,66 @@ class MediaCoordinator: NSObject {
         let onUpdate: ObserverBlock
     }
 
-    /// Utility method to return all observers for a `Media` item with the given `NSManagedObjectID`
-    /// and part of the posts with given `NSManagedObjectID`s, including any 'wildcard' observers
-    /// that are observing _all_ media items.
-    ///
-    private func observersForMedia(withObjectID mediaObjectID: NSManagedObjectID, originalPostIDs: [NSManagedObjectID]) -> [MediaObserver] {
-        let mediaObservers = self.mediaObservers.values.filter({ $0.subject == .media(id: mediaObjectID) })
-
-        let postObservers = self.mediaObservers.values.filter({
-            guard case let .post(postObjectID) = $0.subject else { return false }
+    /// The observers indexed by the media item or post they observe, so that finding the
+    /// observers of a media item doesn't go through all of them.
+    private struct MediaObserverRegistry {
+        private var observers = [UUID: MediaObserver]()
+        private var mediaObserverIDs = [NSManagedObjectID: Set<UUID>]()
+        private var postObserverIDs = [NSManagedObjectID: Set<UUID>]()
+        /// The 'wildcard' observers that are observing _all_ media items.
+        private var wildcardObserverIDs = Set<UUID>()
+
+        mutating func add(_ observer: MediaObserver, uuid: UUID) {
+            remove(uuid: uuid)
+            observers[uuid] = observer
+            switch observer.subject {
+            case .media(let id):
+                mediaObserverIDs[id, default: []].insert(uuid)
+            case .post(let id):
+                postObserverIDs[id, default: []].insert(uuid)
+            case .all:
+                wildcardObserverIDs.insert(uuid)
+            }
+        }
 
-            return originalPostIDs.contains(postObjectID)
-        })
+        mutating func remove(uuid: UUID) {
+            guard let observer = observers.removeValue(forKey: uuid) else {
+                return
+            }
+            switch observer.subject {
+            case .media(let id):
+                mediaObserverIDs[id]?.remove(uuid)
+                if mediaObserverIDs[id]?.isEmpty == true {
+                    mediaObserverIDs[id] = nil
+                }
+            case .post(let id):
+                postObserverIDs[id]?.remove(uuid)
+                if postObserverIDs[id]?.isEmpty == true {
+                    postObserverIDs[id] = nil
+                }
+            case .all:
+                wildcardObserverIDs.remove(uuid)
+            }
+        }
 
-        return mediaObservers + postObservers + wildcardObservers
+        /// Returns all observers for a `Media` item with the given `NSManagedObjectID`
+        /// and part of the posts with given `NSManagedObjectID`s, including any 'wildcard' observers
+        /// that are observing _all_ media items.
+        ///
+        func observersForMedia(withObjectID mediaObjectID: NSManagedObjectID, originalPostIDs: Set<NSManagedObjectID>) -> [MediaObserver] {
+            var ids = Array(mediaObserverIDs[mediaObjectID] ?? [])
+            for postID in originalPostIDs {
+                ids.append(contentsOf: postObserverIDs[postID] ?? [])
+            }
+            ids.append(contentsOf: wildcardObserverIDs)
+            return ids.compactMap { observers[$0] }
+        }
     }
 
-    /// Utility method to return all 'wildcard' observers that are
-    /// observing _all_ media items.
-    ///
-    private var wildcardObservers: [MediaObserver] {
-        return mediaObservers.values.filter({ $0.subject == .all })
+    /// The latest progress of a media item, waiting to be delivered.
+    private struct PendingProgress {
+        let value: Double
+        let originalPostIDs: Set<NSManagedObjectID>
     }
 
     // MARK: - Notifying observers
@@ -685,27 +797,72 @@ class MediaCoordinator: NSObject {
     }
 
     func notifyObserversForMedia(_ media: Media, ofStateChange state: MediaState) {
-        let originalPostIDs: [NSManagedObjectID] = coreDataStack.performQuery { context in
+        let originalPostIDs: Set<NSManagedObjectID> = coreDataStack.performQuery { context in
             guard let mediaInContext = try? context.existingObject(with: media.objectID) as? Media else {
                 return []
             }
 
-            return mediaInContext.posts?.compactMap { (object: AnyHashable) in
+            let postIDs = mediaInContext.posts?.compactMap { (object: AnyHashable) in
                 guard let post = object as? AbstractPost else {
                     return nil
                 }
                 return post.original().objectID
             } ?? []
+            return Set(postIDs)
         }
 
+        let mediaObjectID = media.objectID
         queue.async {
-            self.observersForMedia(withObjectID: media.objectID, originalPostIDs: originalPostIDs).forEach({ observer in
-                DispatchQueue.main.async {
-                    if let media = self.mainContext.object(with: media.objectID) as? Media {
-                        observer.onUpdate(media, state)
-                    }
-                }
-            })
+            if case .progress(let value) = state {
+                self.enqueueProgress(value, forMediaWithObjectID: mediaObjectID, originalPostIDs: originalPostIDs)
+                return
+            }
+            // Deliver the pending progress first, so it doesn't arrive after the new state.
+            if let progress = self.pendingProgress.removeValue(forKey: mediaObjectID) {
+                self.deliver(.progress(value: progress.value), forMediaWithObjectID: mediaObjectID, originalPostIDs: progress.originalPostIDs)
+            }
+            self.deliver(state, forMediaWithObjectID: mediaObjectID, originalPostIDs: originalPostIDs)
+        }
+    }
+
+    /// Keeps the latest progress of each media item, and delivers them all once per frame.
+    private func enqueueProgress(_ value: Double, forMediaWithObjectID mediaObjectID: NSManagedObjectID, originalPostIDs: Set<NSManagedObjectID>) {
+        dispatchPrecondition(condition: .onQueue(queue))
+
+        if pendingProgress.updateValue(PendingProgress(value: value, originalPostIDs: originalPostIDs), forKey: mediaObjectID) != nil {
+            _observerMetrics.coalesced += 1
+        }
+
+        guard !isProgressDeliveryScheduled else {
+            return
+        }
+        isProgressDeliveryScheduled = true
+        queue.asyncAfter(deadline: .now() + MediaCoordinator.progressCoalescingInterval) {
+            self.isProgressDeliveryScheduled = false
+            let pendingProgress = self.pendingProgress
+            self.pendingProgress = [:]
+            for (mediaObjectID, progress) in pendingProgress {
+                self.deliver(.progress(value: progress.value), forMediaWithObjectID: mediaObjectID, originalPostIDs: progress.originalPostIDs)
+            }
+        }
+    }
+
+    private func deliver(_ state: MediaState, forMediaWithObjectID mediaObjectID: NSManagedObjectID, originalPostIDs: Set<NSManagedObjectID>) {
+        dispatchPrecondition(condition: .onQueue(queue))
+
+        let observers = mediaObservers.observersForMedia(withObjectID: mediaObjectID, originalPostIDs: originalPostIDs)
+        guard !observers.isEmpty else {
+            return
+        }
+        _observerMetrics.delivered += observers.count
+
+        DispatchQueue.main.async {
+            guard let media = self.mainContext.object(with: mediaObjectID) as? Media else {
+                return
+            }
+            for observer in observers {
+                observer.onUpdate(media, state)
+            }
         }
     }
 
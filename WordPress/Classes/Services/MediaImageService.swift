@@ -56,12 +56,15 @@ final class MediaImageService {
     /// are _not_ stored in the memory cache as they may take up too much space.
     /// They are stored in a custom `URLCache` instance that automatically evicts
     /// images if it reaches the size limit.
+    ///
+    /// - parameter priority: The priority of the thumbnail download when the
+    /// downloader is at capacity.
     @MainActor
-    func image(for media: Media, size: ImageSize) async throws -> UIImage {
+    func image(for media: Media, size: ImageSize, priority: ImageRequestPriority = .visible) async throws -> UIImage {
         let media = try await getSafeMedia(for: media)
         switch size {
         case .small, .large:
-            return try await thumbnail(for: media, size: size)
+            return try await thumbnail(for: media, size: size, priority: priority)
         case .original:
             return try await originalImage(for: media)
         }
@@ -119,7 +122,7 @@ final class MediaImageService {
         mediaType == .image || mediaType == .video
     }
 
-    private func thumbnail(for media: SafeMedia, size: ImageSize) async throws -> UIImage {
+    private func thumbnail(for media: SafeMedia, size: ImageSize, priority: ImageRequestPriority) async throws -> UIImage {
         guard MediaImageService.isThubmnailSupported(for: media.mediaType) else {
             assertionFailure("Unsupported thubmnail media type: \(media.mediaType)")
             throw Error.unsupportedMediaType(media.mediaType)
@@ -132,19 +135,19 @@ final class MediaImageService {
         if let image = cache.getImage(forKey: makeCacheKey(for: media.mediaID, size: size)) {
             return image
         }
-        let image = try await actuallyLoadThumbnail(for: media, size: size)
+        let image = try await actuallyLoadThumbnail(for: media, size: size, priority: priority)
         cache.setImage(image, forKey: makeCacheKey(for: media.mediaID, size: size))
         return image
     }
 
-    private func actuallyLoadThumbnail(for media: SafeMedia, size: ImageSize) async throws -> UIImage {
+    private func actuallyLoadThumbnail(for media: SafeMedia, size: ImageSize, priority: ImageRequestPriority) async throws -> UIImage {
         if let image = await cachedThumbnail(for: media.mediaID, size: size) {
             return image
         }
         if let image = await localThumbnail(for: media, size: size) {
             return image
         }
-        return try await remoteThumbnail(for: media, size: size)
+        return try await remoteThumbnail(for: media, size: size, priority: priority)
     }
 
     // MARK: - Thumbnails (Memory Cache)
@@ -238,7 +241,7 @@ final class MediaImageService {
     // MARK: - Remote Thumbnail
 
     /// Downloads a remote thumbnail and saves it in cache.
-    private func remoteThumbnail(for media: SafeMedia, size: ImageSize) async throws -> UIImage {
+    private func remoteThumbnail(for media: SafeMedia, size: ImageSize, priority: ImageRequestPriority) async throws -> UIImage {
         guard let info = await getRemoteThumbnailInfo(for: media, size: size) else {
             // Self-hosted WordPress sites don't have `remoteThumbnailURL`, so
             // the app generates the thumbnail by itself.
@@ -249,7 +252,7 @@ final class MediaImageService {
         }
         // The service has a custom disk cache for thumbnails, so it's important to
         // disable the native url cache which is by default set to `URLCache.shared`
-        let data = try await data(for: info, isCached: false)
+        let data = try await data(for: info, isCached: false, priority: priority)
         let image = try await ImageDecoder.makeImage(from: data)
         if let fileURL = getCachedThumbnailURL(for: media.mediaID, size: size) {
             try? data.write(to: fileURL)
@@ -271,11 +274,27 @@ final class MediaImageService {
 
     // MARK: - Networking
 
-    private func data(for info: RemoteImageInfo, isCached: Bool) async throws -> Data {
-        let options = ImageRequestOptions(isDiskCacheEnabled: isCached)
+    private func data(for info: RemoteImageInfo, isCached: Bool, priority: ImageRequestPriority = .visible) async throws -> Data {
+        let options = ImageRequestOptions(isDiskCacheEnabled: isCached, priority: priority)
         return try await downloader.data(from: info.imageURL, host: info.host, options: options)
     }
 
+    /// Changes the priority of a pending thumbnail download, e.g. when a
+    /// prefetched cell becomes visible.
+    @MainActor
+    func setPriority(_ priority: ImageRequestPriority, forThumbnailOf media: Media, size: ImageSize) {
+        guard media.remoteStatus != .stub, size != .original else {
+            return
+        }
+        let media = SafeMedia(media)
+        Task {
+            guard let info = await getRemoteThumbnailInfo(for: media, size: size) else {
+                return
+            }
+            await downloader.setPriority(priority, for: info.imageURL, host: info.host)
+        }
+    }
+
     private struct RemoteImageInfo {
         let imageURL: URL
         let host: MediaHost
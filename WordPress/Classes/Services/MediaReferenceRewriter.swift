@@ -0,0 +1,171 @@
+import Foundation
+import Aztec
+
+/// Replaces the local references to uploaded media in a post's content with
+/// their remote URLs and IDs.
+///
+/// All the media are rewritten together: the content is parsed once, every
+/// parsed block is visited once and dispatched to the processors of the media
+/// it refers to, and the Gutenberg delimiters and Aztec tags are each rewritten
+/// in a single pass, regardless of the number of media.
+///
+final class MediaReferenceRewriter {
+
+    /// Processors for the parsed Gutenberg blocks, by Gutenberg upload ID.
+    private var parsedBlockProcessors: [Int32: [GutenbergProcessor]] = [:]
+
+    /// Processors for the Gutenberg block delimiters.
+    private var blockProcessors: [GutenbergBlockProcessor] = []
+
+    /// Aztec `img` tag and `video` shortcode replacers, by upload ID.
+    private var imgReplacers: [String: HTMLProcessor.Replacer] = [:]
+    private var videoReplacers: [String: ShortcodeProcessor.Replacer] = [:]
+
+    init(media: Set<Media>) {
+        media.forEach(add)
+    }
+
+    var isEmpty: Bool {
+        return parsedBlockProcessors.isEmpty && blockProcessors.isEmpty && imgReplacers.isEmpty && videoReplacers.isEmpty
+    }
+
+    func rewrite(_ content: String) -> String {
+        var content = content
+
+        // Gutenberg processors need to run first because they are more specific/and target only content inside specific blocks
+        if !parsedBlockProcessors.isEmpty {
+            let contentParser = GutenbergContentParser(for: content)
+            for block in contentParser.blocks {
+                for uploadID in uploadIDs(referencedBy: block) {
+                    parsedBlockProcessors[uploadID]?.forEach { $0.process([block]) }
+                }
+            }
+            content = contentParser.html()
+        }
+        content = GutenbergBlockProcessor.process(content, with: blockProcessors)
+
+        // Aztec processors are next because they are more generic and only worried about HTML tags
+        if !imgReplacers.isEmpty {
+            let imgProcessor = HTMLProcessor(for: "img", replacer: { [imgReplacers] img in
+                guard let uploadValue = img.attributes[MediaAttachment.uploadKey]?.value,
+                      case let .string(uploadID) = uploadValue,
+                      let replacer = imgReplacers[uploadID] else {
+                    return nil
+                }
+                return replacer(img)
+            })
+            content = imgProcessor.process(content)
+        }
+        if !videoReplacers.isEmpty {
+            let videoProcessor = ShortcodeProcessor(tag: "video", replacer: { [videoReplacers] shortcode in
+                guard let uploadValue = shortcode.attributes[MediaAttachment.uploadKey]?.value,
+                      case let .string(uploadID) = uploadValue,
+                      let replacer = videoReplacers[uploadID] else {
+                    return nil
+                }
+                return replacer(shortcode)
+            })
+            content = videoProcessor.process(content)
+        }
+
+        return content
+    }
+
+    // MARK: - Private
+
+    private func add(_ media: Media) {
+        guard let mediaID = media.mediaID?.intValue,
+              let remoteURLStr = media.remoteURL,
+              media.remoteStatus != .failed else {
+            return
+        }
+        var imageURL = remoteURLStr
+
+        if let remoteLargeURL = media.remoteLargeURL {
+            imageURL = remoteLargeURL
+        } else if let remoteMediumURL = media.remoteMediumURL {
+            imageURL = remoteMediumURL
+        }
+
+        let mediaLink = media.link
+        let mediaUploadID = media.uploadID
+        let gutenbergMediaUploadID = media.gutenbergUploadID
+
+        var gutenbergBlockProcessors: [GutenbergProcessor] = []
+        var gutenbergProcessors: [GutenbergBlockProcessorGroup] = []
+
+        // File block can upload any kind of media.
+        let gutenbergFileProcessor = GutenbergFileUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, remoteURLString: remoteURLStr)
+        gutenbergBlockProcessors.append(gutenbergFileProcessor)
+
+        if media.mediaType == .image {
+            let gutenbergImgPostUploadProcessor = GutenbergImgUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, remoteURLString: imageURL)
+            gutenbergBlockProcessors.append(gutenbergImgPostUploadProcessor)
+
+            let gutenbergGalleryPostUploadProcessor = GutenbergGalleryUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, remoteURLString: imageURL, mediaLink: mediaLink)
+            gutenbergBlockProcessors.append(gutenbergGalleryPostUploadProcessor)
+
+            let imgPostUploadProcessor = ImgUploadProcessor(mediaUploadID: mediaUploadID, remoteURLString: remoteURLStr, width: media.width?.intValue, height: media.height?.intValue)
+            imgReplacers[mediaUploadID] = imgPostUploadProcessor.replacer
+
+            let gutenbergCoverPostUploadProcessor = GutenbergCoverUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, remoteURLString: remoteURLStr)
+            gutenbergProcessors.append(gutenbergCoverPostUploadProcessor)
+
+        } else if media.mediaType == .video {
+            let gutenbergVideoPostUploadProcessor = GutenbergVideoUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, remoteURLString: remoteURLStr)
+            gutenbergProcessors.append(gutenbergVideoPostUploadProcessor)
+
+            let gutenbergCoverPostUploadProcessor = GutenbergCoverUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, remoteURLString: remoteURLStr)
+            gutenbergProcessors.append(gutenbergCoverPostUploadProcessor)
+
+            let videoPostUploadProcessor = VideoUploadProcessor(mediaUploadID: mediaUploadID, remoteURLString: remoteURLStr, videoPressID: media.videopressGUID)
+            videoReplacers[mediaUploadID] = videoPostUploadProcessor.replacer
+
+            if let videoPressGUID = media.videopressGUID {
+                let gutenbergVideoPressUploadProcessor = GutenbergVideoPressUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, videoPressGUID: videoPressGUID)
+                gutenbergProcessors.append(gutenbergVideoPressUploadProcessor)
+            }
+
+        } else if media.mediaType == .audio {
+            let gutenbergAudioProcessor = GutenbergAudioUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, remoteURLString: remoteURLStr)
+            gutenbergProcessors.append(gutenbergAudioProcessor)
+        } else if let remoteURL = URL(string: remoteURLStr) {
+            let documentTitle = remoteURL.lastPathComponent
+            let documentUploadProcessor = DocumentUploadProcessor(mediaUploadID: mediaUploadID, remoteURLString: remoteURLStr, title: documentTitle)
+            imgReplacers[mediaUploadID] = documentUploadProcessor.replacer
+        }
+
+        parsedBlockProcessors[gutenbergMediaUploadID, default: []] += gutenbergBlockProcessors
+        blockProcessors += gutenbergProcessors.flatMap { $0.blockProcessors }
+    }
+
+    /// Returns the Gutenberg upload IDs of the media a parsed block refers to.
+    private func uploadIDs(referencedBy block: GutenbergParsedBlock) -> [Int32] {
+        switch block.name {
+        case BlockKeys.image, BlockKeys.file:
+            return (block.attributes[BlockKeys.id] as? Int).flatMap(Int32.init(exactly:)).map { [$0] } ?? []
+        case BlockKeys.mediaText:
+            return (block.attributes[BlockKeys.mediaID] as? Int).flatMap(Int32.init(exactly:)).map { [$0] } ?? []
+        case BlockKeys.gallery:
+            let ids = block.attributes[BlockKeys.ids] as? [Any] ?? []
+            return ids.compactMap { id in
+                if let id = id as? Int32 {
+                    return id
+                }
+                return (id as? String).flatMap { Int32($0) }
+            }
+        default:
+            return []
+        }
+    }
+
+    private enum BlockKeys {
+        static let image = "wp:image"
+        static let file = "wp:file"
+        static let mediaText = "wp:media-text"
+        static let gallery = "wp:gallery"
+        static let id = "id"
+        static let mediaID = "mediaId"
+        static let ids = "ids"
+    }
+}
@@ -0,0 +1,224 @@
+import Foundation
+
+/// Runs the media uploads with a bounded concurrency, so that adding a lot of media
+/// at once doesn't start all the uploads at the same time and starve each other.
+///
+/// The uploads are grouped by post, and the groups take turns, so a post with a lot of
+/// media doesn't hold back the uploads of the other posts. The uploads of the prioritized
+/// group, usually the post open in the editor, start first. Within a group, the smallest
+/// files start first, so that most media are available as soon as possible.
+///
+/// An upload can be delayed, which is used to back off the automated retries of failed uploads.
+///
+final class MediaUploadScheduler {
+    typealias Upload = (_ completion: @escaping (_ bytes: Int64, _ succeeded: Bool) -> Void) -> Void
+
+    struct Metrics: CustomStringConvertible {
+        var uploads = 0
+        var failures = 0
+        /// The uploads cancelled while waiting to start.
+        var cancellations = 0
+        /// The number of bytes of the uploads that succeeded.
+        var bytes: Int64 = 0
+        /// The time spent uploading, whether uploads ran concurrently or not.
+        var activeDuration: TimeInterval = 0
+        /// The time spent waiting for a slot, excluding the retry delays.
+        var waitDuration: TimeInterval = 0
+        var longestWait: TimeInterval = 0
+        var queueDepth = 0
+        var maxQueueDepth = 0
+
+        /// The number of bytes uploaded per second while uploads were running.
+        var throughput: Double {
+            activeDuration > 0 ? Double(bytes) / activeDuration : 0
+        }
+
+        var description: String {
+            let throughput = ByteCountFormatter.string(fromByteCount: Int64(throughput), countStyle: .binary)
+            let wait = String(format: "%.0f", waitDuration * 1000)
+            let longestWait = String(format: "%.0f", longestWait * 1000)
+            return "uploads: \(uploads), failures: \(failures), cancellations: \(cancellations), throughput: \(throughput)/s, wait: \(wait) ms (max \(longestWait) ms), queue: \(queueDepth) (max \(maxQueueDepth))"
+        }
+    }
+
+    let maxConcurrentUploads: Int
+
+    private let queue = DispatchQueue(label: "org.wordpress.MediaUploadScheduler")
+    private let workQueue: DispatchQueue
+
+    // The properties below are only accessed on `queue`.
+    private var groups: [AnyHashable: [ScheduledUpload]] = [:]
+    /// The order in which the groups take turns.
+    private var groupOrder: [AnyHashable] = []
+    private var _prioritizedGroup: AnyHashable?
+    private var runningCount = 0
+    private var activeSince: CFAbsoluteTime?
+    private var wakeUpTime: CFAbsoluteTime?
+    private var _metrics = Metrics()
+
+    /// - Parameters:
+    ///   - maxConcurrentUploads: The maximum number of uploads running at the same time.
+    ///   - workQueue: The queue on which the uploads start. The main queue by default, since the uploads
+    ///         use the media of the main context.
+    init(maxConcurrentUploads: Int = 4, workQueue: DispatchQueue = .main) {
+        precondition(maxConcurrentUploads > 0)
+        self.maxConcurrentUploads = maxConcurrentUploads
+        self.workQueue = workQueue
+    }
+
+    var metrics: Metrics {
+        queue.sync { _metrics }
+    }
+
+    /// The group whose uploads start before the other ones.
+    var prioritizedGroup: AnyHashable? {
+        get { queue.sync { _prioritizedGroup } }
+        set { queue.async { self._prioritizedGroup = newValue } }
+    }
+
+    /// Schedules an upload.
+    ///
+    /// - Parameters:
+    ///   - group: The group of the upload, e.g. the post it belongs to.
+    ///   - size: The size of the file in bytes, used to start the small files first.
+    ///   - delay: The minimum time to wait before starting the upload.
+    ///   - isCancelled: Returns `true` if the upload was cancelled while waiting, in which case it isn't started.
+    ///   - upload: Starts the upload. It must call its completion block once the upload has finished.
+    func enqueue(group: AnyHashable, size: Int64, delay: TimeInterval = 0, isCancelled: @escaping () -> Bool = { false }, upload: @escaping Upload) {
+        let now = CFAbsoluteTimeGetCurrent()
+        let scheduled = ScheduledUpload(size: size, notBefore: now + delay, isCancelled: isCancelled, upload: upload)
+        queue.async {
+            if self.groups[group] == nil {
+                self.groupOrder.append(group)
+            }
+            self.groups[group, default: []].append(scheduled)
+            self._metrics.queueDepth += 1
+            self._metrics.maxQueueDepth = max(self._metrics.maxQueueDepth, self._metrics.queueDepth)
+            self.startReadyUploads()
+        }
+    }
+
+    // MARK: - Private
+
+    private func startReadyUploads() {
+        dispatchPrecondition(condition: .onQueue(queue))
+
+        let now = CFAbsoluteTimeGetCurrent()
+        while runningCount < maxConcurrentUploads, let scheduled = dequeueNextUpload(now: now) {
+            start(scheduled, now: now)
+        }
+        scheduleWakeUpIfNeeded(now: now)
+    }
+
+    /// Returns the smallest ready upload of the prioritized group, or else of the next group in turn.
+    private func dequeueNextUpload(now: CFAbsoluteTime) -> ScheduledUpload? {
+        var candidates = groupOrder
+        if let prioritizedGroup = _prioritizedGroup, let index = candidates.firstIndex(of: prioritizedGroup) {
+            candidates.remove(at: index)
+            candidates.insert(prioritizedGroup, at: 0)
+        }
+
+        for group in candidates {
+            guard let uploads = groups[group],
+                  let index = uploads.indices.filter({ uploads[$0].notBefore <= now }).min(by: { uploads[$0].size < uploads[$1].size }) else {
+                continue
+            }
+            let scheduled = groups[group]!.remove(at: index)
+            if groups[group]!.isEmpty {
+                groups[group] = nil
+                groupOrder.removeAll { $0 == group }
+            } else if let position = groupOrder.firstIndex(of: group) {
+                // Move the group to the end of the line.
+                groupOrder.remove(at: position)
+                groupOrder.append(group)
+            }
+            _metrics.queueDepth -= 1
+            return scheduled
+        }
+        return nil
+    }
+
+    private func start(_ scheduled: ScheduledUpload, now: CFAbsoluteTime) {
+        let wait = now - max(scheduled.enqueueTime, scheduled.notBefore)
+        _metrics.waitDuration += wait
+        _metrics.longestWait = max(_metrics.longestWait, wait)
+
+        runningCount += 1
+        if activeSince == nil {
+            activeSince = now
+        }
+
+        let upload = scheduled.upload
+        let isCancelled = scheduled.isCancelled
+        workQueue.async {
+            guard !isCancelled() else {
+                self.queue.async {
+                    self.finish(bytes: 0, succeeded: false, cancelled: true)
+                }
+                return
+            }
+            upload { bytes, succeeded in
+                self.queue.async {
+                    self.finish(bytes: bytes, succeeded: succeeded, cancelled: false)
+                }
+            }
+        }
+    }
+
+    private func finish(bytes: Int64, succeeded: Bool, cancelled: Bool) {
+        dispatchPrecondition(condition: .onQueue(queue))
+
+        runningCount -= 1
+        if cancelled {
+            _metrics.cancellations += 1
+        } else {
+            _metrics.uploads += 1
+            if succeeded {
+                _metrics.bytes += bytes
+            } else {
+                _metrics.failures += 1
+            }
+        }
+        if runningCount == 0, let activeSince {
+            _metrics.activeDuration += CFAbsoluteTimeGetCurrent() - activeSince
+            self.activeSince = nil
+        }
+        if groupOrder.isEmpty && runningCount == 0 {
+            DDLogDebug("MediaUploadScheduler: \(_metrics)")
+        }
+
+        startReadyUploads()
+    }
+
+    /// Starts the delayed uploads once they are ready, if there are free slots.
+    private func scheduleWakeUpIfNeeded(now: CFAbsoluteTime) {
+        guard runningCount < maxConcurrentUploads,
+              let nextTime = groups.values.joined().map(\.notBefore).min(),
+              nextTime > now,
+              wakeUpTime.map({ nextTime < $0 }) ?? true else {
+            return
+        }
+        wakeUpTime = nextTime
+        queue.asyncAfter(deadline: .now() + (nextTime - now)) {
+            if self.wakeUpTime == nextTime {
+                self.wakeUpTime = nil
+            }
+            self.startReadyUploads()
+        }
+    }
+}
+
+private final class ScheduledUpload {
+    let size: Int64
+    let enqueueTime = CFAbsoluteTimeGetCurrent()
+    let notBefore: CFAbsoluteTime
+    let isCancelled: () -> Bool
+    let upload: MediaUploadScheduler.Upload
+
+    init(size: Int64, notBefore: CFAbsoluteTime, isCancelled: @escaping () -> Bool, upload: @escaping MediaUploadScheduler.Upload) {
+        self.size = size
+        self.notBefore = notBefore
+        self.isCancelled = isCancelled
+        self.upload = upload
+    }
+}
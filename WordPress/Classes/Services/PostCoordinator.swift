@@ -648,9 +648,11 @@ class PostCoordinator: NSObject {
         guard let postContent = post.content else {
             return
         }
-        let contentParser = GutenbergContentParser(for: postContent)
-        media.forEach { self.updateReferences(to: $0, in: contentParser.blocks, post: post) }
-        post.content = contentParser.html()
+        let rewriter = MediaReferenceRewriter(media: media)
+        guard !rewriter.isEmpty else {
+            return
+        }
+        post.content = rewriter.rewrite(postContent)
     }
 
     func isUploading(post: AbstractPost) -> Bool {
@@ -765,86 +767,6 @@ class PostCoordinator: NSObject {
         }, forMediaFor: post)
     }
 
-    private func updateReferences(to media: Media, in contentBlocks: [GutenbergParsedBlock], post: AbstractPost) {
-        guard var postContent = post.content,
-            let mediaID = media.mediaID?.intValue,
-            let remoteURLStr = media.remoteURL else {
-            return
-        }
-        var imageURL = remoteURLStr
-
-        if let remoteLargeURL = media.remoteLargeURL {
-            imageURL = remoteLargeURL
-        } else if let remoteMediumURL = media.remoteMediumURL {
-            imageURL = remoteMediumURL
-        }
-
-        let mediaLink = media.link
-        let mediaUploadID = media.uploadID
-        let gutenbergMediaUploadID = media.gutenbergUploadID
-        if media.remoteStatus == .failed {
-            return
-        }
-
-        var gutenbergBlockProcessors: [GutenbergProcessor] = []
-        var gutenbergProcessors: [Processor] = []
-        var aztecProcessors: [Processor] = []
-
-        // File block can upload any kind of media.
-        let gutenbergFileProcessor = GutenbergFileUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, remoteURLString: remoteURLStr)
-        gutenbergBlockProcessors.append(gutenbergFileProcessor)
-
-        if media.mediaType == .image {
-            let gutenbergImgPostUploadProcessor = GutenbergImgUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, remoteURLString: imageURL)
-            gutenbergBlockProcessors.append(gutenbergImgPostUploadProcessor)
-
-            let gutenbergGalleryPostUploadProcessor = GutenbergGalleryUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, remoteURLString: imageURL, mediaLink: mediaLink)
-            gutenbergBlockProcessors.append(gutenbergGalleryPostUploadProcessor)
-
-            let imgPostUploadProcessor = ImgUploadProcessor(mediaUploadID: mediaUploadID, remoteURLString: remoteURLStr, width: media.width?.intValue, height: media.height?.intValue)
-            aztecProcessors.append(imgPostUploadProcessor)
-
-            let gutenbergCoverPostUploadProcessor = GutenbergCoverUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, remoteURLString: remoteURLStr)
-            gutenbergProcessors.append(gutenbergCoverPostUploadProcessor)
-
-        } else if media.mediaType == .video {
-            let gutenbergVideoPostUploadProcessor = GutenbergVideoUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, remoteURLString: remoteURLStr)
-            gutenbergProcessors.append(gutenbergVideoPostUploadProcessor)
-
-            let gutenbergCoverPostUploadProcessor = GutenbergCoverUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, remoteURLString: remoteURLStr)
-            gutenbergProcessors.append(gutenbergCoverPostUploadProcessor)
-
-            let videoPostUploadProcessor = VideoUploadProcessor(mediaUploadID: mediaUploadID, remoteURLString: remoteURLStr, videoPressID: media.videopressGUID)
-            aztecProcessors.append(videoPostUploadProcessor)
-
-            if let videoPressGUID = media.videopressGUID {
-                let gutenbergVideoPressUploadProcessor = GutenbergVideoPressUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, videoPressGUID: videoPressGUID)
-                gutenbergProcessors.append(gutenbergVideoPressUploadProcessor)
-            }
-
-        } else if media.mediaType == .audio {
-            let gutenbergAudioProcessor = GutenbergAudioUploadProcessor(mediaUploadID: gutenbergMediaUploadID, serverMediaID: mediaID, remoteURLString: remoteURLStr)
-            gutenbergProcessors.append(gutenbergAudioProcessor)
-        } else if let remoteURL = URL(string: remoteURLStr) {
-            let documentTitle = remoteURL.lastPathComponent
-            let documentUploadProcessor = DocumentUploadProcessor(mediaUploadID: mediaUploadID, remoteURLString: remoteURLStr, title: documentTitle)
-            aztecProcessors.append(documentUploadProcessor)
-        }
-
-        // Gutenberg processors need to run first because they are more specific/and target only content inside specific blocks
-        gutenbergBlockProcessors.forEach { $0.process(contentBlocks) }
-        postContent = gutenbergProcessors.reduce(postContent) { (content, processor) -> String in
-            return processor.process(content)
-        }
-
-        // Aztec processors are next because they are more generic and only worried about HTML tags
-        postContent = aztecProcessors.reduce(postContent) { (content, processor) -> String in
-            return processor.process(content)
-        }
-
-        post.content = postContent
-    }
-
     private func trackObserver(receipt: UUID, for post: AbstractPost) {
         queue.sync {
             observerUUIDs[post] = receipt
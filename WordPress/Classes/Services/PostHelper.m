@@ -12,6 +12,12 @@
 }
 
 + (void)updatePost:(AbstractPost *)post withRemotePost:(RemotePost *)remotePost inContext:(NSManagedObjectContext *)managedObjectContext overwrite:(BOOL)overwrite {
+    [self updatePost:post withRemotePost:remotePost inContext:managedObjectContext overwrite:overwrite index:nil];
+}
+
+/// When an `index` is given, every lookup goes through it instead of hitting the
+/// blog's relationships or the context.
++ (void)updatePost:(AbstractPost *)post withRemotePost:(RemotePost *)remotePost inContext:(NSManagedObjectContext *)managedObjectContext overwrite:(BOOL)overwrite index:(PostMergeIndex *)index {
     if ((post.revision != nil && !overwrite)) {
         return;
     }
@@ -19,7 +25,7 @@
     NSNumber *previousPostID = post.postID;
     post.postID = remotePost.postID;
     // Used to populate author information for self-hosted sites.
-    BlogAuthor *author = [post.blog getAuthorWithId:remotePost.authorID];
+    BlogAuthor *author = index ? [index authorWithID:remotePost.authorID] : [post.blog getAuthorWithId:remotePost.authorID];
 
     post.author = remotePost.authorDisplayName ?: author.displayName;
     post.authorID = remotePost.authorID;
@@ -32,7 +38,11 @@
     post.password = remotePost.password;
 
     if (remotePost.postThumbnailID != nil) {
-        post.featuredImage = [Media existingOrStubMediaWithMediaID: remotePost.postThumbnailID inBlog:post.blog];
+        if (index) {
+            post.featuredImage = [index existingOrStubMediaWithID:remotePost.postThumbnailID];
+        } else {
+            post.featuredImage = [Media existingOrStubMediaWithMediaID: remotePost.postThumbnailID inBlog:post.blog];
+        }
     } else {
         post.featuredImage = nil;
     }
@@ -51,7 +61,11 @@
     }
 
     if (remotePost.postID != previousPostID) {
-        [self updateCommentsForPost:post];
+        if (index) {
+            [[post mutableSetValueForKey:@"comments"] addObjectsFromArray:[index commentsForPostID:post.postID]];
+        } else {
+            [self updateCommentsForPost:post];
+        }
     }
 
     post.autosaveTitle = remotePost.autosave.title;
@@ -72,7 +86,7 @@
         postPost.tags = [remotePost.tags componentsJoinedByString:@","];
         postPost.postType = remotePost.type;
         postPost.isStickyPost = (remotePost.isStickyPost != nil) ? remotePost.isStickyPost.boolValue : NO;
-        [self updatePost:postPost withRemoteCategories:remotePost.categories inContext:managedObjectContext];
+        [self updatePost:postPost withRemoteCategories:remotePost.categories inContext:managedObjectContext index:index];
 
         NSString *publicID = nil;
         NSString *publicizeMessage = nil;
@@ -101,11 +115,11 @@
     }
 }
 
-+ (void)updatePost:(Post *)post withRemoteCategories:(NSArray *)remoteCategories inContext:(NSManagedObjectContext *)managedObjectContext {
++ (void)updatePost:(Post *)post withRemoteCategories:(NSArray *)remoteCategories inContext:(NSManagedObjectContext *)managedObjectContext index:(PostMergeIndex *)index {
     NSMutableSet *categories = [post mutableSetValueForKey:@"categories"];
     [categories removeAllObjects];
     for (RemotePostCategory *remoteCategory in remoteCategories) {
-        PostCategory *category = [PostHelper createOrUpdateCategoryForRemoteCategory:remoteCategory blog:post.blog context:managedObjectContext];
+        PostCategory *category = index ? [index categoryFor:remoteCategory] : [PostHelper createOrUpdateCategoryForRemoteCategory:remoteCategory blog:post.blog context:managedObjectContext];
         if (category) {
             [categories addObject:category];
         }
@@ -174,14 +188,15 @@
           purgeExisting:(BOOL)purge
               inContext:(NSManagedObjectContext *)context
 {
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    PostMergeIndex *index = [[PostMergeIndex alloc] initWithBlog:blog remotePosts:remotePosts context:context];
+    CFAbsoluteTime prefetchEnd = CFAbsoluteTimeGetCurrent();
+
     NSMutableArray *posts = [NSMutableArray arrayWithCapacity:remotePosts.count];
     for (RemotePost *remotePost in remotePosts) {
-        AbstractPost *post = [blog lookupPostWithID:remotePost.postID inContext:context];
+        AbstractPost *post = [index postWithID:remotePost.postID];
         if (post == nil) {
-            NSUUID *foreignID = remotePost.foreignID;
-            if (foreignID != nil) {
-                post = [blog lookupPostWithForeignID:foreignID inContext:context];
-            }
+            post = [index postWithForeignID:remotePost.foreignID];
         }
         if (!post) {
             if ([remotePost.type isEqualToString:PostServiceTypePage]) {
@@ -192,9 +207,11 @@
                 post = [blog createPost];
             }
         }
-        [PostHelper updatePost:post withRemotePost:remotePost inContext:context];
+        [PostHelper updatePost:post withRemotePost:remotePost inContext:context overwrite:NO index:index];
+        [index add:post];
         [posts addObject:post];
     }
+    CFAbsoluteTime updateEnd = CFAbsoluteTimeGetCurrent();
 
     if (purge) {
         // Set up predicate for fetching any posts that could be purged for the sync.
@@ -240,6 +257,9 @@
         }
     }
 
+    CFAbsoluteTime end = CFAbsoluteTimeGetCurrent();
+    DDLogInfo(@"Merged %lu posts (prefetch: %.3fs, update: %.3fs, purge: %.3fs)", (unsigned long)posts.count, prefetchEnd - start, updateEnd - prefetchEnd, end - updateEnd);
+
     return posts;
 }
 
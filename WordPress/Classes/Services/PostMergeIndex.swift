@@ -0,0 +1,147 @@
+import Foundation
+import CoreData
+import WordPressKit
+
+/// Resolves everything `PostHelper` needs while merging a page of remote posts
+/// – existing posts, authors, featured media, categories and comments – with a
+/// constant number of fetches, instead of a lookup per post.
+///
+/// Objects created during the merge must be recorded back with `add(_:)` so that
+/// later remote posts referring to them find the same instance.
+@objc final class PostMergeIndex: NSObject {
+    private let blog: Blog
+    private let context: NSManagedObjectContext
+
+    private var postsByID: [Int64: AbstractPost] = [:]
+    private var postsByForeignID: [UUID: AbstractPost] = [:]
+    private var authorsByID: [NSNumber: BlogAuthor] = [:]
+    private var mediaByID: [NSNumber: Media] = [:]
+    private var categoriesByID: [NSNumber: PostCategory] = [:]
+    private var commentsByPostID: [Int64: [Comment]] = [:]
+
+    @objc init(blog: Blog, remotePosts: [RemotePost], context: NSManagedObjectContext) {
+        self.blog = blog
+        self.context = context
+        super.init()
+
+        prefetchPosts(for: remotePosts)
+        prefetchMedia(for: remotePosts)
+        prefetchComments(for: remotePosts)
+
+        for author in blog.authors ?? [] where authorsByID[author.userID] == nil {
+            authorsByID[author.userID] = author
+        }
+        for case let category as PostCategory in blog.categories ?? [] where categoriesByID[category.categoryID] == nil {
+            categoriesByID[category.categoryID] = category
+        }
+    }
+
+    // MARK: - Lookups
+
+    @objc func post(withID postID: NSNumber?) -> AbstractPost? {
+        postID.flatMap { postsByID[$0.int64Value] }
+    }
+
+    @objc func post(withForeignID foreignID: UUID?) -> AbstractPost? {
+        foreignID.flatMap { postsByForeignID[$0] }
+    }
+
+    @objc func author(withID userID: NSNumber?) -> BlogAuthor? {
+        userID.flatMap { authorsByID[$0] }
+    }
+
+    /// Equivalent to `Media.existingOrStubMediaWith(mediaID:inBlog:)`.
+    @objc func existingOrStubMedia(withID mediaID: NSNumber) -> Media {
+        if let media = mediaByID[mediaID] {
+            return media
+        }
+        let media = Media.makeMedia(blog: blog)
+        media.mediaID = mediaID
+        media.remoteStatus = .stub
+        mediaByID[mediaID] = media
+        return media
+    }
+
+    /// Equivalent to `PostHelper.createOrUpdateCategory(for:in:in:)`.
+    @objc func category(for remoteCategory: RemotePostCategory) -> PostCategory? {
+        if let categoryID = remoteCategory.categoryID, let category = categoriesByID[categoryID] {
+            return category
+        }
+        let category = PostHelper.createOrUpdateCategory(for: remoteCategory, in: blog, in: context)
+        if let category {
+            categoriesByID[category.categoryID] = category
+        }
+        return category
+    }
+
+    @objc func comments(forPostID postID: NSNumber?) -> [Comment] {
+        postID.flatMap { commentsByPostID[$0.int64Value] } ?? []
+    }
+
+    /// Records a post that was created or updated during the merge.
+    @objc func add(_ post: AbstractPost) {
+        if let postID = post.postID, postsByID[postID.int64Value] == nil {
+            postsByID[postID.int64Value] = post
+        }
+        if let foreignID = post.foreignID, postsByForeignID[foreignID] == nil {
+            postsByForeignID[foreignID] = post
+        }
+    }
+
+    // MARK: - Prefetching
+
+    private func prefetchPosts(for remotePosts: [RemotePost]) {
+        let postIDs = remotePosts.compactMap(\.postID)
+        let foreignIDs = remotePosts.compactMap { $0.foreignID as NSUUID? }
+
+        let request = NSFetchRequest<AbstractPost>(entityName: NSStringFromClass(AbstractPost.self))
+        request.predicate = NSPredicate(format: "blog = %@ AND original = NULL AND (postID IN %@ OR \(#keyPath(AbstractPost.foreignID)) IN %@)", blog, postIDs, foreignIDs)
+        request.returnsObjectsAsFaults = false
+
+        do {
+            for post in try context.fetch(request) {
+                add(post)
+            }
+        } catch {
+            DDLogError("Error prefetching posts to merge: \(error)")
+        }
+    }
+
+    private func prefetchMedia(for remotePosts: [RemotePost]) {
+        let mediaIDs = remotePosts.compactMap(\.postThumbnailID)
+        guard !mediaIDs.isEmpty else {
+            return
+        }
+
+        let request = NSFetchRequest<Media>(entityName: NSStringFromClass(Media.self))
+        request.predicate = NSPredicate(format: "blog = %@ AND mediaID IN %@", blog, mediaIDs)
+
+        do {
+            for media in try context.fetch(request) {
+                if let mediaID = media.mediaID, mediaByID[mediaID] == nil {
+                    mediaByID[mediaID] = media
+                }
+            }
+        } catch {
+            DDLogError("Error prefetching featured media to merge: \(error)")
+        }
+    }
+
+    private func prefetchComments(for remotePosts: [RemotePost]) {
+        let postIDs = remotePosts.compactMap(\.postID)
+        guard !postIDs.isEmpty else {
+            return
+        }
+
+        let request = NSFetchRequest<Comment>(entityName: Comment.entityName())
+        request.predicate = NSPredicate(format: "blog = %@ AND postID IN %@", blog, postIDs)
+
+        do {
+            for comment in try context.fetch(request) {
+                commentsByPostID[Int64(comment.postID), default: []].append(comment)
+            }
+        } catch {
+            DDLogError("Error prefetching comments to merge: \(error)")
+        }
+    }
+}
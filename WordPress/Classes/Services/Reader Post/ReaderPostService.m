@@ -527,17 +527,14 @@ static NSString * const ReaderPostGlobalIDKey = @"globalID";
 - (void)clearSavedPostFlags
 {
     [self.coreDataStack performAndSaveUsingBlock:^(NSManagedObjectContext *context) {
-        NSError *error;
-        NSFetchRequest *request = [[NSFetchRequest alloc] initWithEntityName:@"ReaderPost"];
+        NSBatchUpdateRequest *request = [[NSBatchUpdateRequest alloc] initWithEntityName:@"ReaderPost"];
         request.predicate = [NSPredicate predicateWithFormat:@"isSavedForLater = true"];
-        NSArray *results = [context executeFetchRequest:request error:&error];
+        request.propertiesToUpdate = @{ @"isSavedForLater": @NO };
+
+        NSError *error;
+        [self.coreDataStack executeBatchRequest:request inContext:context error:&error];
         if (error) {
             DDLogError(@"%@, unsaving saved posts: %@", NSStringFromSelector(_cmd), error);
-            return;
-        }
-
-        for (ReaderPost *post in results) {
-            post.isSavedForLater = NO;
         }
     }];
 }
@@ -545,17 +542,14 @@ static NSString * const ReaderPostGlobalIDKey = @"globalID";
 - (void)clearInUseFlags
 {
     [self.coreDataStack performAndSaveUsingBlock:^(NSManagedObjectContext *context) {
-        NSError *error;
-        NSFetchRequest *request = [[NSFetchRequest alloc] initWithEntityName:@"ReaderPost"];
+        NSBatchUpdateRequest *request = [[NSBatchUpdateRequest alloc] initWithEntityName:@"ReaderPost"];
         request.predicate = [NSPredicate predicateWithFormat:@"inUse = true"];
-        NSArray *results = [context executeFetchRequest:request error:&error];
+        request.propertiesToUpdate = @{ @"inUse": @NO };
+
+        NSError *error;
+        [self.coreDataStack executeBatchRequest:request inContext:context error:&error];
         if (error) {
             DDLogError(@"%@, marking posts not in use.: %@", NSStringFromSelector(_cmd), error);
-            return;
-        }
-
-        for (ReaderPost *post in results) {
-            post.inUse = NO;
         }
     }];
 }
@@ -568,21 +562,15 @@ static NSString * const ReaderPostGlobalIDKey = @"globalID";
 - (void)setFollowing:(BOOL)following forPostsFromSiteWithID:(NSNumber *)siteID andURL:(NSString *)siteURL completion:(void (^)(void))completion
 {
     [self.coreDataStack performAndSaveUsingBlock:^(NSManagedObjectContext *context) {
-        // Fetch all the posts for the specified site ID and update its following status
+        // Update the following status of all the posts for the specified site ID
+        NSBatchUpdateRequest *request = [[NSBatchUpdateRequest alloc] initWithEntityName:@"ReaderPost"];
+        request.predicate = [NSPredicate predicateWithFormat:@"siteID = %@ AND blogURL = %@ AND isFollowing != %@", siteID, siteURL, @(following)];
+        request.propertiesToUpdate = @{ @"isFollowing": @(following) };
+
         NSError *error;
-        NSFetchRequest *request = [[NSFetchRequest alloc] initWithEntityName:@"ReaderPost"];
-        request.predicate = [NSPredicate predicateWithFormat:@"siteID = %@ AND blogURL = %@", siteID, siteURL];
-        NSArray *results = [context executeFetchRequest:request error:&error];
+        [self.coreDataStack executeBatchRequest:request inContext:context error:&error];
         if (error) {
             DDLogError(@"%@, error (un)following posts with siteID %@ and URL @%: %@", NSStringFromSelector(_cmd), siteID, siteURL, error);
-            return;
-        }
-        if ([results count] == 0) {
-            return;
-        }
-
-        for (ReaderPost *post in results) {
-            post.isFollowing = following;
         }
     } completion:completion onQueue:dispatch_get_main_queue()];
 }
@@ -935,30 +923,9 @@ static NSString * const ReaderPostGlobalIDKey = @"globalID";
 - (void)deletePostsRankedLessThan:(NSNumber *)rank forTopic:(ReaderAbstractTopic *)topic inContext:(NSManagedObjectContext *)context
 {
     // Don't trust the relationships on the topic to be current or correct.
-    NSError *error;
-    NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] initWithEntityName:@"ReaderPost"];
-
     NSPredicate *pred = [NSPredicate predicateWithFormat:@"topic = %@ AND sortRank < %@", topic, rank];
-    [fetchRequest setPredicate:pred];
-
-    NSSortDescriptor *sortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"sortRank" ascending:NO];
-    [fetchRequest setSortDescriptors:@[sortDescriptor]];
-
-    NSArray *currentPosts = [context executeFetchRequest:fetchRequest error:&error];
-    if (error) {
-        DDLogError(@"%@ error fetching posts: %@", NSStringFromSelector(_cmd), error);
-        return;
-    }
-
-    for (ReaderPost *post in currentPosts) {
-        if (post.isSavedForLater) {
-            // If the missing post is currently being used or has been saved, just remove its topic.
-            post.topic = nil;
-        } else {
-            DDLogInfo(@"Deleting ReaderPost: %@", post);
-            [context deleteObject:post];
-        }
-    }
+    NSArray *objectIDs = [self objectIDsOfPostsMatchingPredicate:pred fromOffset:0 inContext:context];
+    [self purgePostsWithObjectIDs:objectIDs inContext:context];
 }
 
 /**
@@ -980,38 +947,22 @@ static NSString * const ReaderPostGlobalIDKey = @"globalID";
                   inContext:(NSManagedObjectContext *)context
 {
     // Don't trust the relationships on the topic to be current or correct.
-    NSError *error;
-    NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] initWithEntityName:@"ReaderPost"];
-
     NSNumber *highestRank = startingRank;
-
     NSNumber *lowestRank = ((ReaderPost *)[posts lastObject]).sortRank;
-    NSPredicate *pred = [NSPredicate predicateWithFormat:@"topic == %@ AND sortRank > %@ AND sortRank < %@", topic, lowestRank, highestRank];
-
-    [fetchRequest setPredicate:pred];
-
-    NSSortDescriptor *sortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"sortRank" ascending:NO];
-    [fetchRequest setSortDescriptors:@[sortDescriptor]];
-
-    NSArray *currentPosts = [context executeFetchRequest:fetchRequest error:&error];
-    if (error) {
-        DDLogError(@"%@ error fetching posts: %@", NSStringFromSelector(_cmd), error);
-        return;
-    }
 
-    for (ReaderPost *post in currentPosts) {
-        if ([posts containsObject:post]) {
-            continue;
-        }
-        // The post was missing from the batch and needs to be cleaned up.
-        if ([self topicShouldBeClearedFor:post]) {
-            // If the missing post is currently being used or has been saved, just remove its topic.
-            post.topic = nil;
-        } else {
-            DDLogInfo(@"Deleting ReaderPost: %@", post);
-            [context deleteObject:post];
+    // Posts from the batch are matched by global ID, so the filtering is done by the store.
+    // Gap markers don't have one, and are never part of a batch.
+    NSMutableSet *globalIDs = [NSMutableSet setWithCapacity:[posts count]];
+    for (ReaderPost *post in posts) {
+        if (post.globalID) {
+            [globalIDs addObject:post.globalID];
         }
     }
+    NSPredicate *pred = [NSPredicate predicateWithFormat:@"topic == %@ AND sortRank > %@ AND sortRank < %@ AND (%K == nil OR NOT (%K IN %@))",
+                         topic, lowestRank, highestRank, ReaderPostGlobalIDKey, ReaderPostGlobalIDKey, globalIDs];
+
+    NSArray *objectIDs = [self objectIDsOfPostsMatchingPredicate:pred fromOffset:0 inContext:context];
+    [self purgePostsWithObjectIDs:objectIDs inContext:context];
 }
 
 /**
@@ -1037,40 +988,26 @@ static NSString * const ReaderPostGlobalIDKey = @"globalID";
     NSPredicate *pred = [NSPredicate predicateWithFormat:@"topic = %@", topic];
     [fetchRequest setPredicate:pred];
 
-    NSSortDescriptor *sortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"sortRank" ascending:NO];
-    [fetchRequest setSortDescriptors:@[sortDescriptor]];
-
     NSUInteger maxPosts = [self maxPostsToSaveForTopic:topic];
-
-    // Specifying a fetchOffset to just get the posts in range doesn't seem to work very well.
-    // Just perform the fetch and remove the excess.
     NSUInteger count = [context countForFetchRequest:fetchRequest error:&error];
-    if (count <= maxPosts) {
+    if (error || count <= maxPosts) {
         return;
     }
 
-    NSArray *posts = [context executeFetchRequest:fetchRequest error:&error];
-    if (error) {
-        DDLogError(@"%@ error fetching posts: %@", NSStringFromSelector(_cmd), error);
+    // Include the last post that is kept, to check whether it is a gap marker.
+    NSMutableArray *objectIDs = [[self objectIDsOfPostsMatchingPredicate:pred fromOffset:maxPosts - 1 inContext:context] mutableCopy];
+    if ([objectIDs count] == 0) {
         return;
     }
+    NSManagedObjectID *lastObjectID = [objectIDs firstObject];
+    [objectIDs removeObjectAtIndex:0];
 
-    NSRange range = NSMakeRange(maxPosts, [posts count] - maxPosts);
-    NSArray *postsToDelete = [posts subarrayWithRange:range];
-    for (ReaderPost *post in postsToDelete) {
-        if ([self topicShouldBeClearedFor:post]) {
-            post.topic = nil;
-        } else {
-            DDLogInfo(@"Deleting ReaderPost: %@", post.postTitle);
-            [context deleteObject:post];
-        }
-    }
+    [self purgePostsWithObjectIDs:objectIDs inContext:context];
 
     // If the last remaining post is a gap marker, remove it.
-    ReaderPost *lastPost = [posts objectAtIndex:maxPosts - 1];
-    if ([lastPost isKindOfClass:[ReaderGapMarker class]]) {
-        DDLogInfo(@"Deleting Last GapMarker: %@", lastPost);
-        [context deleteObject:lastPost];
+    if ([lastObjectID.entity.name isEqualToString:NSStringFromClass([ReaderGapMarker class])]) {
+        DDLogInfo(@"Deleting Last GapMarker: %@", lastObjectID);
+        [context deleteObject:[context objectWithID:lastObjectID]];
     }
 }
 
@@ -1117,12 +1054,122 @@ static NSString * const ReaderPostGlobalIDKey = @"globalID";
     return (post.inUse || post.isSavedForLater);
 }
 
+#pragma mark Pruning
+
+/**
+ Returns the object IDs of the posts matching the predicate, from the highest ranked,
+ skipping the first `offset` posts. Posts aren't materialized.
+
+ Core Data doesn't apply a fetch offset reliably when the context has unsaved changes,
+ so in that case the offset is applied to the fetched object IDs instead.
+ */
+- (NSArray<NSManagedObjectID *> *)objectIDsOfPostsMatchingPredicate:(NSPredicate *)predicate
+                                                         fromOffset:(NSUInteger)offset
+                                                          inContext:(NSManagedObjectContext *)context
+{
+    NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] initWithEntityName:@"ReaderPost"];
+    fetchRequest.predicate = predicate;
+    fetchRequest.sortDescriptors = @[[NSSortDescriptor sortDescriptorWithKey:@"sortRank" ascending:NO]];
+    fetchRequest.resultType = NSManagedObjectIDResultType;
+
+    BOOL appliesOffset = offset > 0 && !context.hasChanges;
+    if (appliesOffset) {
+        fetchRequest.fetchOffset = offset;
+    }
+
+    NSError *error;
+    NSArray *objectIDs = [context executeFetchRequest:fetchRequest error:&error];
+    if (error) {
+        DDLogError(@"%@ error fetching posts: %@", NSStringFromSelector(_cmd), error);
+        return @[];
+    }
+
+    if (offset == 0 || appliesOffset) {
+        return objectIDs;
+    }
+    if (offset >= [objectIDs count]) {
+        return @[];
+    }
+    return [objectIDs subarrayWithRange:NSMakeRange(offset, [objectIDs count] - offset)];
+}
+
+/**
+ Removes the posts with the passed object IDs. Posts that are in use or saved for later
+ are kept, and only lose their topic.
+
+ The rest are deleted from the store with a batch delete request, and the deletions are
+ merged into the context and the main context. Posts that have unsaved changes in the
+ context, and gap markers, are deleted through the context instead.
+
+ The managed object context is not saved.
+ */
+- (void)purgePostsWithObjectIDs:(NSArray<NSManagedObjectID *> *)objectIDs inContext:(NSManagedObjectContext *)context
+{
+    if ([objectIDs count] == 0) {
+        return;
+    }
+
+    NSError *error;
+    NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] initWithEntityName:@"ReaderPost"];
+    fetchRequest.predicate = [NSPredicate predicateWithFormat:@"SELF IN %@ AND (inUse = YES OR isSavedForLater = YES)", objectIDs];
+    NSArray *keptPosts = [context executeFetchRequest:fetchRequest error:&error];
+    if (error) {
+        DDLogError(@"%@ error fetching posts: %@", NSStringFromSelector(_cmd), error);
+        return;
+    }
+
+    NSMutableSet *keptObjectIDs = [NSMutableSet setWithCapacity:[keptPosts count]];
+    for (ReaderPost *post in keptPosts) {
+        // If the post is currently being used or has been saved, just remove its topic.
+        post.topic = nil;
+        [keptObjectIDs addObject:post.objectID];
+    }
+
+    NSString *postEntityName = NSStringFromClass([ReaderPost class]);
+    NSMutableArray *batchDeletedObjectIDs = [NSMutableArray arrayWithCapacity:[objectIDs count]];
+    for (NSManagedObjectID *objectID in objectIDs) {
+        if ([keptObjectIDs containsObject:objectID]) {
+            continue;
+        }
+
+        NSManagedObject *registeredObject = [context objectRegisteredForID:objectID];
+        if (objectID.isTemporaryID || registeredObject.hasChanges || ![objectID.entity.name isEqualToString:postEntityName]) {
+            DDLogInfo(@"Deleting ReaderPost: %@", objectID);
+            [context deleteObject:registeredObject ?: [context objectWithID:objectID]];
+        } else {
+            [batchDeletedObjectIDs addObject:objectID];
+        }
+    }
+
+    [self batchDeletePostsWithObjectIDs:batchDeletedObjectIDs inContext:context];
+}
+
+- (void)batchDeletePostsWithObjectIDs:(NSArray<NSManagedObjectID *> *)objectIDs inContext:(NSManagedObjectContext *)context
+{
+    if ([objectIDs count] == 0) {
+        return;
+    }
+
+    NSBatchDeleteRequest *request = [[NSBatchDeleteRequest alloc] initWithObjectIDs:objectIDs];
+
+    NSError *error;
+    [self.coreDataStack executeBatchRequest:request inContext:context error:&error];
+    if (error) {
+        DDLogError(@"%@ error deleting posts: %@", NSStringFromSelector(_cmd), error);
+        for (NSManagedObjectID *objectID in objectIDs) {
+            [context deleteObject:[context objectWithID:objectID]];
+        }
+        return;
+    }
+
+    DDLogInfo(@"Deleted %lu ReaderPosts", (unsigned long)[objectIDs count]);
+}
 
 #pragma mark Entity Creation
 
 /**
  Accepts an array of `RemoteReaderPost` objects and creates model objects
- for each one.
+ for each one, looking up any existing posts with a single fetch.
 
  @param posts An array of `RemoteReaderPost` objects.
  @param topic The `ReaderAbsractTopic` to assign to the created posts.
@@ -1130,16 +1177,13 @@ static NSString * const ReaderPostGlobalIDKey = @"globalID";
  */
 - (NSMutableArray *)makeNewPostsFromRemotePosts:(NSArray *)posts forTopic:(ReaderAbstractTopic *)topic inContext:(NSManagedObjectContext *)context
 {
-    NSMutableArray *newPosts = [NSMutableArray array];
-    for (RemoteReaderPost *post in posts) {
-        ReaderPost *newPost = [self createOrReplaceFromRemotePost:post forTopic:topic inContext:context];
-        if (newPost != nil) {
-            [newPosts addObject:newPost];
-        } else {
-            DDLogInfo(@"%@ returned a nil post: %@", NSStringFromSelector(_cmd), post);
-        }
+    NSParameterAssert(context != nil);
+    NSParameterAssert(topic == nil || topic.managedObjectContext == context);
+    NSArray *newPosts = [ReaderPost createOrReplaceFromRemotePosts:posts forTopic:topic context:context];
+    if ([newPosts count] != [posts count]) {
+        DDLogInfo(@"%@ created %lu of %lu posts", NSStringFromSelector(_cmd), (unsigned long)[newPosts count], (unsigned long)[posts count]);
     }
-    return newPosts;
+    return [newPosts mutableCopy];
 }
 
 /**
@@ -35,10 +35,10 @@ class ReaderPostStreamService {
                     self.pageNumber += 1
                 }
 
-                posts.enumerated().forEach { index, remotePost in
-                    let post = ReaderPost.createOrReplace(fromRemotePost: remotePost, for: readerTopic, context: context)
+                let readerPosts = ReaderPost.createOrReplace(fromRemotePosts: posts, for: readerTopic, context: context)
+                readerPosts.enumerated().forEach { index, post in
                     // To keep the API order
-                    post?.sortRank = NSNumber(value: Date().timeIntervalSinceReferenceDate - Double(((self.pageNumber * Constants.paginationMultiplier) + index)))
+                    post.sortRank = NSNumber(value: Date().timeIntervalSinceReferenceDate - Double(((self.pageNumber * Constants.paginationMultiplier) + index)))
                 }
 
                 // Clean up
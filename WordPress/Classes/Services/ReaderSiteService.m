@@ -239,21 +239,14 @@ NSString * const ReaderSiteServiceErrorDomain = @"ReaderSiteServiceErrorDomain";
 
 - (void)flagPostsFromSite:(NSNumber *)siteID asBlocked:(BOOL)blocked inContext:(NSManagedObjectContext *)context
 {
+    NSBatchUpdateRequest *request = [[NSBatchUpdateRequest alloc] initWithEntityName:@"ReaderPost"];
+    request.predicate = [NSPredicate predicateWithFormat:@"siteID = %@ AND isSiteBlocked != %@", siteID, @(blocked)];
+    request.propertiesToUpdate = @{ @"isSiteBlocked": @(blocked) };
+
     NSError *error;
-    NSFetchRequest *request = [[NSFetchRequest alloc] initWithEntityName:@"ReaderPost"];
-    request.predicate = [NSPredicate predicateWithFormat:@"siteID = %@", siteID];
-    NSArray *results = [context executeFetchRequest:request error:&error];
+    [self.coreDataStack executeBatchRequest:request inContext:context error:&error];
     if (error) {
-        DDLogError(@"%@, error deleting posts belonging to siteID %@: %@", NSStringFromSelector(_cmd), siteID, error);
-        return;
-    }
-
-    if ([results count] == 0) {
-        return;
-    }
-
-    for (ReaderPost *post in results) {
-        post.isSiteBlocked = blocked;
+        DDLogError(@"%@, error flagging posts belonging to siteID %@: %@", NSStringFromSelector(_cmd), siteID, error);
     }
 }
 
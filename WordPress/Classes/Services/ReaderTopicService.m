@@ -158,17 +158,14 @@ static NSString * const ReaderTopicCurrentTopicPathKey = @"ReaderTopicCurrentTop
 - (void)clearInUseFlags
 {
     [self.coreDataStack performAndSaveUsingBlock:^(NSManagedObjectContext *context) {
-        NSError *error;
-        NSFetchRequest *request = [[NSFetchRequest alloc] initWithEntityName:[ReaderAbstractTopic classNameWithoutNamespaces]];
+        NSBatchUpdateRequest *request = [[NSBatchUpdateRequest alloc] initWithEntityName:[ReaderAbstractTopic classNameWithoutNamespaces]];
         request.predicate = [NSPredicate predicateWithFormat:@"inUse = true"];
-        NSArray *results = [context executeFetchRequest:request error:&error];
+        request.propertiesToUpdate = @{ @"inUse": @NO };
+
+        NSError *error;
+        [self.coreDataStack executeBatchRequest:request inContext:context error:&error];
         if (error) {
             DDLogError(@"%@, marking topic not in use.: %@", NSStringFromSelector(_cmd), error);
-            return;
-        }
-
-        for (ReaderAbstractTopic *topic in results) {
-            topic.inUse = NO;
         }
     }];
 }
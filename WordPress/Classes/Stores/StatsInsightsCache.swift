@@ -4,24 +4,32 @@ import WordPressKit
 final class StatsInsightsCache {
     static let shared = StatsInsightsCache()
 
-    private var cache: [CacheKey: StatsInsightData] = [:]
+    private let cache: StatsTieredCache<CacheKey>
     private var lastRefreshDates: [NSNumber: Date] = [:]
 
+    init(cache: StatsTieredCache<CacheKey> = StatsTieredCache(name: "Insights")) {
+        self.cache = cache
+    }
+
+    var statistics: StatsTieredCache<CacheKey>.Statistics {
+        cache.statistics
+    }
+
     // MARK: - Accessing Cached Data
 
     func getValue<T: StatsInsightData>(record: Record, siteID: NSNumber) -> T? {
         let key = CacheKey(record: record, siteID: siteID)
-        return cache[key] as? T
+        return cache.value(forKey: key)
     }
 
     func setValue<T: StatsInsightData>(_ value: T, record: Record, siteID: NSNumber) {
         let key = CacheKey(record: record, siteID: siteID)
-        cache[key] = value
+        cache.setValue(value, forKey: key)
     }
 
     func hasValue(record: Record, siteID: NSNumber) -> Bool {
         let key = CacheKey(record: record, siteID: siteID)
-        return cache[key] != nil
+        return cache.hasValue(forKey: key)
     }
 
     func removeAll() {
@@ -51,7 +59,7 @@ final class StatsInsightsCache {
 
     // MARK: - Helpers
 
-    enum Record: Hashable {
+    enum Record: String, Hashable {
         case lastPostInsight
         case allTimeStats
         case annualAndMostPopularTime
@@ -62,14 +70,36 @@ final class StatsInsightsCache {
         case topCommentsInsight
         case dotComFollowers
         case emailFollowers
+
+        /// How long a cached value is shown before the network responds.
+        var timeToLive: TimeInterval {
+            switch self {
+            case .todaysStats:
+                return Constants.hour
+            case .lastPostInsight, .topCommentsInsight, .publicizeFollowers, .dotComFollowers, .emailFollowers:
+                return Constants.day
+            case .allTimeStats, .annualAndMostPopularTime, .postingActivity, .topTagsAndCategories:
+                return 7 * Constants.day
+            }
+        }
     }
 
-    private struct CacheKey: Hashable {
+    struct CacheKey: StatsTieredCacheKey {
         let record: Record
         let siteID: NSNumber
+
+        var fileName: String {
+            "\(siteID)-\(record.rawValue)"
+        }
+
+        var timeToLive: TimeInterval {
+            record.timeToLive
+        }
     }
 
     private enum Constants {
         static let cacheTTL: TimeInterval = 300 // 5 minutes
+        static let hour: TimeInterval = 3600
+        static let day: TimeInterval = 86400
     }
 }
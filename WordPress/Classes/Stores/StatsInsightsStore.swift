@@ -392,7 +392,7 @@ private extension StatsInsightsStore {
             state.emailFollowers = getValue(.emailFollowers)
         }
 
-        DDLogInfo("Insights load from cache")
+        DDLogInfo("Insights load from cache (\(cache.statistics))")
     }
 
     private func hasCache(forDataType type: InsightDataType) -> Bool {
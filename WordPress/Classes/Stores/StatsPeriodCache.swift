@@ -4,16 +4,24 @@ import WordPressKit
 final class StatsPediodCache {
     static let shared = StatsPediodCache()
 
-    private var cache: [CacheKey: StatsTimeIntervalData] = [:]
+    private let cache: StatsTieredCache<CacheKey>
+
+    init(cache: StatsTieredCache<CacheKey> = StatsTieredCache(name: "Period")) {
+        self.cache = cache
+    }
+
+    var statistics: StatsTieredCache<CacheKey>.Statistics {
+        cache.statistics
+    }
 
     func getValue<T: StatsTimeIntervalData>(record: Record, date: Date, period: StatsPeriodUnit, unit: StatsPeriodUnit?, siteID: NSNumber) -> T? {
         let key = makeKey(record: record, date: date, period: period, unit: unit, siteID: siteID)
-        return cache[key] as? T
+        return cache.value(forKey: key)
     }
 
     func setValue<T: StatsTimeIntervalData>(_ value: T, record: Record, siteID: NSNumber) {
         let key = makeKey(record: record, date: value.periodEndDate, period: value.period, unit: value.unit, siteID: siteID)
-        cache[key] = value
+        cache.setValue(value, forKey: key)
     }
 
     func removeAll() {
@@ -25,7 +33,7 @@ final class StatsPediodCache {
         return CacheKey(record: record, date: date, period: period, unit: unit, siteID: siteID)
     }
 
-    enum Record: Hashable {
+    enum Record: String, Hashable {
         case timeIntervalsSummary
         case topPostsAndPages
         case topReferrers
@@ -36,14 +44,37 @@ final class StatsPediodCache {
         case topCountries
         case topVideos
         case topFileDownloads
+
+        /// How long a cached value is shown before the network responds.
+        var timeToLive: TimeInterval {
+            switch self {
+            case .timeIntervalsSummary:
+                return Constants.day
+            default:
+                return 7 * Constants.day
+            }
+        }
     }
 
-    private struct CacheKey: Hashable {
+    struct CacheKey: StatsTieredCacheKey {
         let record: Record
         let date: Date
         let period: StatsPeriodUnit
         let unit: StatsPeriodUnit?
         let siteID: NSNumber
+
+        var fileName: String {
+            let unit = unit.map { String($0.rawValue) } ?? "none"
+            return "\(siteID)-\(record.rawValue)-\(period.rawValue)-\(unit)-\(Int(date.timeIntervalSince1970))"
+        }
+
+        var timeToLive: TimeInterval {
+            record.timeToLive
+        }
+    }
+
+    private enum Constants {
+        static let day: TimeInterval = 86400
     }
 }
 
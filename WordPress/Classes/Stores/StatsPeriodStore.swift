@@ -513,7 +513,7 @@ private extension StatsPeriodStore {
             state.topVideos = getValue(.topVideos)
             state.topFileDownloads = getValue(.topFileDownloads)
         }
-        DDLogInfo("Stats Period: Finished setting data to Period store from disk cache.")
+        DDLogInfo("Stats Period: Finished setting data to Period store from disk cache (\(cache.statistics)).")
     }
 
     // MARK: - Traffic Overview Data
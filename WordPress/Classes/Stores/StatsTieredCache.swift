@@ -0,0 +1,229 @@
+import Foundation
+
+/// A key for a `StatsTieredCache` entry.
+protocol StatsTieredCacheKey: Hashable {
+    /// A file name that uniquely identifies the entry on disk.
+    var fileName: String { get }
+
+    /// How long an entry stays valid after it was stored.
+    var timeToLive: TimeInterval { get }
+}
+
+/// A thread-safe two-tier cache for Stats records: a bounded in-memory LRU in
+/// front of a directory of JSON files, so that the last known values survive a
+/// relaunch and the Stats screens can render before the network responds.
+///
+/// Only values that conform to `Codable` are written to disk; everything else
+/// is kept in memory only.
+final class StatsTieredCache<Key: StatsTieredCacheKey> {
+
+    struct Statistics: CustomStringConvertible {
+        var memoryHits = 0
+        var diskHits = 0
+        var misses = 0
+
+        var description: String {
+            "memory hits: \(memoryHits), disk hits: \(diskHits), misses: \(misses)"
+        }
+    }
+
+    private struct Entry {
+        let value: Any
+        let date: Date
+        var lastAccess: UInt64
+    }
+
+    /// Bump whenever the on-disk format changes; older directories are removed.
+    static var schemaVersion: Int { 1 }
+
+    private let memoryCapacity: Int
+    private let directoryURL: URL?
+    private let fileManager: FileManager
+    private let lock = NSLock()
+    private let diskQueue = DispatchQueue(label: "org.wordpress.stats.tiered-cache", qos: .utility)
+
+    private var entries: [Key: Entry] = [:]
+    private var accessCounter: UInt64 = 0
+    /// Incremented by `removeAll()`, so that disk reads started before it are not cached.
+    private var generation = 0
+    private var _statistics = Statistics()
+
+    var statistics: Statistics {
+        lock.lock()
+        defer { lock.unlock() }
+        return _statistics
+    }
+
+    /// - parameter name: The name of the cache directory, or `nil` to keep the
+    /// cache in memory only.
+    init(name: String?, memoryCapacity: Int = 100, fileManager: FileManager = .default) {
+        self.memoryCapacity = memoryCapacity
+        self.fileManager = fileManager
+        self.directoryURL = name.flatMap { StatsTieredCache.makeDirectory(named: $0, fileManager: fileManager) }
+    }
+
+    // MARK: - Accessing Cached Data
+
+    func value<T>(forKey key: Key) -> T? {
+        lock.lock()
+        if var entry = entries[key], !isExpired(entry.date, for: key) {
+            accessCounter += 1
+            entry.lastAccess = accessCounter
+            entries[key] = entry
+            if let value = entry.value as? T {
+                _statistics.memoryHits += 1
+                lock.unlock()
+                return value
+            }
+        }
+        let generation = self.generation
+        lock.unlock()
+
+        // Reading and decoding the file is the slow part, so it happens
+        // outside of the lock and the result is only published afterwards.
+        let cached: (value: T, date: Date)? = readFromDisk(key)
+
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard let cached else {
+            _statistics.misses += 1
+            return nil
+        }
+        _statistics.diskHits += 1
+        // Don't bring back a value removed meanwhile, or replace a newer one.
+        if generation == self.generation, (entries[key]?.date ?? .distantPast) < cached.date {
+            insert(cached.value, date: cached.date, for: key)
+        }
+        return cached.value
+    }
+
+    func setValue<T>(_ value: T, forKey key: Key) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        insert(value, date: Date(), for: key)
+        if let value = value as? Encodable {
+            writeToDisk(value, for: key)
+        }
+    }
+
+    func hasValue(forKey key: Key) -> Bool {
+        lock.lock()
+        if let entry = entries[key], !isExpired(entry.date, for: key) {
+            lock.unlock()
+            return true
+        }
+        lock.unlock()
+
+        guard let url = fileURL(for: key),
+              let date = modificationDate(of: url) else {
+            return false
+        }
+        return !isExpired(date, for: key)
+    }
+
+    func removeAll() {
+        lock.lock()
+        defer { lock.unlock() }
+
+        entries.removeAll()
+        generation += 1
+        guard let directoryURL else {
+            return
+        }
+        // Synchronous, so that nothing stale can be read back once this returns.
+        diskQueue.sync { [fileManager] in
+            let urls = (try? fileManager.contentsOfDirectory(at: directoryURL, includingPropertiesForKeys: nil)) ?? []
+            for url in urls {
+                try? fileManager.removeItem(at: url)
+            }
+        }
+    }
+
+    /// Blocks until every pending disk write has finished.
+    func waitForPendingWrites() {
+        diskQueue.sync {}
+    }
+
+    // MARK: - Memory
+
+    private func insert(_ value: Any, date: Date, for key: Key) {
+        accessCounter += 1
+        entries[key] = Entry(value: value, date: date, lastAccess: accessCounter)
+
+        if entries.count > memoryCapacity,
+           let leastRecentlyUsed = entries.min(by: { $0.value.lastAccess < $1.value.lastAccess })?.key {
+            entries[leastRecentlyUsed] = nil
+        }
+    }
+
+    private func isExpired(_ date: Date, for key: Key) -> Bool {
+        Date().timeIntervalSince(date) > key.timeToLive
+    }
+
+    // MARK: - Disk
+
+    private func readFromDisk<T>(_ key: Key) -> (value: T, date: Date)? {
+        guard let decodableType = T.self as? Decodable.Type,
+              let url = fileURL(for: key),
+              let date = modificationDate(of: url),
+              !isExpired(date, for: key),
+              let data = try? Data(contentsOf: url, options: .mappedIfSafe) else {
+            return nil
+        }
+        do {
+            guard let value = try JSONDecoder().decode(decodableType, from: data) as? T else {
+                return nil
+            }
+            return (value, date)
+        } catch {
+            DDLogError("Stats: Failed to decode cached \(key.fileName): \(error)")
+            return nil
+        }
+    }
+
+    private func writeToDisk(_ value: Encodable, for key: Key) {
+        guard let url = fileURL(for: key) else {
+            return
+        }
+        diskQueue.async {
+            do {
+                let data = try JSONEncoder().encode(value)
+                try data.write(to: url, options: .atomic)
+            } catch {
+                DDLogError("Stats: Failed to write cached \(key.fileName): \(error)")
+            }
+        }
+    }
+
+    private func fileURL(for key: Key) -> URL? {
+        directoryURL?.appendingPathComponent(key.fileName).appendingPathExtension("json")
+    }
+
+    private func modificationDate(of url: URL) -> Date? {
+        (try? fileManager.attributesOfItem(atPath: url.path))?[.modificationDate] as? Date
+    }
+
+    private static func makeDirectory(named name: String, fileManager: FileManager) -> URL? {
+        guard let cachesURL = fileManager.urls(for: .cachesDirectory, in: .userDomainMask).first else {
+            return nil
+        }
+        let parentURL = cachesURL.appendingPathComponent("Stats").appendingPathComponent(name)
+        let directoryURL = parentURL.appendingPathComponent("v\(schemaVersion)")
+
+        // Drop any data written with an older schema.
+        let existing = (try? fileManager.contentsOfDirectory(at: parentURL, includingPropertiesForKeys: nil)) ?? []
+        for url in existing where url.lastPathComponent != directoryURL.lastPathComponent {
+            try? fileManager.removeItem(at: url)
+        }
+
+        do {
+            try fileManager.createDirectory(at: directoryURL, withIntermediateDirectories: true)
+            return directoryURL
+        } catch {
+            DDLogError("Stats: Failed to create cache directory: \(error)")
+            return nil
+        }
+    }
+}
@@ -5,9 +5,15 @@
 #import "WPAccount.h"
 #import "Blog.h"
 #import "WordPress-Swift.h"
+#import <os/lock.h>
 @import AutomatticTracks;
 @import AutomatticTracksEvents;
 
+/// The number of events which can wait to be sent to Tracks.
+static const NSUInteger TracksEventBufferCapacity = 256;
+/// The number of slots of the buffer which only user changes can use, so they aren't dropped when the buffer is full of events.
+static const NSUInteger TracksEventBufferReservedCapacity = 16;
+
 @interface  TracksEventPair : NSObject
 @property (nonatomic, copy) NSString *eventName;
 @property (nonatomic, strong) NSDictionary *properties;
@@ -17,7 +23,19 @@
 @end
 
 
-@interface WPAnalyticsTrackerAutomatticTracks ()
+@interface WPAnalyticsTrackerAutomatticTracks () {
+    // A ring buffer of the events waiting to be sent to Tracks, guarded by `_bufferLock`.
+    // A slot holds either an event, or an action changing the Tracks user.
+    os_unfair_lock _bufferLock;
+    NSString *_bufferedEventNames[TracksEventBufferCapacity];
+    NSDictionary *_bufferedEventProperties[TracksEventBufferCapacity];
+    dispatch_block_t _bufferedActions[TracksEventBufferCapacity];
+    NSUInteger _bufferHead;
+    NSUInteger _bufferedEventCount;
+    NSUInteger _droppedEventCount;
+    // Only accessed on the tracking queue.
+    NSUInteger _reportedDroppedEventCount;
+}
 
 @property (nonatomic, strong) TracksContextManager *contextManager;
 @property (nonatomic, strong) TracksService *tracksService;
@@ -25,6 +43,11 @@
 @property (nonatomic, strong) NSString *anonymousID;
 @property (nonatomic, strong) NSString *loggedInID;
 
+/// The serial queue on which the events are sent to Tracks, and the Tracks user is updated.
+@property (nonatomic, strong) dispatch_queue_t trackingQueue;
+/// Coalesces the requests to send the buffered events, so they are sent in batches.
+@property (nonatomic, strong) dispatch_source_t flushSource;
+
 @end
 
 NSString *const TracksEventPropertyButtonKey = @"button";
@@ -50,10 +73,24 @@ NSString *const TracksUserDefaultsLoggedInUserIDKey = @"TracksLoggedInUserID";
         _tracksService = [[TracksService alloc] initWithContextManager:_contextManager];
         _tracksService.eventNamePrefix = AppConstants.eventNamePrefix;
         _tracksService.platform = AppConstants.explatPlatform;
+        _bufferLock = OS_UNFAIR_LOCK_INIT;
+        _trackingQueue = dispatch_queue_create("org.wordpress.analytics.tracks", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0));
+        _flushSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_DATA_ADD, 0, 0, _trackingQueue);
+
+        __weak __typeof(self) weakSelf = self;
+        dispatch_source_set_event_handler(_flushSource, ^{
+            [weakSelf flushBufferedEvents];
+        });
+        dispatch_resume(_flushSource);
     }
     return self;
 }
 
+- (void)dealloc
+{
+    dispatch_source_cancel(_flushSource);
+}
+
 - (void)track:(WPAnalyticsStat)stat
 {
     [self track:stat withProperties:nil];
@@ -67,10 +104,16 @@ NSString *const TracksUserDefaultsLoggedInUserIDKey = @"TracksLoggedInUserID";
         return;
     }
 
-    NSMutableDictionary *mergedProperties = [NSMutableDictionary new];
-
-    [mergedProperties addEntriesFromDictionary:eventPair.properties];
-    [mergedProperties addEntriesFromDictionary:properties];
+    NSDictionary *mergedProperties;
+    if (eventPair.properties.count == 0) {
+        mergedProperties = properties;
+    } else if (properties.count == 0) {
+        mergedProperties = eventPair.properties;
+    } else {
+        NSMutableDictionary *dictionary = [eventPair.properties mutableCopy];
+        [dictionary addEntriesFromDictionary:properties];
+        mergedProperties = dictionary;
+    }
 
     [self trackString:eventPair.eventName withProperties:mergedProperties];
 }
@@ -81,87 +124,89 @@ NSString *const TracksUserDefaultsLoggedInUserIDKey = @"TracksLoggedInUserID";
 }
 
 - (void)trackString:(NSString *)event withProperties:(NSDictionary *)properties {
-    if (properties == nil) {
-        DDLogInfo(@"🔵 Tracked: %@", event);
-    } else {
-        NSArray<NSString *> *propertyKeys = [[properties allKeys] sortedArrayUsingSelector:@selector(localizedCaseInsensitiveCompare:)];
-        NSString *propertiesDescription = [[propertyKeys wp_map:^NSString *(NSString *key) {
-            return [NSString stringWithFormat:@"%@: %@", key, properties[key]];
-        }] componentsJoinedByString:@", "];
-        DDLogInfo(@"🔵 Tracked: %@ <%@>", event, propertiesDescription);
-    }
-
-    [self.tracksService trackEventName:event withCustomProperties:properties];
+    // Events can be tracked from any thread. They are logged and sent to Tracks in the background.
+    [self enqueueEventName:event properties:[properties copy]];
 }
 
 - (void)beginSession
 {
-    if (self.loggedInID.length > 0) {
-        [self.tracksService switchToAuthenticatedUserWithUsername:self.loggedInID userID:nil wpComToken:[WPAccount tokenForUsername:self.loggedInID] skipAliasEventCreation:YES];
-    } else {
-        [self.tracksService switchToAnonymousUserWithAnonymousID:self.anonymousID];
-    }
+    [self enqueueAction:^{
+        if (self.loggedInID.length > 0) {
+            [self.tracksService switchToAuthenticatedUserWithUsername:self.loggedInID userID:nil wpComToken:[WPAccount tokenForUsername:self.loggedInID] skipAliasEventCreation:YES];
+        } else {
+            [self.tracksService switchToAnonymousUserWithAnonymousID:self.anonymousID];
+        }
+    }];
 
     [self refreshMetadata];
 }
 
 - (void)clearQueuedEvents
 {
-    [self.tracksService clearQueuedEvents];
+    dispatch_async(self.trackingQueue, ^{
+        [self flushBufferedEvents];
+        [self.tracksService clearQueuedEvents];
+    });
 }
 
 - (void)refreshMetadata
 {
     NSManagedObjectContext *context = [[ContextManager sharedInstance] mainContext];
-    __block NSUInteger blogCount;
     __block NSString *username;
-    __block NSNumber *userID;
-    __block NSString *emailAddress;
     __block BOOL accountPresent = NO;
     __block BOOL jetpackBlogsPresent = NO;
-    __block WPAccount *account;
+    __block NSUInteger blogCount = 0;
+    __block BOOL gutenbergEnabled = NO;
 
+    // The account is read synchronously, so the user changes before the events tracked after this call.
     [context performBlockAndWait:^{
-        account = [WPAccount lookupDefaultWordPressComAccountInContext:context];
+        WPAccount *account = [WPAccount lookupDefaultWordPressComAccountInContext:context];
 
-        blogCount = [Blog countInContext:context];
+        username = account.username;
+        accountPresent = account != nil;
         jetpackBlogsPresent = [Blog hasAnyJetpackBlogsInContext:context];
-        if (account != nil) {
-            username = account.username;
-            userID = nil;
-            emailAddress = account.email;
-            accountPresent = YES;
-        }
-    }];
-
-    if ([[NSUUID alloc] initWithUUIDString:username]) {
-        // User has authenticated but we're waiting for account details to sync.
-        // Once details are synced this method will be called again with the actual
-        // username. For now just exit without making changes.
-        return;
-    }
-
-    BOOL dotcom_user = (accountPresent && username.length > 0);
+        blogCount = [Blog countInContext:context];
 
-    // The user "uses" gutenberg if it is enabled on any of their sites.
-    __block BOOL gutenbergEnabled = NO;
-    [account.blogs enumerateObjectsUsingBlock:^(Blog * _Nonnull blog, BOOL * _Nonnull stop) {
-        if (blog.isGutenbergEnabled) {
-            gutenbergEnabled = YES;
-            *stop = YES;
+        // The user "uses" gutenberg if it is enabled on any of their sites.
+        for (Blog *blog in account.blogs) {
+            if (blog.isGutenbergEnabled) {
+                gutenbergEnabled = YES;
+                break;
+            }
         }
     }];
 
     NSMutableDictionary *userProperties = [NSMutableDictionary new];
     userProperties[@"app_scheme"] = WPComScheme;
     userProperties[@"platform"] = @"iOS";
-    userProperties[@"dotcom_user"] = @(dotcom_user);
+    userProperties[@"dotcom_user"] = @(accountPresent && username.length > 0);
     userProperties[@"jetpack_user"] = @(jetpackBlogsPresent);
     userProperties[@"number_of_blogs"] = @(blogCount);
     userProperties[@"accessibility_voice_over_enabled"] = @(UIAccessibilityIsVoiceOverRunning());
     userProperties[@"is_rtl_language"] = @(UIApplication.sharedApplication.userInterfaceLayoutDirection == UIUserInterfaceLayoutDirectionRightToLeft);
     userProperties[@"gutenberg_enabled"] = @(gutenbergEnabled);
 
+    [self enqueueMetadataWithUsername:username accountPresent:accountPresent userProperties:userProperties];
+}
+
+- (void)enqueueMetadataWithUsername:(NSString *)username accountPresent:(BOOL)accountPresent userProperties:(NSDictionary *)userProperties
+{
+    [self enqueueAction:^{
+        [self applyMetadataWithUsername:username accountPresent:accountPresent userProperties:userProperties];
+    }];
+}
+
+- (void)applyMetadataWithUsername:(NSString *)username accountPresent:(BOOL)accountPresent userProperties:(NSDictionary *)userProperties
+{
+    if ([[NSUUID alloc] initWithUUIDString:username]) {
+        // User has authenticated but we're waiting for account details to sync.
+        // Once details are synced this method will be called again with the actual
+        // username. For now just exit without making changes.
+        return;
+    }
+
+    BOOL dotcom_user = (accountPresent && username.length > 0);
+
     [self.tracksService.userProperties removeAllObjects];
     [self.tracksService.userProperties addEntriesFromDictionary:userProperties];
 
@@ -190,6 +235,124 @@ NSString *const TracksUserDefaultsLoggedInUserIDKey = @"TracksLoggedInUserID";
     }
 }
 
+#pragma mark - Event buffer
+
+- (void)enqueueEventName:(NSString *)name properties:(NSDictionary *)properties
+{
+    // When the buffer is full, the event is dropped rather than waiting for the buffer to be drained,
+    // which would deadlock if an event was tracked from the tracking queue.
+    os_unfair_lock_lock(&_bufferLock);
+    if (_bufferedEventCount < TracksEventBufferCapacity - TracksEventBufferReservedCapacity) {
+        NSUInteger index = (_bufferHead + _bufferedEventCount) % TracksEventBufferCapacity;
+        _bufferedEventNames[index] = name;
+        _bufferedEventProperties[index] = properties;
+        _bufferedEventCount += 1;
+    } else {
+        _droppedEventCount += 1;
+    }
+    os_unfair_lock_unlock(&_bufferLock);
+
+    dispatch_source_merge_data(self.flushSource, 1);
+}
+
+/// Runs the action on the tracking queue, after the events tracked before it are sent and before
+/// the events tracked after it are sent.
+///
+/// The actions change the Tracks user, and are never dropped. If the reserved slots are full, the
+/// action replaces the last one, which it supersedes.
+- (void)enqueueAction:(dispatch_block_t)action
+{
+    os_unfair_lock_lock(&_bufferLock);
+    NSUInteger index;
+    if (_bufferedEventCount < TracksEventBufferCapacity) {
+        index = (_bufferHead + _bufferedEventCount) % TracksEventBufferCapacity;
+        _bufferedEventCount += 1;
+    } else {
+        index = (_bufferHead + _bufferedEventCount - 1) % TracksEventBufferCapacity;
+    }
+    _bufferedEventNames[index] = nil;
+    _bufferedEventProperties[index] = nil;
+    _bufferedActions[index] = [action copy];
+    os_unfair_lock_unlock(&_bufferLock);
+
+    dispatch_source_merge_data(self.flushSource, 1);
+}
+
+- (void)flushBufferedEvents
+{
+    dispatch_assert_queue(self.trackingQueue);
+
+    NSString *names[TracksEventBufferCapacity];
+    NSDictionary *properties[TracksEventBufferCapacity];
+    dispatch_block_t actions[TracksEventBufferCapacity];
+
+    os_unfair_lock_lock(&_bufferLock);
+    NSUInteger count = _bufferedEventCount;
+    for (NSUInteger offset = 0; offset < count; offset++) {
+        NSUInteger index = (_bufferHead + offset) % TracksEventBufferCapacity;
+        names[offset] = _bufferedEventNames[index];
+        properties[offset] = _bufferedEventProperties[index];
+        actions[offset] = _bufferedActions[index];
+        _bufferedEventNames[index] = nil;
+        _bufferedEventProperties[index] = nil;
+        _bufferedActions[index] = nil;
+    }
+    _bufferHead = (_bufferHead + count) % TracksEventBufferCapacity;
+    _bufferedEventCount = 0;
+    NSUInteger droppedEventCount = _droppedEventCount;
+    os_unfair_lock_unlock(&_bufferLock);
+
+    if (droppedEventCount > _reportedDroppedEventCount) {
+        DDLogWarn(@"Dropped %lu Tracks events because too many events were waiting to be sent", (unsigned long)(droppedEventCount - _reportedDroppedEventCount));
+        _reportedDroppedEventCount = droppedEventCount;
+    }
+
+    for (NSUInteger index = 0; index < count; index++) {
+        if (actions[index] != nil) {
+            actions[index]();
+        } else {
+            [self logEventName:names[index] properties:properties[index]];
+            [self.tracksService trackEventName:names[index] withCustomProperties:properties[index]];
+        }
+    }
+}
+
+/// The number of events dropped because the buffer was full.
+- (NSUInteger)droppedEventCount
+{
+    os_unfair_lock_lock(&_bufferLock);
+    NSUInteger count = _droppedEventCount;
+    os_unfair_lock_unlock(&_bufferLock);
+    return count;
+}
+
+- (void)logEventName:(NSString *)event properties:(NSDictionary *)properties
+{
+    // Describing the properties is expensive, so it's only done when the event is actually logged.
+    if ((ddLogLevel & DDLogFlagInfo) == 0) {
+        return;
+    }
+
+    if (properties == nil) {
+        DDLogInfo(@"🔵 Tracked: %@", event);
+    } else {
+        NSArray<NSString *> *propertyKeys = [[properties allKeys] sortedArrayUsingSelector:@selector(caseInsensitiveCompare:)];
+        NSMutableString *propertiesDescription = [NSMutableString new];
+        for (NSString *key in propertyKeys) {
+            [propertiesDescription appendFormat:(propertiesDescription.length > 0 ? @", %@: %@" : @"%@: %@"), key, properties[key]];
+        }
+        DDLogInfo(@"🔵 Tracked: %@ <%@>", event, propertiesDescription);
+    }
+}
+
+/// Waits until the events tracked so far are sent to Tracks.
+- (void)waitUntilEventsAreSent
+{
+    dispatch_sync(self.trackingQueue, ^{
+        [self flushBufferedEvents];
+    });
+}
+
 #pragma mark - Private methods
 
 - (NSString *)anonymousID
@@ -243,7 +406,28 @@ NSString *const TracksUserDefaultsLoggedInUserIDKey = @"TracksLoggedInUserID";
     [[UserPersistentStoreFactory userDefaultsInstance] setObject:loggedInID forKey:TracksUserDefaultsLoggedInUserIDKey];
 }
 
+/// Returns the event for the stat, from a table built once, since the events never change.
+/// The few stats declared after `WPAnalyticsStatMaxValue` aren't in the table.
 + (TracksEventPair *)eventPairForStat:(WPAnalyticsStat)stat
+{
+    static NSArray *eventPairs;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSMutableArray *pairs = [NSMutableArray arrayWithCapacity:WPAnalyticsStatMaxValue + 1];
+        for (NSUInteger index = 0; index <= WPAnalyticsStatMaxValue; index++) {
+            [pairs addObject:[self makeEventPairForStat:(WPAnalyticsStat)index] ?: [NSNull null]];
+        }
+        eventPairs = [pairs copy];
+    });
+
+    if (stat > WPAnalyticsStatMaxValue) {
+        return [self makeEventPairForStat:stat];
+    }
+    TracksEventPair *eventPair = eventPairs[stat];
+    return [eventPair isKindOfClass:[TracksEventPair class]] ? eventPair : nil;
+}
+
++ (TracksEventPair *)makeEventPairForStat:(WPAnalyticsStat)stat
 {
     NSString *eventName;
     NSDictionary *eventProperties;
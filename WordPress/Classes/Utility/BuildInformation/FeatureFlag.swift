@@ -18,6 +18,7 @@ enum FeatureFlag: Int, CaseIterable {
     case newGutenbergPlugins
     case serif
     case readerReset
+    case coalescedCoreDataWrites
 
     /// Returns a boolean indicating if the feature is enabled
     var enabled: Bool {
@@ -58,6 +59,8 @@ enum FeatureFlag: Int, CaseIterable {
             return false
         case .readerReset:
             return BuildConfiguration.current != .appStore
+        case .coalescedCoreDataWrites:
+            return BuildConfiguration.current == .localDeveloper
         }
     }
 
@@ -96,6 +99,7 @@ extension FeatureFlag {
         case .newGutenbergPlugins: "Experimental Block Editor Plugins"
         case .serif: "Serif"
         case .readerReset: "Reader Reset"
+        case .coalescedCoreDataWrites: "Coalesced Core Data Writes"
         }
     }
 }
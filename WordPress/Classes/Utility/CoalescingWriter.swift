@@ -0,0 +1,190 @@
+import Foundation
+import CoreData
+
+/// Runs Core Data writes on a single serial writer context and saves them to the store in batches.
+///
+/// Each block runs in a child context of the writer context, so a block that throws only discards its own
+/// changes. The changes of the blocks that succeed are pushed to the writer context, which is saved once the
+/// batch window has elapsed, or as soon as enough objects have changed. Every batch is saved in a single
+/// transaction, which is merged into the main context once.
+///
+/// Completion blocks are called in order, after the changes of their batch are saved.
+///
+final class CoalescingWriter {
+
+    struct Metrics: CustomStringConvertible {
+        /// The number of batches saved to the store.
+        var batches = 0
+        /// The number of blocks executed, including the ones without changes.
+        var blocks = 0
+        /// The number of objects inserted, updated or deleted.
+        var changes = 0
+        var largestBatch = 0
+        /// The time spent saving the batches to the store.
+        var commitDuration: TimeInterval = 0
+        var longestCommitDuration: TimeInterval = 0
+        /// The longest time a change waited before it was saved.
+        var longestLatency: TimeInterval = 0
+
+        var averageBatchSize: Double {
+            batches > 0 ? Double(blocks) / Double(batches) : 0
+        }
+
+        var description: String {
+            let average = String(format: "%.1f", averageBatchSize)
+            let commit = String(format: "%.1f", commitDuration * 1000)
+            let longestCommit = String(format: "%.1f", longestCommitDuration * 1000)
+            let latency = String(format: "%.1f", longestLatency * 1000)
+            return "batches: \(batches), blocks: \(blocks) (avg \(average), max \(largestBatch)), changes: \(changes), commit: \(commit) ms (max \(longestCommit) ms), max latency: \(latency) ms"
+        }
+    }
+
+    /// The longest time a change waits before being saved.
+    let window: TimeInterval
+
+    /// The number of changed objects which triggers a save before the window elapses.
+    let changeThreshold: Int
+
+    private let context: NSManagedObjectContext
+    private let save: (NSManagedObjectContext) -> Void
+
+    // The properties below are only accessed on the writer context's queue.
+    private var pendingCompletions: [() -> Void] = []
+    private var batchStartTime: CFAbsoluteTime?
+    private var isFlushScheduled = false
+    private var generation = 0
+
+    private let metricsLock = NSLock()
+    private var _metrics = Metrics()
+
+    /// - Parameters:
+    ///   - context: A private queue context, which writes directly to the persistent store.
+    ///   - window: The longest time a change waits before being saved.
+    ///   - changeThreshold: The number of changed objects which triggers a save before the window elapses.
+    ///   - save: Saves the given context, on its queue.
+    init(context: NSManagedObjectContext, window: TimeInterval = 0.1, changeThreshold: Int = 500, save: @escaping (NSManagedObjectContext) -> Void) {
+        assert(context.concurrencyType == .privateQueueConcurrencyType)
+
+        self.context = context
+        self.window = window
+        self.changeThreshold = changeThreshold
+        self.save = save
+    }
+
+    var metrics: Metrics {
+        metricsLock.lock()
+        defer { metricsLock.unlock() }
+        return _metrics
+    }
+
+    /// Execute the given block and save its changes with the current batch _if the block does not throw an error_.
+    ///
+    /// - Parameters:
+    ///   - block: A closure that uses the given `NSManagedObjectContext` to make Core Data model changes.
+    ///   - completion: A closure which is called with the `block`'s execution result, after the batch is saved.
+    ///   - queue: A queue on which to execute the completion block.
+    func perform<T>(_ block: @escaping (NSManagedObjectContext) throws -> T, completion: ((Result<T, Error>) -> Void)?, on queue: DispatchQueue) {
+        context.perform {
+            let child = NSManagedObjectContext(concurrencyType: .privateQueueConcurrencyType)
+            child.parent = self.context
+            child.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy
+
+            var result: Result<T, Error>?
+            child.performAndWait {
+                let blockResult = Result(catching: { try block(child) })
+                if case .success = blockResult {
+                    self.save(child)
+                }
+                result = blockResult
+            }
+
+            // It's safe to force-unwrap here, since `performAndWait` has returned.
+            let blockResult = result!
+            self.pendingCompletions.append { queue.async { completion?(blockResult) } }
+            self.batchStartTime = self.batchStartTime ?? CFAbsoluteTimeGetCurrent()
+
+            if !self.context.hasChanges || self.changeCount >= self.changeThreshold {
+                self.flush()
+            } else {
+                self.scheduleFlush()
+            }
+        }
+    }
+
+    /// Save the pending changes now and wait until they are saved.
+    func flushAndWait() {
+        context.performAndWait {
+            if !self.pendingCompletions.isEmpty {
+                self.flush()
+            }
+        }
+    }
+
+    // MARK: - Private
+
+    private var changeCount: Int {
+        context.insertedObjects.count + context.updatedObjects.count + context.deletedObjects.count
+    }
+
+    private func scheduleFlush() {
+        guard !isFlushScheduled else {
+            return
+        }
+        isFlushScheduled = true
+
+        let generation = self.generation
+        DispatchQueue.global(qos: .utility).asyncAfter(deadline: .now() + window) { [weak self] in
+            guard let self else {
+                return
+            }
+            self.context.perform {
+                // The batch has already been saved if the change threshold was reached.
+                if self.generation == generation {
+                    self.flush()
+                }
+            }
+        }
+    }
+
+    private func flush() {
+        generation += 1
+        isFlushScheduled = false
+
+        let completions = pendingCompletions
+        let latency = batchStartTime.map { CFAbsoluteTimeGetCurrent() - $0 } ?? 0
+        pendingCompletions = []
+        batchStartTime = nil
+
+        let changes = changeCount
+        var duration: TimeInterval = 0
+        if changes > 0 {
+            let start = CFAbsoluteTimeGetCurrent()
+            save(context)
+            duration = CFAbsoluteTimeGetCurrent() - start
+
+            // Nothing else holds on to the writer context's objects once they are saved.
+            context.reset()
+        }
+
+        record(blocks: completions.count, changes: changes, duration: duration, latency: latency)
+        completions.forEach { $0() }
+    }
+
+    private func record(blocks: Int, changes: Int, duration: TimeInterval, latency: TimeInterval) {
+        metricsLock.lock()
+        _metrics.blocks += blocks
+        if changes > 0 {
+            _metrics.batches += 1
+            _metrics.changes += changes
+            _metrics.largestBatch = max(_metrics.largestBatch, blocks)
+            _metrics.commitDuration += duration
+            _metrics.longestCommitDuration = max(_metrics.longestCommitDuration, duration)
+            _metrics.longestLatency = max(_metrics.longestLatency, latency)
+        }
+        metricsLock.unlock()
+
+        if changes > 0 {
+            DDLogDebug("CoalescingWriter: saved \(blocks) blocks, \(changes) changes in \(String(format: "%.1f", duration * 1000)) ms")
+        }
+    }
+}
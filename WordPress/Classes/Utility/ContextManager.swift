@@ -60,6 +60,31 @@ public class ContextManager: NSObject, CoreDataStack, CoreDataStackSwift {
     ///   removed soon, I think it's okay to make this compromise.
     private let writerQueue: OperationQueue
 
+    private var coalescingWriter: CoalescingWriter?
+
+    /// Whether the changes made in `performAndSave(_:completion:on:)` are saved in batches by a single writer
+    /// context, instead of each being saved in its own transaction.
+    ///
+    /// This should be set before any changes are made, when the app launches.
+    @objc
+    public var coalescesWrites: Bool {
+        get {
+            coalescingWriter != nil
+        }
+        set {
+            guard newValue != coalescesWrites else {
+                return
+            }
+            coalescingWriter?.flushAndWait()
+            coalescingWriter = newValue ? CoalescingWriter(context: newDerivedContext()) { [unowned self] in self.internalSave($0) } : nil
+        }
+    }
+
+    /// The batch sizes and commit latency of the coalesced writes.
+    var coalescedWriteMetrics: CoalescingWriter.Metrics? {
+        coalescingWriter?.metrics
+    }
+
     @objc
     public var mainContext: NSManagedObjectContext {
         persistentContainer.viewContext
@@ -104,6 +129,9 @@ public class ContextManager: NSObject, CoreDataStack, CoreDataStackSwift {
 
     @objc(performAndSaveUsingBlock:)
     public func performAndSave(_ block: @escaping (NSManagedObjectContext) -> Void) {
+        // The block may depend on the changes that are waiting to be saved.
+        coalescingWriter?.flushAndWait()
+
         let context = newDerivedContext()
         context.performAndWait {
             block(context)
@@ -114,6 +142,11 @@ public class ContextManager: NSObject, CoreDataStack, CoreDataStackSwift {
 
     @objc(performAndSaveUsingBlock:completion:onQueue:)
     public func performAndSave(_ block: @escaping (NSManagedObjectContext) -> Void, completion: (() -> Void)?, on queue: DispatchQueue) {
+        if let coalescingWriter {
+            coalescingWriter.perform(block, completion: { _ in completion?() }, on: queue)
+            return
+        }
+
         let context = newDerivedContext()
         self.writerQueue.addOperation(AsyncBlockOperation { done in
             context.perform {
@@ -127,6 +160,11 @@ public class ContextManager: NSObject, CoreDataStack, CoreDataStackSwift {
     }
 
     public func performAndSave<T>(_ block: @escaping (NSManagedObjectContext) throws -> T, completion: ((Result<T, Error>) -> Void)?, on queue: DispatchQueue) {
+        if let coalescingWriter {
+            coalescingWriter.perform(block, completion: completion, on: queue)
+            return
+        }
+
         let context = newDerivedContext()
         self.writerQueue.addOperation(AsyncBlockOperation { done in
             context.perform {
@@ -157,6 +195,58 @@ public class ContextManager: NSObject, CoreDataStack, CoreDataStackSwift {
         }
     }
 
+    public func execute(_ request: NSPersistentStoreRequest, in context: NSManagedObjectContext) throws -> [NSManagedObjectID] {
+        let fetchRequest: NSFetchRequest<NSFetchRequestResult>
+        let changesKey: String
+        switch request {
+        case let request as NSBatchUpdateRequest:
+            request.resultType = .updatedObjectIDsResultType
+            fetchRequest = NSFetchRequest(entityName: request.entityName)
+            fetchRequest.predicate = request.predicate
+            changesKey = NSUpdatedObjectsKey
+        case let request as NSBatchDeleteRequest:
+            request.resultType = .resultTypeObjectIDs
+            fetchRequest = request.fetchRequest
+            changesKey = NSDeletedObjectsKey
+        default:
+            preconditionFailure("Unsupported batch request: \(request)")
+        }
+
+        let result = try context.execute(request)
+        let objectIDs = ((result as? NSBatchUpdateResult)?.result ?? (result as? NSBatchDeleteResult)?.result) as? [NSManagedObjectID] ?? []
+
+        // The store doesn't know about the unsaved changes of the context
+        if let entity = NSEntityDescription.entity(forEntityName: fetchRequest.entityName ?? "", in: context) {
+            let pendingObjects = context.insertedObjects.union(context.updatedObjects).filter {
+                $0.entity.isKindOf(entity: entity) && (fetchRequest.predicate?.evaluate(with: $0) ?? true)
+            }
+            for object in pendingObjects {
+                if let request = request as? NSBatchUpdateRequest {
+                    request.propertiesToUpdate?.forEach { key, value in
+                        let value = (value as? NSExpression)?.expressionValue(with: object, context: nil) ?? value
+                        object.setValue(value, forKey: key as? String ?? (key as? NSPropertyDescription)?.name ?? "")
+                    }
+                } else {
+                    context.delete(object)
+                }
+            }
+        }
+
+        guard !objectIDs.isEmpty else {
+            return objectIDs
+        }
+
+        // Batch requests bypass the contexts, so they need to be told about the changes
+        let changes = [changesKey: objectIDs]
+        NSManagedObjectContext.mergeChanges(fromRemoteContextSave: changes, into: [context])
+        if context !== mainContext {
+            mainContext.perform {
+                NSManagedObjectContext.mergeChanges(fromRemoteContextSave: changes, into: [self.mainContext])
+            }
+        }
+        return objectIDs
+    }
+
     @objc
     public func saveContextAndWait(_ context: NSManagedObjectContext) {
         save(context, .synchronously)
@@ -313,7 +403,11 @@ private extension ContextManager {
 }
 
 extension ContextManager {
-    private static let internalSharedInstance = ContextManager()
+    private static let internalSharedInstance: ContextManager = {
+        let contextManager = ContextManager()
+        contextManager.coalescesWrites = FeatureFlag.coalescedCoreDataWrites.enabled
+        return contextManager
+    }()
     /// Tests purpose only
     static var overrideInstance: ContextManager?
 
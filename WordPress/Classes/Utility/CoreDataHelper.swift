@@ -52,6 +52,7 @@ extension NSManagedObjectContext {
         request.includesSubentities = false
         request.predicate = predicate
         request.resultType = .countResultType
+        FetchIndexAudit.check(request, in: self)
 
         var result = 0
 
@@ -134,6 +135,7 @@ extension NSManagedObjectContext {
     ///
     private func loadObjects<T: NSManagedObject>(ofType type: T.Type, with request: NSFetchRequest<NSFetchRequestResult>) -> [T] {
         var objects: [T]?
+        FetchIndexAudit.check(request, in: self)
 
         do {
             objects = try fetch(request) as? [T]
@@ -29,6 +29,19 @@ NS_ASSUME_NONNULL_BEGIN
 ///   - queue: A queue on which to execute the `completion` block.
 - (void)performAndSaveUsingBlock:(void (^)(NSManagedObjectContext *context))aBlock completion:(void (^ _Nullable)(void))completion onQueue:(dispatch_queue_t)queue;
 
+/// Execute a batch update or batch delete request directly against the persistent store, without loading the
+/// objects in memory.
+///
+/// The changes are merged into the given context and into the main context. Objects that are inserted or
+/// updated in the given context but not saved yet are changed in memory too, since the store doesn't know
+/// about them.
+///
+/// - Parameters:
+///   - request: An `NSBatchUpdateRequest` or an `NSBatchDeleteRequest`.
+///   - context: The context the request is executed in, on its queue.
+/// - Returns: The IDs of the objects updated or deleted in the store.
+- (nullable NSArray<NSManagedObjectID *> *)executeBatchRequest:(NSPersistentStoreRequest *)request inContext:(NSManagedObjectContext *)context error:(NSError **)error NS_SWIFT_NAME(execute(_:in:));
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -74,8 +74,12 @@ class ImageDimensionsFetcher: NSObject, URLSessionDataDelegate {
             return
         }
 
-        // Wait for the image size
+        // Wait for the image size, unless the parser gave up
         guard let size = parser.imageSize else {
+            if parser.isFinished {
+                completionHandler(format, nil)
+                cancel()
+            }
             return
         }
 
@@ -1,51 +1,119 @@
 import UIKit
 
+/// Reads the dimensions of an image from the first bytes of the file, without
+/// decoding it.
+///
+/// The parser is incremental: bytes can be appended as they arrive, and each
+/// call only looks at the bytes that haven't been consumed yet. Segments and
+/// boxes that don't contain the dimensions are skipped without being buffered,
+/// even when they span several chunks.
 class ImageDimensionParser {
     private(set) var format: ImageDimensionFormat?
     private(set) var imageSize: CGSize? = nil
 
-    private var data: Data
+    /// Bytes that have been received, but not consumed yet.
+    private var buffer = Data()
 
-    init(with data: Data = Data()) {
-        self.data = data
+    /// The stream offset of the first byte in `buffer`.
+    private var position = 0
 
-        parse()
+    /// The number of incoming bytes to drop before buffering again, used when
+    /// a skipped segment extends past the bytes received so far.
+    private var bytesToSkip = 0
+
+    /// Set once the size is found, or once it's clear it can't be.
+    private(set) var isFinished = false
+
+    /// The ISO BMFF boxes the parser is currently inside of.
+    private var containers: [(type: BoxType, end: Int)] = []
+    private var largestSpatialExtent: CGSize?
+
+    init(with data: Data = Data()) {
+        append(bytes: data)
     }
 
     public func append(bytes: Data) {
-        data.append(contentsOf: bytes)
+        guard !isFinished, !bytes.isEmpty else {
+            return
+        }
+
+        var bytes = bytes
+        if bytesToSkip > 0 {
+            let skipped = min(bytesToSkip, bytes.count)
+            bytesToSkip -= skipped
+            position += skipped
+            bytes = bytes.dropFirst(skipped)
+        }
+        buffer.append(bytes)
 
         parse()
     }
 
     private func parse() {
-        guard
-            let format = ImageDimensionFormat(with: data)
-        else {
-            return
-        }
+        let consumed = buffer.withUnsafeBytes { bytes -> Int in
+            if format == nil {
+                format = ImageDimensionFormat(header: bytes)
+            }
+            guard format != nil else {
+                return 0
+            }
 
-        self.format = format
-        imageSize = dimensions(with: data)
+            var offset = 0
+            while !isFinished {
+                switch nextStep(in: UnsafeRawBufferPointer(rebasing: bytes[offset...]), at: position + offset) {
+                case .needsMoreData:
+                    return offset
+                case .skip(let count):
+                    guard offset + count <= bytes.count else {
+                        bytesToSkip = offset + count - bytes.count
+                        return bytes.count
+                    }
+                    offset += count
+                case .found(let size):
+                    imageSize = size
+                    isFinished = true
+                case .failed:
+                    isFinished = true
+                }
+            }
+            return offset
+        }
 
-        guard imageSize != nil else {
+        guard !isFinished else {
+            buffer = Data()
             return
         }
+        position += consumed
+        buffer.removeSubrange(buffer.startIndex..<buffer.startIndex + consumed)
     }
 
     // MARK: - Dimension Calculating
-    private func dimensions(with data: Data) -> CGSize? {
+    private enum Step {
+        case needsMoreData
+        /// Consumes the given number of bytes, which can be more than the
+        /// bytes that have been received so far.
+        case skip(Int)
+        case found(CGSize)
+        case failed
+    }
+
+    /// - parameters:
+    ///   - bytes: The unconsumed bytes.
+    ///   - offset: The offset of the first unconsumed byte in the stream.
+    private func nextStep(in bytes: UnsafeRawBufferPointer, at offset: Int) -> Step {
         switch format {
-            case .png: return pngSize(with: data)
-            case .gif: return gifSize(with: data)
-            case .jpeg: return jpegSize(with: data)
+            case .png: return pngStep(in: bytes)
+            case .gif: return gifStep(in: bytes)
+            case .jpeg: return jpegStep(in: bytes, at: offset)
+            case .webp: return webpStep(in: bytes)
+            case .heic, .avif: return boxStep(in: bytes, at: offset)
 
-            default: return nil
+            default: return .failed
         }
     }
 
     // MARK: - PNG Parsing
-    private func pngSize(with data: Data) -> CGSize? {
+    private func pngStep(in bytes: UnsafeRawBufferPointer) -> Step {
         // Bail out if the data size is too small to read the header
         let chunkSize = PNGConstants.chunkSize
         let ihdrStart = PNGConstants.headerSize + chunkSize
@@ -53,13 +121,13 @@ class ImageDimensionParser {
         // The min length needed to read the width / height
         let minLength = ihdrStart + chunkSize * 3
 
-        guard data.count >= minLength else {
-            return nil
+        guard bytes.count >= minLength else {
+            return .needsMoreData
         }
 
         // Validate the header to make sure the width/height is in the correct spot
-        guard data.subdata(start: ihdrStart, length: chunkSize) == PNGConstants.IHDR else {
-            return nil
+        guard bytes.matches(PNGConstants.IHDR, at: ihdrStart) else {
+            return .failed
         }
 
         // Width is immediately after the IHDR header
@@ -71,10 +139,10 @@ class ImageDimensionParser {
         // Height and width are stored as 32 bit ints
         // http://www.libpng.org/pub/png/spec/1.0/PNG-Chunks.html
         // ^ The maximum for each is (2^31)-1 in order to accommodate languages that have difficulty with unsigned 4-byte values.
-        let width = CFSwapInt32(data[widthOffset, chunkSize] as UInt32)
-        let height = CFSwapInt32(data[heightOffset, chunkSize] as UInt32)
+        let width = bytes.bigEndianUInt32(at: widthOffset)
+        let height = bytes.bigEndianUInt32(at: heightOffset)
 
-        return CGSize(width: Int(width), height: Int(height))
+        return .found(CGSize(width: Int(width), height: Int(height)))
     }
 
     private struct PNGConstants {
@@ -85,31 +153,31 @@ class ImageDimensionParser {
         static let chunkSize = 4
 
         // IHDR header: // https://www.w3.org/TR/PNG/#11IHDR
-        static let IHDR = Data([0x49, 0x48, 0x44, 0x52])
+        static let IHDR: [UInt8] = [0x49, 0x48, 0x44, 0x52]
     }
 
     // MARK: - GIF Parsing
-    private func gifSize(with data: Data) -> CGSize? {
+    private func gifStep(in bytes: UnsafeRawBufferPointer) -> Step {
         // Bail out if the data size is too small to read the header
         let valueSize = GIFConstants.valueSize
         let headerSize = GIFConstants.headerSize
 
-        // Min length we need to read is the header size + 4 bytes
-        let minLength = headerSize + valueSize * 3
+        // Min length we need to read is the header size + the width and height
+        let minLength = headerSize + valueSize * 2
 
-        guard data.count >= minLength else {
-            return nil
+        guard bytes.count >= minLength else {
+            return .needsMoreData
         }
 
         // The width appears directly after the header, and the height after that.
         let widthOffset = headerSize
-        let heightOffset = widthOffset
+        let heightOffset = widthOffset + valueSize
 
         // Reads the "logical screen descriptor" which appears after the GIF header block
-        let width: UInt16 = data[widthOffset, valueSize]
-        let height: UInt16 = data[heightOffset, valueSize]
+        let width = bytes.littleEndianUInt16(at: widthOffset)
+        let height = bytes.littleEndianUInt16(at: heightOffset)
 
-        return CGSize(width: Int(width), height: Int(height))
+        return .found(CGSize(width: Int(width), height: Int(height)))
     }
 
     private struct GIFConstants {
@@ -124,74 +192,218 @@ class ImageDimensionParser {
 
     // MARK: - JPEG Parsing
     private struct JPEGConstants {
-        static let blockSize: UInt16 = 256
+        // SOI marker
+        static let startOfImageSize = 2
 
-        // 16 bytes skips the header and the first block
-        static let minDataCount = 16
+        // Marker (2 bytes) + length (2 bytes) + precision (1 byte) + height and width (2 bytes each)
+        static let frameHeaderSize = 9
 
-        static let valueSize = 2
         static let heightOffset = 5
-
-        // JFIF{NULL}
-        static let jfifHeader = Data([0x4A, 0x46, 0x49, 0x46, 0x00])
+        static let widthOffset = 7
     }
 
-    private func jpegSize(with data: Data) -> CGSize? {
-        // Bail out if the data size is too small to read the header
-        guard data.count > JPEGConstants.minDataCount else {
-            return nil
-        }
-
+    /// Walks the segments one marker at a time until it reaches a "start of
+    /// frame" segment, which contains the size. Baseline, extended, progressive
+    /// and lossless frames (including their arithmetic-coded variants) all
+    /// share the same header layout.
+    private func jpegStep(in bytes: UnsafeRawBufferPointer, at offset: Int) -> Step {
         // Adapted from:
         // - https://web.archive.org/web/20131016210645/http://www.64lines.com/jpeg-width-height
+        // - https://www.w3.org/Graphics/JPEG/itu-t81.pdf (Table B.1)
+        if offset == 0 {
+            return .skip(JPEGConstants.startOfImageSize)
+        }
+
+        guard bytes.count >= 2 else {
+            return .needsMoreData
+        }
+
+        // Check that we are truly at the start of another segment
+        guard bytes[0] == 0xFF else {
+            return .failed
+        }
+
+        switch bytes[1] {
+        case 0xFF:
+            // Fill byte, the marker follows
+            return .skip(1)
+        case 0x01, 0xD0...0xD7:
+            // TEM and RSTn markers don't have a length
+            return .skip(2)
+        case 0xD9, 0xDA:
+            // End of image, or start of scan before any frame header
+            return .failed
+        case 0xC0...0xC3, 0xC5...0xC7, 0xC9...0xCB, 0xCD...0xCF:
+            // "Start of frame" marker which contains the file size
+            guard bytes.count >= JPEGConstants.frameHeaderSize else {
+                return .needsMoreData
+            }
+            let height = bytes.bigEndianUInt16(at: JPEGConstants.heightOffset)
+            let width = bytes.bigEndianUInt16(at: JPEGConstants.widthOffset)
+
+            return .found(CGSize(width: Int(width), height: Int(height)))
+        default:
+            // Go to the next segment. The length includes itself, but not the marker.
+            guard bytes.count >= 4 else {
+                return .needsMoreData
+            }
+            let length = Int(bytes.bigEndianUInt16(at: 2))
+            guard length >= 2 else {
+                return .failed
+            }
+            return .skip(2 + length)
+        }
+    }
 
-        var i = JPEGConstants.jfifHeader.count - 1
+    // MARK: - WebP Parsing
+    private struct WebPConstants {
+        // "RIFF" + file size + "WEBP"
+        static let riffHeaderSize = 12
 
-        let blockSize: UInt16 = JPEGConstants.blockSize
+        // The first chunk header: FourCC + chunk size
+        static let chunkHeaderSize = 8
+        static let payloadOffset = riffHeaderSize + chunkHeaderSize
 
-        // Retrieve the block length of the first block since the first block will not contain the size of file
-        var block_length = UInt16(data[i]) * blockSize + UInt16(data[i+1])
+        static let lossy: [UInt8] = [0x56, 0x50, 0x38, 0x20] // "VP8 "
+        static let lossless: [UInt8] = [0x56, 0x50, 0x38, 0x4C] // "VP8L"
+        static let extended: [UInt8] = [0x56, 0x50, 0x38, 0x58] // "VP8X"
 
-        while i < data.count {
-            i += Int(block_length)
+        static let lossyStartCode: [UInt8] = [0x9D, 0x01, 0x2A]
+        static let losslessSignature: UInt8 = 0x2F
+    }
 
-            // Protect again out of bounds issues
-            // 10 = the max size we need to read all the values from below
-            if i + 10 >= data.count {
-                return nil
+    /// - note: https://developers.google.com/speed/webp/docs/riff_container
+    private func webpStep(in bytes: UnsafeRawBufferPointer) -> Step {
+        let payload = WebPConstants.payloadOffset
+        guard bytes.count >= payload else {
+            return .needsMoreData
+        }
+
+        if bytes.matches(WebPConstants.lossy, at: WebPConstants.riffHeaderSize) {
+            // Frame tag (3 bytes), start code (3 bytes), then 14 bit width and height
+            guard bytes.count >= payload + 10 else {
+                return .needsMoreData
+            }
+            guard bytes.matches(WebPConstants.lossyStartCode, at: payload + 3) else {
+                return .failed
             }
+            let width = bytes.littleEndianUInt16(at: payload + 6) & 0x3FFF
+            let height = bytes.littleEndianUInt16(at: payload + 8) & 0x3FFF
 
-            // Check that we are truly at the start of another block
-            if data[i] != 0xFF {
-                return nil
+            return .found(CGSize(width: Int(width), height: Int(height)))
+        }
+
+        if bytes.matches(WebPConstants.lossless, at: WebPConstants.riffHeaderSize) {
+            // Signature (1 byte), then 14 bits for width - 1 and 14 bits for height - 1
+            guard bytes.count >= payload + 5 else {
+                return .needsMoreData
+            }
+            guard bytes[payload] == WebPConstants.losslessSignature else {
+                return .failed
             }
+            let bits = bytes.littleEndianUInt32(at: payload + 1)
+            let width = (bits & 0x3FFF) + 1
+            let height = ((bits >> 14) & 0x3FFF) + 1
 
-            // SOFn marker
-            let marker = data[i+1]
+            return .found(CGSize(width: Int(width), height: Int(height)))
+        }
+
+        if bytes.matches(WebPConstants.extended, at: WebPConstants.riffHeaderSize) {
+            // Flags (4 bytes), then 24 bits for canvas width - 1 and height - 1
+            guard bytes.count >= payload + 10 else {
+                return .needsMoreData
+            }
+            let width = bytes.littleEndianUInt24(at: payload + 4) + 1
+            let height = bytes.littleEndianUInt24(at: payload + 7) + 1
+
+            return .found(CGSize(width: Int(width), height: Int(height)))
+        }
+
+        return .failed
+    }
 
-            let isValidMarker = (marker >= 0xC0 && marker <= 0xC3) ||
-                                (marker >= 0xC5 && marker <= 0xC7) ||
-                                (marker >= 0xC9 && marker <= 0xCB) ||
-                                (marker >= 0xCD && marker <= 0xCF)
+    // MARK: - HEIF Parsing
+    private enum BoxType: UInt32 {
+        case meta = 0x6D657461
+        case iprp = 0x69707270
+        case ipco = 0x6970636F
+        case ispe = 0x69737065
+    }
 
-            if isValidMarker {
-                // "Start of frame" marker which contains the file size
-                let valueSize = JPEGConstants.valueSize
-                let heightOffset = i + JPEGConstants.heightOffset
-                let widthOffset = heightOffset + valueSize
+    /// Walks the ISO BMFF boxes down to `meta/iprp/ipco` and reads the image
+    /// spatial extents (`ispe`) properties in there. HEIC and AVIF files share
+    /// this layout.
+    ///
+    /// A file can have several `ispe` properties (e.g. for the thumbnail and
+    /// for the tiles of a grid), so the largest one is reported, which is the
+    /// size of the primary image in practice.
+    ///
+    /// - note: ISO/IEC 23008-12, section 6.5.3.
+    private func boxStep(in bytes: UnsafeRawBufferPointer, at offset: Int) -> Step {
+        // Leave the boxes that end here
+        while let container = containers.last, offset >= container.end {
+            containers.removeLast()
+            switch container.type {
+            case .ipco:
+                return largestSpatialExtent.map(Step.found) ?? .failed
+            case .meta:
+                return .failed
+            default:
+                break
+            }
+        }
 
-                let height = CFSwapInt16(data[heightOffset, valueSize] as UInt16)
-                let width = CFSwapInt16(data[widthOffset, valueSize] as UInt16)
+        guard bytes.count >= 8 else {
+            return .needsMoreData
+        }
 
-                return CGSize(width: Int(width), height: Int(height))
+        var size = Int(bytes.bigEndianUInt32(at: 0))
+        var headerSize = 8
+        let extendsToEndOfFile = size == 0
+        if size == 1 {
+            guard bytes.count >= 16 else {
+                return .needsMoreData
             }
+            size = Int(clamping: bytes.bigEndianUInt64(at: 8))
+            headerSize = 16
+        } else if extendsToEndOfFile {
+            size = Int.max - offset
+        }
+        // A malformed size can't be used to find the end of the box
+        guard size >= headerSize, !offset.addingReportingOverflow(size).overflow else {
+            return .failed
+        }
 
-            // Go to the next block
-            i += 2 // Skip the block marker
-            block_length = UInt16(data[i]) * blockSize + UInt16(data[i+1])
+        let type = BoxType(rawValue: bytes.bigEndianUInt32(at: 4))
+        switch (type, containers.last?.type) {
+        case (.meta, nil):
+            // A full box, with a version and flags before the children
+            containers.append((.meta, offset + size))
+            return .skip(headerSize + 4)
+        case (.iprp, .meta), (.ipco, .iprp):
+            containers.append((type!, offset + size))
+            return .skip(headerSize)
+        case (.ispe, .ipco):
+            // Version and flags, then 32 bit width and height
+            guard bytes.count >= headerSize + 12 else {
+                return .needsMoreData
+            }
+            let extent = CGSize(width: Int(bytes.bigEndianUInt32(at: headerSize + 4)),
+                                height: Int(bytes.bigEndianUInt32(at: headerSize + 8)))
+            if extent.area > (largestSpatialExtent?.area ?? 0) {
+                largestSpatialExtent = extent
+            }
+            return .skip(size)
+        default:
+            // There is nothing to find past a box that extends to the end of the file
+            return extendsToEndOfFile ? .failed : .skip(size)
         }
+    }
+}
 
-        return nil
+private extension CGSize {
+    var area: CGFloat {
+        width * height
     }
 }
 
@@ -203,21 +415,71 @@ enum ImageDimensionFormat {
     case jpeg
     case png
     case gif
+    case webp
+    case heic
+    case avif
     case unsupported
 
     init?(with data: Data) {
-        if data.headerIsEqual(to: FileMarker.jpeg) {
+        guard let format = data.withUnsafeBytes({ ImageDimensionFormat(header: $0) }) else {
+            return nil
+        }
+        self = format
+    }
+
+    /// Returns `nil` if there are not enough bytes to tell the format yet.
+    fileprivate init?(header: UnsafeRawBufferPointer) {
+        if header.matches(FileMarker.jpeg) {
             self = .jpeg
         }
-        else if data.headerIsEqual(to: FileMarker.gif) {
+        else if header.matches(FileMarker.gif) {
             self = .gif
         }
-        else if data.headerIsEqual(to: FileMarker.png) {
+        else if header.matches(FileMarker.png) {
             self = .png
         }
-        else if data.count < FileMarker.png.count {
+        else if header.count < FileMarker.ftypOffset + FileMarker.ftyp.count {
             return nil
         }
+        else if header.matches(FileMarker.riff) {
+            guard header.count >= FileMarker.webpOffset + FileMarker.webp.count else {
+                return nil
+            }
+            self = header.matches(FileMarker.webp, at: FileMarker.webpOffset) ? .webp : .unsupported
+        }
+        else if header.matches(FileMarker.ftyp, at: FileMarker.ftypOffset) {
+            guard let format = ImageDimensionFormat(fileTypeBox: header) else {
+                return nil
+            }
+            self = format
+        }
+        else {
+            self = .unsupported
+        }
+    }
+
+    /// Reads the major and compatible brands of an ISO BMFF `ftyp` box.
+    private init?(fileTypeBox header: UnsafeRawBufferPointer) {
+        let size = Int(header.bigEndianUInt32(at: 0))
+        guard size >= 16, size <= 1024, size % 4 == 0 else {
+            self = .unsupported
+            return
+        }
+        guard header.count >= size else {
+            return nil
+        }
+
+        // The major brand is at 8, followed by the minor version and the compatible brands
+        let brands = stride(from: 8, to: size, by: 4)
+            .filter { $0 != 12 }
+            .map { header.bigEndianUInt32(at: $0) }
+
+        if brands.contains(where: FileMarker.avifBrands.contains) {
+            self = .avif
+        }
+        else if brands.contains(where: FileMarker.heicBrands.contains) {
+            self = .heic
+        }
         else {
             self = .unsupported
         }
@@ -226,43 +488,72 @@ enum ImageDimensionFormat {
     // File type markers denote the type of image in the first few bytes of the file
     private struct FileMarker {
         // https://en.wikipedia.org/wiki/JPEG_Network_Graphics
-        static let png = Data([0x89, 0x50, 0x4E, 0x47])
+        static let png: [UInt8] = [0x89, 0x50, 0x4E, 0x47]
 
         // https://en.wikipedia.org/wiki/JPEG_File_Interchange_Format
         // FFD8 = SOI, APP0 marker
-        static let jpeg = Data([0xFF, 0xD8, 0xFF])
+        static let jpeg: [UInt8] = [0xFF, 0xD8, 0xFF]
 
         // https://en.wikipedia.org/wiki/GIF
-        static let gif = Data([0x47, 0x49, 0x46, 0x38]) //GIF8
+        static let gif: [UInt8] = [0x47, 0x49, 0x46, 0x38] //GIF8
+
+        // https://developers.google.com/speed/webp/docs/riff_container
+        static let riff: [UInt8] = [0x52, 0x49, 0x46, 0x46] // RIFF
+        static let webp: [UInt8] = [0x57, 0x45, 0x42, 0x50] // WEBP
+        static let webpOffset = 8
+
+        // https://en.wikipedia.org/wiki/ISO_base_media_file_format
+        static let ftyp: [UInt8] = [0x66, 0x74, 0x79, 0x70] // ftyp
+        static let ftypOffset = 4
+
+        static let avifBrands: Set<UInt32> = [
+            0x61766966, // avif
+            0x61766973, // avis
+        ]
+        static let heicBrands: Set<UInt32> = [
+            0x68656963, // heic
+            0x68656978, // heix
+            0x6865696D, // heim
+            0x68656973, // heis
+            0x68657663, // hevc
+            0x68657678, // hevx
+            0x6D696631, // mif1
+            0x6D736631, // msf1
+        ]
     }
 }
 
 // MARK: - Private: Extensions
-private extension Data {
-    func headerData(with length: Int) -> Data {
-        return subdata(start: 0, length: length)
-    }
-
-    func headerIsEqual(to value: Data) -> Bool {
+private extension UnsafeRawBufferPointer {
+    func matches(_ marker: [UInt8], at offset: Int = 0) -> Bool {
         // Prevent any out of bounds issues
-        if count < value.count {
+        guard count >= offset + marker.count else {
             return false
         }
+        return marker.indices.allSatisfy { self[offset + $0] == marker[$0] }
+    }
 
-        let header = headerData(with: value.count)
+    func bigEndianUInt16(at offset: Int) -> UInt16 {
+        UInt16(self[offset]) << 8 | UInt16(self[offset + 1])
+    }
+
+    func bigEndianUInt32(at offset: Int) -> UInt32 {
+        UInt32(bigEndianUInt16(at: offset)) << 16 | UInt32(bigEndianUInt16(at: offset + 2))
+    }
 
-        return header == value
+    func bigEndianUInt64(at offset: Int) -> UInt64 {
+        UInt64(bigEndianUInt32(at: offset)) << 32 | UInt64(bigEndianUInt32(at: offset + 4))
     }
 
-    func subdata(start: Int, length: Int) -> Data {
-        return subdata(in: start ..< start + length)
+    func littleEndianUInt16(at offset: Int) -> UInt16 {
+        UInt16(self[offset]) | UInt16(self[offset + 1]) << 8
     }
 
-    subscript<UInt16>(range: Range<Data.Index>) -> UInt16 {
-       return subdata(in: range).withUnsafeBytes { $0.load(as: UInt16.self) }
+    func littleEndianUInt24(at offset: Int) -> UInt32 {
+        UInt32(littleEndianUInt16(at: offset)) | UInt32(self[offset + 2]) << 16
     }
 
-    subscript<T>(start: Int, length: Int) -> T {
-        return self[start..<start + length]
+    func littleEndianUInt32(at offset: Int) -> UInt32 {
+        UInt32(littleEndianUInt16(at: offset)) | UInt32(littleEndianUInt16(at: offset + 2)) << 16
     }
 }
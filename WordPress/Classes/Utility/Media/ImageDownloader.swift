@@ -8,8 +8,26 @@ struct ImageRequestOptions {
     var isMemoryCacheEnabled = true
 
     /// If enabled, uses `URLSession` preconfigured with a custom `URLCache`
-    /// with a relatively high disk capacity. By default, `true`.
+    /// with a relatively high disk capacity, and persists resized thumbnails
+    /// in ``ThumbnailDiskCache``. By default, `true`.
     var isDiskCacheEnabled = true
+
+    /// The order in which pending downloads and decodes are started when the
+    /// downloader is at capacity. By default, ``ImageRequestPriority/visible``.
+    var priority: ImageRequestPriority = .visible
+}
+
+enum ImageRequestPriority: Int, Comparable {
+    /// Work that is not tied to anything on screen.
+    case background
+    /// Images that are about to be displayed, e.g. from a prefetch data source.
+    case prefetch
+    /// Images that are currently displayed.
+    case visible
+
+    static func < (lhs: ImageRequestPriority, rhs: ImageRequestPriority) -> Bool {
+        lhs.rawValue < rhs.rawValue
+    }
 }
 
 /// The system that downloads and caches images, and prepares them for display.
@@ -17,6 +35,7 @@ actor ImageDownloader {
     static let shared = ImageDownloader()
 
     private nonisolated let cache: MemoryCacheProtocol
+    private nonisolated let thumbnailCache: ThumbnailDiskCache?
 
     private let urlSession = URLSession {
         $0.urlCache = nil
@@ -32,8 +51,17 @@ actor ImageDownloader {
 
     private var tasks: [String: ImageDataTask] = [:]
 
-    init(cache: MemoryCacheProtocol = MemoryCache.shared) {
+    /// Limits the number of concurrent network requests. Matches the default
+    /// `httpMaximumConnectionsPerHost`.
+    private let fetchLimiter = WorkLimiter(limit: 6)
+
+    /// Limits the number of concurrent decodes, so that a burst of prefetched
+    /// images doesn't occupy every core while the visible ones are waiting.
+    private let decodeLimiter = WorkLimiter(limit: 2)
+
+    init(cache: MemoryCacheProtocol = MemoryCache.shared, thumbnailCache: ThumbnailDiskCache? = .shared) {
         self.cache = cache
+        self.thumbnailCache = thumbnailCache
     }
 
     // MARK: - Images (URL)
@@ -51,11 +79,25 @@ actor ImageDownloader {
         if options.isMemoryCacheEnabled, let image = cache[key] {
             return image
         }
+        let thumbnailCache = options.size != nil && options.isDiskCacheEnabled ? self.thumbnailCache : nil
+        if let thumbnailCache, let image = await cachedThumbnail(forKey: key, in: thumbnailCache) {
+            if options.isMemoryCacheEnabled {
+                cache[key] = image
+            }
+            return image
+        }
         let data = try await data(for: request, options: options)
+
+        // Drop cancelled work before paying for the decode.
+        try Task.checkCancellation()
+        try await acquireSlot(in: decodeLimiter, key: key, priority: options.priority)
+        defer { decodeLimiter.release() }
+
         let image = try await ImageDecoder.makeImage(from: data, size: options.size)
         if options.isMemoryCacheEnabled {
             cache[key] = image
         }
+        thumbnailCache?.store(image, forKey: key)
         return image
     }
 
@@ -94,6 +136,14 @@ actor ImageDownloader {
         cache[makeKey(for: imageURL, size: size)] = image
     }
 
+    /// Reads and decodes the thumbnail off the actor.
+    private nonisolated func cachedThumbnail(forKey key: String, in thumbnailCache: ThumbnailDiskCache) async -> UIImage? {
+        guard let data = thumbnailCache.data(forKey: key) else {
+            return nil
+        }
+        return try? await ImageDecoder.makeImage(from: data)
+    }
+
     private nonisolated func makeKey(for imageURL: URL?, size: CGSize?) -> String {
         guard let imageURL else {
             assertionFailure("The request.url was nil") // This should never happen
@@ -102,13 +152,63 @@ actor ImageDownloader {
         return imageURL.absoluteString + (size.map { "?size=\($0)" } ?? "")
     }
 
+    // MARK: - Scheduling
+
+    /// Changes the priority of the pending download and decode of the given
+    /// image, e.g. when a prefetched cell becomes visible.
+    func setPriority(_ priority: ImageRequestPriority, for imageURL: URL, size: CGSize? = nil) {
+        let requestKey = imageURL.absoluteString
+        tasks[requestKey]?.priority = priority
+        fetchLimiter.setPriority(priority, forKey: requestKey)
+        decodeLimiter.setPriority(priority, forKey: makeKey(for: imageURL, size: size))
+    }
+
+    /// Changes the priority of the pending download and decode of the given
+    /// image authenticated for the given host.
+    ///
+    /// The pending work is found by the URL of the authenticated request, which
+    /// can differ from `imageURL`, e.g. for private sites.
+    func setPriority(_ priority: ImageRequestPriority, for imageURL: URL, host: MediaHost, size: CGSize? = nil) async {
+        guard let request = try? await authenticatedRequest(for: imageURL, host: host), let url = request.url else {
+            return
+        }
+        setPriority(priority, for: url, size: size)
+    }
+
+    private func acquireSlot(in limiter: WorkLimiter, key: String, priority: ImageRequestPriority) async throws {
+        let waiterID = UUID()
+        try Task.checkCancellation()
+        guard !limiter.tryAcquire() else {
+            return
+        }
+        try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { continuation in
+                limiter.enqueue(id: waiterID, key: key, priority: priority, continuation: continuation)
+            }
+        } onCancel: {
+            Task {
+                await self.cancelWaiter(waiterID)
+            }
+        }
+    }
+
+    private func cancelWaiter(_ id: UUID) {
+        fetchLimiter.cancel(id)
+        decodeLimiter.cancel(id)
+    }
+
     // MARK: - Networking
 
     private func data(for request: URLRequest, options: ImageRequestOptions) async throws -> Data {
         let requestKey = request.urlRequest?.url?.absoluteString ?? ""
-        let task = tasks[requestKey] ?? ImageDataTask(task: Task {
+        let task = tasks[requestKey] ?? ImageDataTask(priority: options.priority, task: Task {
             try await self._data(for: request, options: options, key: requestKey)
         })
+        if options.priority > task.priority {
+            // A coalesced request needs the image sooner than the original one.
+            task.priority = options.priority
+            fetchLimiter.setPriority(options.priority, forKey: requestKey)
+        }
         let subscriptionID = UUID()
         task.subscriptions.insert(subscriptionID)
         tasks[requestKey] = task
@@ -134,6 +234,9 @@ actor ImageDownloader {
 
     private func _data(for request: URLRequest, options: ImageRequestOptions, key: String) async throws -> Data {
         defer { tasks[key] = nil }
+        try await acquireSlot(in: fetchLimiter, key: key, priority: tasks[key]?.priority ?? options.priority)
+        defer { fetchLimiter.release() }
+
         let session = options.isDiskCacheEnabled ? urlSessionWithCache : urlSession
         let (data, response) = try await session.data(for: request)
         try validate(response: response)
@@ -153,14 +256,78 @@ actor ImageDownloader {
 private final class ImageDataTask {
     var subscriptions = Set<UUID>()
     var isCancelled = false
+    var priority: ImageRequestPriority
     var task: Task<Data, Error>
 
-    init(subscriptions: Set<UUID> = Set<UUID>(), task: Task<Data, Error>) {
+    init(subscriptions: Set<UUID> = Set<UUID>(), priority: ImageRequestPriority = .visible, task: Task<Data, Error>) {
         self.subscriptions = subscriptions
+        self.priority = priority
         self.task = task
     }
 }
 
+/// Limits the number of concurrent operations and starts the pending ones in
+/// the order of their priority (first in, first out for equal priorities).
+///
+/// - warning: The type is not thread-safe and must only be used from within
+/// the ``ImageDownloader`` actor.
+private final class WorkLimiter {
+    private struct Waiter {
+        let id: UUID
+        let key: String
+        var priority: ImageRequestPriority
+        let continuation: CheckedContinuation<Void, Error>
+    }
+
+    private let limit: Int
+    private var running = 0
+    private var waiters: [Waiter] = []
+
+    init(limit: Int) {
+        self.limit = limit
+    }
+
+    /// Takes a slot if one is available.
+    func tryAcquire() -> Bool {
+        guard running < limit else {
+            return false
+        }
+        running += 1
+        return true
+    }
+
+    /// Adds an operation waiting for a slot. The continuation is resumed once
+    /// a slot is handed over to it by ``release()``.
+    func enqueue(id: UUID, key: String, priority: ImageRequestPriority, continuation: CheckedContinuation<Void, Error>) {
+        waiters.append(Waiter(id: id, key: key, priority: priority, continuation: continuation))
+    }
+
+    /// Frees a slot and hands it to the pending operation with the highest
+    /// priority.
+    func release() {
+        running -= 1
+        guard let index = waiters.indices.max(by: { waiters[$0].priority < waiters[$1].priority || (waiters[$0].priority == waiters[$1].priority && $0 > $1) }) else {
+            return
+        }
+        let waiter = waiters.remove(at: index)
+        running += 1
+        waiter.continuation.resume()
+    }
+
+    func setPriority(_ priority: ImageRequestPriority, forKey key: String) {
+        for index in waiters.indices where waiters[index].key == key {
+            waiters[index].priority = priority
+        }
+    }
+
+    func cancel(_ id: UUID) {
+        guard let index = waiters.firstIndex(where: { $0.id == id }) else {
+            return
+        }
+        waiters.remove(at: index).continuation.resume(throwing: CancellationError())
+    }
+}
+
 // MARK: - ImageDownloader (Closures)
 
 extension ImageDownloader {
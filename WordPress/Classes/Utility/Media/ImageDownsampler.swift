@@ -0,0 +1,68 @@
+import Foundation
+import ImageIO
+import UniformTypeIdentifiers
+
+/// Creates smaller JPEG versions of images without decoding them at full size.
+///
+/// The image is decoded straight to the target size by ImageIO, and the result is
+/// encoded directly to the destination file, so the memory used is proportional to
+/// the size of the output rather than to the size of the original photo. This matters
+/// in the share extension, which has a much lower memory limit than the app.
+///
+/// The EXIF orientation is applied to the pixels, so the output is always `.up`.
+///
+enum ImageDownsampler {
+    enum Error: Swift.Error {
+        case cannotReadImage
+        case cannotWriteImage
+    }
+
+    /// Writes a JPEG version of the image at `url` to `destinationURL`.
+    ///
+    /// - parameter maxPixelSize: The maximum width and height of the output, in pixels. Smaller images aren't upscaled.
+    static func downsampleImage(at url: URL, to destinationURL: URL, maxPixelSize: Int, compressionQuality: CGFloat = 0.8) throws {
+        guard let source = CGImageSourceCreateWithURL(url as CFURL, sourceOptions) else {
+            throw Error.cannotReadImage
+        }
+        try downsample(source, to: destinationURL, maxPixelSize: maxPixelSize, compressionQuality: compressionQuality)
+    }
+
+    /// Writes a JPEG version of the encoded image to `destinationURL`.
+    ///
+    /// - parameter maxPixelSize: The maximum width and height of the output, in pixels. Smaller images aren't upscaled.
+    static func downsampleImage(from data: Data, to destinationURL: URL, maxPixelSize: Int, compressionQuality: CGFloat = 0.8) throws {
+        guard let source = CGImageSourceCreateWithData(data as CFData, sourceOptions) else {
+            throw Error.cannotReadImage
+        }
+        try downsample(source, to: destinationURL, maxPixelSize: maxPixelSize, compressionQuality: compressionQuality)
+    }
+
+    // MARK: - Private
+
+    /// The full-size image is never cached.
+    private static let sourceOptions = [kCGImageSourceShouldCache: false] as CFDictionary
+
+    private static func downsample(_ source: CGImageSource, to destinationURL: URL, maxPixelSize: Int, compressionQuality: CGFloat) throws {
+        let thumbnailOptions: [CFString: Any] = [
+            kCGImageSourceCreateThumbnailFromImageAlways: true,
+            kCGImageSourceCreateThumbnailWithTransform: true,
+            kCGImageSourceShouldCacheImmediately: true,
+            kCGImageSourceThumbnailMaxPixelSize: maxPixelSize
+        ]
+        guard let image = CGImageSourceCreateThumbnailAtIndex(source, 0, thumbnailOptions as CFDictionary) else {
+            throw Error.cannotReadImage
+        }
+
+        guard let destination = CGImageDestinationCreateWithURL(destinationURL as CFURL, UTType.jpeg.identifier as CFString, 1, nil) else {
+            throw Error.cannotWriteImage
+        }
+        let destinationOptions: [CFString: Any] = [
+            kCGImageDestinationLossyCompressionQuality: compressionQuality,
+            kCGImagePropertyOrientation: CGImagePropertyOrientation.up.rawValue
+        ]
+        CGImageDestinationAddImage(destination, image, destinationOptions as CFDictionary)
+        guard CGImageDestinationFinalize(destination) else {
+            throw Error.cannotWriteImage
+        }
+    }
+}
@@ -0,0 +1,164 @@
+import Foundation
+
+/// A least-recently-used cache that keeps the total cost of its entries under
+/// ``costLimit``, evicting the least recently used entries first.
+///
+/// - note: The type is thread-safe.
+final class LRUCache<Key: Hashable, Value>: @unchecked Sendable {
+    struct Metrics: CustomStringConvertible {
+        var hits = 0
+        var misses = 0
+
+        var hitRate: Double {
+            hits + misses == 0 ? 0 : Double(hits) / Double(hits + misses)
+        }
+
+        var description: String {
+            "hits: \(hits), misses: \(misses), hit rate: \(String(format: "%.2f", hitRate))"
+        }
+    }
+
+    private final class Node {
+        let key: Key
+        var value: Value
+        var cost: Int
+        var next: Node?
+        weak var previous: Node?
+
+        init(key: Key, value: Value, cost: Int) {
+            self.key = key
+            self.value = value
+            self.cost = cost
+        }
+    }
+
+    let costLimit: Int
+
+    private var nodes: [Key: Node] = [:]
+    private var head: Node? // Most recently used
+    private var tail: Node? // Least recently used
+    private var _totalCost = 0
+    private var _metrics = Metrics()
+    private let lock = NSLock()
+
+    init(costLimit: Int) {
+        self.costLimit = costLimit
+    }
+
+    var totalCost: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return _totalCost
+    }
+
+    var metrics: Metrics {
+        lock.lock()
+        defer { lock.unlock() }
+        return _metrics
+    }
+
+    func value(forKey key: Key) -> Value? {
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard let node = nodes[key] else {
+            _metrics.misses += 1
+            return nil
+        }
+        _metrics.hits += 1
+        moveToHead(node)
+        return node.value
+    }
+
+    /// Adds the value to the cache. Values that cost more than the whole
+    /// ``costLimit`` are not stored.
+    func setValue(_ value: Value, forKey key: Key, cost: Int) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        removeNode(forKey: key)
+        guard cost <= costLimit else {
+            return
+        }
+        let node = Node(key: key, value: value, cost: cost)
+        nodes[key] = node
+        insertAtHead(node)
+        _totalCost += cost
+        _trim(toCost: costLimit)
+    }
+
+    func removeValue(forKey key: Key) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        removeNode(forKey: key)
+    }
+
+    func removeAll() {
+        lock.lock()
+        defer { lock.unlock() }
+
+        nodes.removeAll()
+        head = nil
+        tail = nil
+        _totalCost = 0
+    }
+
+    /// Evicts the least recently used entries until the total cost is at or
+    /// below the given cost.
+    func trim(toCost cost: Int) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        _trim(toCost: cost)
+    }
+
+    // MARK: - Private (Requires Lock)
+
+    private func _trim(toCost cost: Int) {
+        while _totalCost > cost, let node = tail {
+            removeNode(forKey: node.key)
+        }
+    }
+
+    private func removeNode(forKey key: Key) {
+        guard let node = nodes.removeValue(forKey: key) else {
+            return
+        }
+        unlink(node)
+        _totalCost -= node.cost
+    }
+
+    private func moveToHead(_ node: Node) {
+        guard head !== node else {
+            return
+        }
+        unlink(node)
+        insertAtHead(node)
+    }
+
+    private func insertAtHead(_ node: Node) {
+        node.next = head
+        node.previous = nil
+        head?.previous = node
+        head = node
+        if tail == nil {
+            tail = node
+        }
+    }
+
+    private func unlink(_ node: Node) {
+        let previous = node.previous
+        let next = node.next
+        previous?.next = next
+        next?.previous = previous
+        if head === node {
+            head = next
+        }
+        if tail === node {
+            tail = previous
+        }
+        node.next = nil
+        node.previous = nil
+    }
+}
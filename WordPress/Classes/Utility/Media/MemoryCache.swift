@@ -6,21 +6,63 @@ protocol MemoryCacheProtocol: AnyObject {
     subscript(key: String) -> UIImage? { get set }
 }
 
-/// - note: The type is thread-safe because it uses thread-safe `NSCache`.
+/// A tiered in-memory cache: decoded bitmaps and compressed image data are
+/// kept in separate byte-budgeted LRU caches, so that a burst of large GIFs
+/// can't evict the bitmaps currently on screen and vice versa.
+///
+/// - note: The type is thread-safe because it uses thread-safe `LRUCache`.
 final class MemoryCache: MemoryCacheProtocol, @unchecked Sendable {
     /// A shared image cache used by the entire system.
     static let shared = MemoryCache()
 
-    private let cache = NSCache<NSString, AnyObject>()
+    struct Metrics: CustomStringConvertible {
+        let images: LRUCache<String, UIImage>.Metrics
+        let data: LRUCache<String, Data>.Metrics
 
-    private init() {
-        self.cache.totalCostLimit = 256_000_000 // 256 MB
+        var description: String {
+            "images: (\(images)), data: (\(data))"
+        }
+    }
+
+    /// Decoded bitmaps, accounted by the exact size of their pixel buffers.
+    private let images: LRUCache<String, UIImage>
+
+    /// Compressed image data, such as GIFs.
+    private let data: LRUCache<String, Data>
+
+    private let lock = NSLock()
+    private var lastMemoryWarningDate: Date?
+
+    var metrics: Metrics {
+        Metrics(images: images.metrics, data: data.metrics)
+    }
+
+    init(imageCostLimit: Int = 192 * 1024 * 1024, dataCostLimit: Int = 64 * 1024 * 1024) {
+        self.images = LRUCache(costLimit: imageCostLimit)
+        self.data = LRUCache(costLimit: dataCostLimit)
 
         NotificationCenter.default.addObserver(self, selector: #selector(didReceiveMemoryWarning), name: UIApplication.didReceiveMemoryWarningNotification, object: nil)
     }
 
-    @objc private func didReceiveMemoryWarning() {
-        cache.removeAllObjects()
+    /// Trims the cache in stages. The first warning drops the least recently
+    /// used half of the bitmaps, which can be decoded again cheaply. Only a
+    /// second warning in quick succession drops the rest of the bitmaps and
+    /// most of the compressed data.
+    @objc func didReceiveMemoryWarning() {
+        lock.lock()
+        let now = Date()
+        let isRepeated = lastMemoryWarningDate.map { now.timeIntervalSince($0) < Constants.repeatedWarningInterval } ?? false
+        lastMemoryWarningDate = now
+        lock.unlock()
+
+        if isRepeated {
+            images.removeAll()
+            data.trim(toCost: data.totalCost / 4)
+        } else {
+            images.trim(toCost: images.totalCost / 2)
+            data.trim(toCost: data.totalCost * 3 / 4)
+        }
+        DDLogInfo("MemoryCache: trimmed after a memory warning (\(metrics))")
     }
 
     // MARK: - UIImage
@@ -39,39 +81,53 @@ final class MemoryCache: MemoryCacheProtocol, @unchecked Sendable {
     }
 
     func setImage(_ image: UIImage, forKey key: String) {
-        cache.setObject(image, forKey: key as NSString, cost: image.cost)
+        images.setValue(image, forKey: key, cost: image.cost)
     }
 
     func getImage(forKey key: String) -> UIImage? {
-        cache.object(forKey: key as NSString) as? UIImage
+        images.value(forKey: key)
     }
 
     func removeImage(forKey key: String) {
-        cache.removeObject(forKey: key as NSString)
+        images.removeValue(forKey: key)
     }
 
     // MARK: - Data
 
     func setData(_ data: Data, forKey key: String) {
-        cache.setObject(data as NSData, forKey: key as NSString, cost: data.count)
+        self.data.setValue(data, forKey: key, cost: data.count)
     }
 
     func geData(forKey key: String) -> Data? {
-        cache.object(forKey: key as NSString) as? Data
+        data.value(forKey: key)
     }
 
     func removeData(forKey key: String) {
-        cache.removeObject(forKey: key as NSString)
+        data.removeValue(forKey: key)
+    }
+
+    private enum Constants {
+        static let repeatedWarningInterval: TimeInterval = 10
     }
 }
 
 private extension UIImage {
-    /// Returns a rought estimation of how much space the image takes in memory.
+    /// Returns the number of bytes taken by the decoded image, including every
+    /// frame of an animated image and the GIF data retained by ``AnimatedImage``.
     var cost: Int {
         let dataCost = (self as? AnimatedImage)?.gifData?.count ?? 0
-        let imageCost = cgImage.map { $0.bytesPerRow * $0.height } ?? 0
+        let frames = images ?? [self]
+        let imageCost = frames.reduce(0) { $0 + $1.bitmapCost }
         return dataCost + imageCost
     }
+
+    private var bitmapCost: Int {
+        if let cgImage {
+            return cgImage.bytesPerRow * cgImage.height
+        }
+        // Not backed by a bitmap yet (e.g. `CIImage`), assume 4 bytes per pixel.
+        return Int(size.width * scale) * Int(size.height * scale) * 4
+    }
 }
 
 extension MemoryCache {
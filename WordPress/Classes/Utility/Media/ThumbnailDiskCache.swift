@@ -0,0 +1,139 @@
+import UIKit
+import CryptoKit
+
+/// Persists downscaled thumbnails, so that they survive memory pressure and
+/// relaunches without being downloaded and downscaled again.
+///
+/// - note: The type is thread-safe. Writes happen on a background queue.
+final class ThumbnailDiskCache: NSObject, @unchecked Sendable {
+    static let shared = ThumbnailDiskCache(name: "org.automattic.ImageDownloader.Thumbnails")
+
+    /// The cache is trimmed down to this size, removing the least recently
+    /// written thumbnails first.
+    let sizeLimit: Int
+
+    private let directoryURL: URL?
+    private let queue = DispatchQueue(label: "org.automattic.ThumbnailDiskCache", qos: .utility)
+    private let lock = NSLock()
+    private var _metrics = LRUCache<String, Data>.Metrics()
+    private var writesSinceLastSweep = 0
+
+    var metrics: LRUCache<String, Data>.Metrics {
+        lock.lock()
+        defer { lock.unlock() }
+        return _metrics
+    }
+
+    init(name: String, sizeLimit: Int = 128 * 1024 * 1024) {
+        self.sizeLimit = sizeLimit
+        let cachesURL = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first
+        let directoryURL = cachesURL?.appendingPathComponent(name, isDirectory: true)
+        if let directoryURL {
+            try? FileManager.default.createDirectory(at: directoryURL, withIntermediateDirectories: true)
+        }
+        self.directoryURL = directoryURL
+        super.init()
+    }
+
+    /// Removes the thumbnails of the shared cache, e.g. on logout, since they
+    /// can include the media of private sites.
+    @objc class func clearCaches() {
+        shared.removeAll()
+    }
+
+    func data(forKey key: String) -> Data? {
+        let data = fileURL(forKey: key).flatMap { try? Data(contentsOf: $0) }
+
+        lock.lock()
+        if data != nil {
+            _metrics.hits += 1
+        } else {
+            _metrics.misses += 1
+        }
+        lock.unlock()
+
+        return data
+    }
+
+    /// Encodes the thumbnail and writes it to disk in the background.
+    func store(_ image: UIImage, forKey key: String) {
+        guard !(image is AnimatedImage), let url = fileURL(forKey: key) else {
+            return
+        }
+        queue.async {
+            guard let data = image.encodedThumbnailData else {
+                return
+            }
+            try? data.write(to: url, options: .atomic)
+
+            self.writesSinceLastSweep += 1
+            if self.writesSinceLastSweep >= Constants.writesBetweenSweeps {
+                self.writesSinceLastSweep = 0
+                self.sweep()
+            }
+        }
+    }
+
+    /// Removes all the thumbnails in the background, after the pending writes.
+    ///
+    /// - parameter completion: Called on a background queue once the thumbnails are removed.
+    func removeAll(completion: (() -> Void)? = nil) {
+        queue.async {
+            if let directoryURL = self.directoryURL {
+                let urls = (try? FileManager.default.contentsOfDirectory(at: directoryURL, includingPropertiesForKeys: nil)) ?? []
+                for url in urls {
+                    try? FileManager.default.removeItem(at: url)
+                }
+            }
+            completion?()
+        }
+    }
+
+    // MARK: - Private
+
+    private func fileURL(forKey key: String) -> URL? {
+        let name = SHA256.hash(data: Data(key.utf8))
+            .compactMap { String(format: "%02x", $0) }
+            .joined()
+        return directoryURL?.appendingPathComponent(name)
+    }
+
+    /// Removes the oldest files once the directory grows over ``sizeLimit``.
+    private func sweep() {
+        guard let directoryURL else {
+            return
+        }
+        let keys: Set<URLResourceKey> = [.contentModificationDateKey, .totalFileAllocatedSizeKey]
+        let urls = (try? FileManager.default.contentsOfDirectory(at: directoryURL, includingPropertiesForKeys: Array(keys))) ?? []
+        var files = urls.compactMap { url -> (url: URL, date: Date, size: Int)? in
+            guard let values = try? url.resourceValues(forKeys: keys) else {
+                return nil
+            }
+            return (url, values.contentModificationDate ?? .distantPast, values.totalFileAllocatedSize ?? 0)
+        }
+        var totalSize = files.reduce(0) { $0 + $1.size }
+        guard totalSize > sizeLimit else {
+            return
+        }
+        files.sort { $0.date < $1.date }
+        for file in files where totalSize > sizeLimit * 3 / 4 {
+            try? FileManager.default.removeItem(at: file.url)
+            totalSize -= file.size
+        }
+    }
+
+    private enum Constants {
+        static let writesBetweenSweeps = 64
+    }
+}
+
+private extension UIImage {
+    var encodedThumbnailData: Data? {
+        switch cgImage?.alphaInfo ?? .premultipliedLast {
+        case .none, .noneSkipFirst, .noneSkipLast:
+            return jpegData(compressionQuality: 0.8)
+        default:
+            return pngData()
+        }
+    }
+}
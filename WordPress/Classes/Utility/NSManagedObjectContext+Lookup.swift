@@ -0,0 +1,152 @@
+import CoreData
+
+extension NSManagedObjectContext {
+
+    /// Retrieves the object identified by a natural key, such as a comment ID within a post.
+    ///
+    /// The object IDs found are cached by the context, so looking up the same key again
+    /// doesn't need a fetch. A cached object is checked against the predicate before being
+    /// returned, and the objects deleted or updated by a save are dropped from the cache.
+    ///
+    /// - Parameters:
+    ///   - type: Type of the Entity
+    ///   - key: The natural key of the object, e.g. `[post.objectID, commentID]`.
+    ///   - predicate: A predicate matching the object with the given key.
+    ///
+    func lookup<T: NSManagedObject>(_ type: T.Type, key: AnyHashable, matching predicate: NSPredicate) -> T? {
+        let cacheKey = LookupCache.Key(entityName: T.entityName(), naturalKey: key)
+        if let objectID = lookupCache.objectIDs[cacheKey] {
+            if let object = try? existingObject(with: objectID) as? T, !object.isDeleted, predicate.evaluate(with: object) {
+                return object
+            }
+            lookupCache.objectIDs[cacheKey] = nil
+        }
+
+        let request = NSFetchRequest<T>(entityName: T.entityName())
+        request.predicate = predicate
+        request.fetchLimit = 1
+        FetchIndexAudit.check(request, in: self)
+
+        guard let object = (try? fetch(request))?.first else {
+            return nil
+        }
+        // Temporary IDs change once the object is saved.
+        if !object.objectID.isTemporaryID {
+            lookupCache.objectIDs[cacheKey] = object.objectID
+        }
+        return object
+    }
+
+    private var lookupCache: LookupCache {
+        if let cache = objc_getAssociatedObject(self, NSManagedObjectContext.lookupCacheKey) as? LookupCache {
+            return cache
+        }
+        let cache = LookupCache(context: self)
+        objc_setAssociatedObject(self, NSManagedObjectContext.lookupCacheKey, cache, .OBJC_ASSOCIATION_RETAIN_NONATOMIC)
+        return cache
+    }
+
+    private static let lookupCacheKey = malloc(1)!
+}
+
+/// Object IDs by natural key, for a single context. It's only accessed on the context's queue.
+private final class LookupCache {
+    struct Key: Hashable {
+        let entityName: String
+        let naturalKey: AnyHashable
+    }
+
+    var objectIDs: [Key: NSManagedObjectID] = [:]
+
+    private var observer: NSObjectProtocol?
+
+    init(context: NSManagedObjectContext) {
+        observer = NotificationCenter.default.addObserver(forName: NSManagedObjectContext.didSaveObjectIDsNotification, object: context, queue: nil) { [weak self] notification in
+            self?.invalidate(with: notification)
+        }
+    }
+
+    deinit {
+        if let observer {
+            NotificationCenter.default.removeObserver(observer)
+        }
+    }
+
+    private func invalidate(with notification: Notification) {
+        guard !objectIDs.isEmpty else {
+            return
+        }
+        let keys: [NSManagedObjectContext.NotificationKey] = [.deletedObjectIDs, .updatedObjectIDs]
+        let changedObjectIDs = keys.reduce(into: Set<NSManagedObjectID>()) { result, key in
+            result.formUnion(notification.userInfo?[key.rawValue] as? Set<NSManagedObjectID> ?? [])
+        }
+        guard !changedObjectIDs.isEmpty else {
+            return
+        }
+        objectIDs = objectIDs.filter { !changedObjectIDs.contains($0.value) }
+    }
+}
+
+/// Reports fetches that none of the entity's indexes can be used for, which means
+/// that SQLite has to scan the whole table to find the results.
+///
+/// A fetch can use an index if its predicate tests the first property of the index
+/// for equality, or checks it against a list of values.
+///
+/// It checks the fetches made with `lookup(_:key:matching:)` and the `NSManagedObjectContext`
+/// helpers in `CoreDataHelper.swift`, such as `firstObject(ofType:matching:)`.
+///
+enum FetchIndexAudit {
+
+    /// Logs a warning if the fetch request has to scan the table. Debug builds only.
+    static func check<T>(_ request: NSFetchRequest<T>, in context: NSManagedObjectContext) {
+#if DEBUG
+        guard let predicate = request.predicate,
+              let entity = request.entity ?? request.entityName.flatMap({ NSEntityDescription.entity(forEntityName: $0, in: context) }),
+              !isIndexed(predicate, for: entity) else {
+            return
+        }
+        DDLogWarn("Fetching \(entity.name ?? "") matching \(predicate) scans the table: none of its indexes can be used")
+#endif
+    }
+
+    static func isIndexed(_ predicate: NSPredicate, for entity: NSEntityDescription) -> Bool {
+        let keys = indexableKeys(in: predicate)
+        if keys.contains("SELF") {
+            return true
+        }
+
+        var entity: NSEntityDescription? = entity
+        while let current = entity {
+            let leadingKeys = current.indexes.compactMap { $0.elements.first?.propertyName }
+            if leadingKeys.contains(where: keys.contains) {
+                return true
+            }
+            entity = current.superentity
+        }
+        return false
+    }
+
+    /// The key paths tested for equality by all the results of the predicate.
+    private static func indexableKeys(in predicate: NSPredicate) -> Set<String> {
+        switch predicate {
+        case let predicate as NSCompoundPredicate where predicate.compoundPredicateType == .and:
+            return predicate.subpredicates.reduce(into: Set<String>()) { keys, subpredicate in
+                if let subpredicate = subpredicate as? NSPredicate {
+                    keys.formUnion(indexableKeys(in: subpredicate))
+                }
+            }
+        case let predicate as NSComparisonPredicate where [.equalTo, .in].contains(predicate.predicateOperatorType):
+            switch predicate.leftExpression.expressionType {
+            case .evaluatedObject:
+                return ["SELF"]
+            case .keyPath:
+                return [predicate.leftExpression.keyPath]
+            default:
+                return []
+            }
+        default:
+            return []
+        }
+    }
+}
@@ -5,7 +5,7 @@ struct StringRankedSearch {
     var options: String.CompareOptions = [.caseInsensitive, .diacriticInsensitive]
 
     private let term: String
-    private let terms: [String]
+    let terms: [String]
 
     init(searchTerm: String) {
         self.term = searchTerm.trimmingCharacters(in: .whitespaces)
@@ -18,10 +18,11 @@ struct StringRankedSearch {
         guard let string else {
             return 0
         }
-        let words = string
-            .trimmingCharacters(in: .whitespaces)
-            .components(separatedBy: .whitespaces)
-            .filter { !$0.isEmpty }
+        return score(for: string, words: StringRankedSearch.words(in: string))
+    }
+
+    /// Returns the score for a string already split with `words(in:)`.
+    func score(for string: String, words: [String]) -> Double {
         guard !words.isEmpty else {
             return 0
         }
@@ -45,6 +46,13 @@ struct StringRankedSearch {
         (0.025 * bonusForCountMatch)
     }
 
+    static func words(in string: String) -> [String] {
+        string
+            .trimmingCharacters(in: .whitespaces)
+            .components(separatedBy: .whitespaces)
+            .filter { !$0.isEmpty }
+    }
+
     private func bonusForDistanceBetweenMatches(_ indices: [Int], words: [String]) -> Double {
         let distance = zip(indices.dropLast(), indices.dropFirst())
             .map { $1 - $0 }
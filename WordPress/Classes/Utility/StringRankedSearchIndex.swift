@@ -0,0 +1,220 @@
+import Foundation
+
+/// Finds the items matching a search term without scoring every item.
+///
+/// The searchable string of each item is split into words and folded (case
+/// and diacritics) once, when the item is added. The index maps every character
+/// to the items that contain it. On search, it only keeps the items that contain
+/// the characters of the search terms in the same order, which `StringRankedSearch`
+/// requires for a match, and scores those with `StringRankedSearch`.
+///
+/// It finds the same items as `StringRankedSearch.search(in:minScore:input:)`. The
+/// items with the same score are returned in the order set with `setOrder(_:)`, or
+/// in the order they were added.
+struct StringRankedSearchIndex<Element: Identifiable> {
+    private struct Entry {
+        let element: Element
+        let string: String
+        let words: [String]
+        /// The folded words, or `nil` if the string isn't ASCII once folded.
+        let foldedWords: [[UInt8]]?
+        /// The position of the item, used for the items with the same score.
+        var order: Int
+    }
+
+    private let input: (Element) -> String
+    private var entries: [Entry?] = []
+    private var slotsByID: [Element.ID: Int] = [:]
+    private var freeSlots: [Int] = []
+    private var nextOrder = 0
+
+    /// The slots of the items containing each character.
+    private var postings: [UInt8: Set<Int>] = [:]
+    /// The slots of the items which the folded characters can't be used for, and which are always scored.
+    private var unindexed: Set<Int> = []
+
+    /// - parameter input: Returns the input for the search algorithm to match against.
+    init(input: @escaping (Element) -> String) {
+        self.input = input
+    }
+
+    init<S: Sequence>(_ items: S, input: @escaping (Element) -> String) where S.Element == Element {
+        self.init(input: input)
+        for item in items {
+            insert(item)
+        }
+    }
+
+    var count: Int {
+        slotsByID.count
+    }
+
+    /// The IDs of the indexed items.
+    var ids: Dictionary<Element.ID, Int>.Keys {
+        slotsByID.keys
+    }
+
+    /// Adds the item, or replaces the item with the same ID.
+    mutating func insert(_ element: Element) {
+        let string = input(element)
+        if let slot = slotsByID[element.id], let entry = entries[slot], entry.string == string {
+            entries[slot] = Entry(element: element, string: string, words: entry.words, foldedWords: entry.foldedWords, order: entry.order)
+            return
+        }
+        remove(id: element.id)
+
+        let words = StringRankedSearch.words(in: string)
+        let foldedWords = StringRankedSearchIndex.fold(words)
+        let slot = freeSlots.popLast() ?? entries.count
+        if slot == entries.count {
+            entries.append(nil)
+        }
+        entries[slot] = Entry(element: element, string: string, words: words, foldedWords: foldedWords, order: nextOrder)
+        slotsByID[element.id] = slot
+        nextOrder += 1
+
+        if let foldedWords {
+            for character in Set(foldedWords.joined()) {
+                postings[character, default: []].insert(slot)
+            }
+        } else {
+            unindexed.insert(slot)
+        }
+    }
+
+    mutating func remove(id: Element.ID) {
+        guard let slot = slotsByID.removeValue(forKey: id), let entry = entries[slot] else {
+            return
+        }
+        if let foldedWords = entry.foldedWords {
+            for character in Set(foldedWords.joined()) {
+                postings[character]?.remove(slot)
+                if postings[character]?.isEmpty == true {
+                    postings[character] = nil
+                }
+            }
+        } else {
+            unindexed.remove(slot)
+        }
+        entries[slot] = nil
+        freeSlots.append(slot)
+    }
+
+    /// Sets the order of the items with the same score to the order of the IDs.
+    /// The items that aren't listed come after, in the order they were added.
+    mutating func setOrder<S: Sequence>(_ ids: S) where S.Element == Element.ID {
+        var listedSlots: Set<Int> = []
+        for id in ids {
+            if let slot = slotsByID[id], listedSlots.insert(slot).inserted {
+                entries[slot]?.order = listedSlots.count - 1
+            }
+        }
+        for slot in entries.indices where !listedSlots.contains(slot) {
+            entries[slot]?.order += listedSlots.count
+        }
+        nextOrder += listedSlots.count
+    }
+
+    /// Returns the top matching items.
+    func search(_ searchTerm: String, minScore: Double = 0.7) -> [Element] {
+        let search = StringRankedSearch(searchTerm: searchTerm)
+        guard !search.terms.isEmpty else {
+            return []
+        }
+
+        return candidates(for: search, minScore: minScore)
+            .compactMap { entry -> (Entry, Double)? in
+                let score = search.score(for: entry.string, words: entry.words)
+                guard score > minScore else { return nil }
+                return (entry, score)
+            }
+            .sorted { $0.1 == $1.1 ? $0.0.order < $1.0.order : $0.1 > $1.1 }
+            .map(\.0.element)
+    }
+
+    // MARK: - Private
+
+    /// Returns the items that can have a score above `minScore`.
+    private func candidates(for search: StringRankedSearch, minScore: Double) -> [Entry] {
+        // A term only matches a word if all of its characters, except for the
+        // last one, are found in the word in the same order.
+        let patterns = search.terms.map { StringRankedSearchIndex.fold(String($0.dropLast())) }
+
+        // The score is 0.9 times the average of the scores of the terms with up to
+        // `0.05 + 0.000625 * count²` in bonuses. A matching term scores up to 1.0, and
+        // one that doesn't match still gets up to 0.1 for its length, so with `m`
+        // matches the score is at most `0.9 * (0.9 * m + 0.1 * count) / count + maxBonus`.
+        let count = Double(patterns.count)
+        let maxBonus = 0.05 + 0.000625 * count * count
+        let requiredMatches = max(0, Int((((minScore - maxBonus) * count / 0.9 - 0.1 * count) / 0.9).rounded(.down)) + 1)
+        guard requiredMatches > 0 else {
+            return entries.compactMap { $0 }
+        }
+
+        // Patterns that aren't ASCII once folded match any item.
+        let indexedPatterns = patterns.compactMap { $0 }.filter { !$0.isEmpty }
+        let alwaysMatchingPatterns = patterns.count - indexedPatterns.count
+        guard alwaysMatchingPatterns < requiredMatches else {
+            return entries.compactMap { $0 }
+        }
+
+        var slots: Set<Int> = []
+        for pattern in indexedPatterns {
+            slots.formUnion(indexedSlots(containing: pattern))
+        }
+        slots.formUnion(unindexed)
+
+        return slots.compactMap { slot -> Entry? in
+            guard let entry = entries[slot] else {
+                return nil
+            }
+            guard let foldedWords = entry.foldedWords else {
+                return entry
+            }
+            let matches = indexedPatterns.filter { pattern in
+                foldedWords.contains { StringRankedSearchIndex.isSubsequence(pattern, of: $0) }
+            }
+            return alwaysMatchingPatterns + matches.count >= requiredMatches ? entry : nil
+        }
+    }
+
+    /// Returns the indexed items containing all the characters of the pattern.
+    private func indexedSlots(containing pattern: [UInt8]) -> Set<Int> {
+        let sets = Set(pattern).map { postings[$0] ?? [] }.sorted { $0.count < $1.count }
+        guard var result = sets.first else {
+            return []
+        }
+        for set in sets.dropFirst() where !result.isEmpty {
+            result.formIntersection(set)
+        }
+        return result
+    }
+
+    private static func isSubsequence(_ pattern: [UInt8], of word: [UInt8]) -> Bool {
+        var index = pattern.startIndex
+        for character in word where index < pattern.endIndex && character == pattern[index] {
+            index += 1
+        }
+        return index == pattern.endIndex
+    }
+
+    private static func fold(_ words: [String]) -> [[UInt8]]? {
+        var result: [[UInt8]] = []
+        result.reserveCapacity(words.count)
+        for word in words {
+            guard let folded = fold(word) else {
+                return nil
+            }
+            result.append(folded)
+        }
+        return result
+    }
+
+    /// Returns the lowercased ASCII characters of the string without diacritics,
+    /// or `nil` if other characters remain.
+    private static func fold(_ string: String) -> [UInt8]? {
+        let folded = string.folding(options: [.caseInsensitive, .diacriticInsensitive], locale: nil)
+        let characters = Array(folded.utf8)
+        return characters.allSatisfy { $0 < 0x80 } ? characters : nil
+    }
+}
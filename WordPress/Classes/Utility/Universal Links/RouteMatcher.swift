@@ -3,12 +3,31 @@ import Foundation
 /// RouterMatcher finds URL routes with paths that match the path of a specified URL,
 /// and attempts to extract URL components for any placeholders present in the route.
 ///
+/// The routes are compiled once into a trie of path components, so finding the
+/// routes matching a URL only visits the components of the URL's path rather
+/// than every route.
+///
 class RouteMatcher {
     let routes: [Route]
 
+    private let root = Node()
+    private let compiledRoutes: [CompiledRoute]
+    /// The indexes of the routes by path, for the routes matching a URL with the same path.
+    private let routeIndexesByPath: [String: [Int]]
+
     /// - parameter routes: A collection of routes to match against.
     init(routes: [Route]) {
         self.routes = routes
+        self.compiledRoutes = routes.map { CompiledRoute(components: $0.components) }
+        self.routeIndexesByPath = Dictionary(grouping: routes.indices, by: { routes[$0].path })
+
+        for (index, route) in compiledRoutes.enumerated() {
+            var node = root
+            for component in route.components {
+                node = node.child(for: component)
+            }
+            node.routeIndexes.append(index)
+        }
     }
 
     /// Finds routes that match the specified URL's path. If any of the matching routes
@@ -19,32 +38,32 @@ class RouteMatcher {
     ///          path to match of `/me/account/alice`, a matched route will
     ///          be returned with a values dictionary containing ["username": "alice"].
     ///
+    /// The routes are returned in the order they were passed to `init(routes:)`.
+    ///
     /// - parameter url: A URL to match against this matcher's routes collection.
     /// - returns: A collection of MatchedRoutes whose paths match `path`.
     ///
     func routesMatching(_ url: URL) -> [MatchedRoute] {
+        let path = url.path
         let pathComponents = url.pathComponents
 
-        return routes.compactMap({ route in
-            let values = valuesDictionary(forURL: url)
-
-            // If the paths are the same, we definitely have a match
-            if route.path == url.path {
-                return route.matched(with: values)
-            }
+        var routeIndexes = Set(routeIndexesByPath[path] ?? [])
+        collectRouteIndexes(matching: pathComponents[...], from: root, into: &routeIndexes)
+        guard !routeIndexes.isEmpty else {
+            return []
+        }
 
-            let routeComponents = route.components
+        let values = valuesDictionary(forURL: url)
 
-            // Ensure the paths have the same number of components
-            guard routeComponents.count == pathComponents.count else {
-                return nil
-            }
+        return routeIndexes.sorted().compactMap { index in
+            let route = routes[index]
 
-            guard let placeholderValues = placeholderDictionary(forKeyComponents: routeComponents,
-                                                                valueComponents: pathComponents) else {
-                                                                    return nil
+            // If the paths are the same, we definitely have a match
+            if route.path == path {
+                return route.matched(with: values)
             }
 
+            let placeholderValues = compiledRoutes[index].placeholderValues(for: pathComponents)
             let allValues = values.merging(placeholderValues,
                                            uniquingKeysWith: { (current, _) in current })
 
@@ -58,7 +77,21 @@ class RouteMatcher {
             }
 
             return route.matched(with: allValues)
-        })
+        }
+    }
+
+    private func collectRouteIndexes(matching components: ArraySlice<String>, from node: Node, into routeIndexes: inout Set<Int>) {
+        guard let component = components.first else {
+            routeIndexes.formUnion(node.routeIndexes)
+            return
+        }
+        let remainingComponents = components.dropFirst()
+        if let child = node.literals[component] {
+            collectRouteIndexes(matching: remainingComponents, from: child, into: &routeIndexes)
+        }
+        if let child = node.placeholder {
+            collectRouteIndexes(matching: remainingComponents, from: child, into: &routeIndexes)
+        }
     }
 
     private func valuesDictionary(forURL url: URL) -> [String: String] {
@@ -86,26 +119,49 @@ class RouteMatcher {
         return urlSource
     }
 
-    private func isPlaceholder(_ component: String) -> Bool {
+    fileprivate static func isPlaceholder(_ component: String) -> Bool {
         return component.hasPrefix(":")
     }
+}
 
-    private func placeholderKey(for component: String) -> String {
-        return String(component.dropFirst())
+/// A node of the route trie. Each edge matches a single path component.
+private final class Node {
+    var literals: [String: Node] = [:]
+    /// The edge matching any component.
+    var placeholder: Node?
+    /// The routes whose path ends at this node.
+    var routeIndexes: [Int] = []
+
+    /// Returns the node for the given route component, adding it if needed.
+    func child(for component: String) -> Node {
+        if RouteMatcher.isPlaceholder(component) {
+            let child = placeholder ?? Node()
+            placeholder = child
+            return child
+        }
+        let child = literals[component] ?? Node()
+        literals[component] = child
+        return child
     }
+}
 
-    private func placeholderDictionary(forKeyComponents keyComponents: [String], valueComponents: [String]) -> [String: String]? {
-        var values = [String: String]()
+private struct CompiledRoute {
+    let components: [String]
+    /// The placeholder keys, with the positions of their components.
+    let placeholders: [(position: Int, key: String)]
 
-        for (keyComponent, valueComponent) in zip(keyComponents, valueComponents) {
-            if isPlaceholder(keyComponent) {
-                let key = placeholderKey(for: keyComponent)
-                values[key] = valueComponent
-            } else if keyComponent != valueComponent {
-                return nil
-            }
+    init(components: [String]) {
+        self.components = components
+        self.placeholders = components.enumerated().compactMap { position, component in
+            RouteMatcher.isPlaceholder(component) ? (position, String(component.dropFirst())) : nil
         }
+    }
 
+    func placeholderValues(for pathComponents: [String]) -> [String: String] {
+        var values = [String: String]()
+        for (position, key) in placeholders {
+            values[key] = pathComponents[position]
+        }
         return values
     }
 }
@@ -98,7 +98,16 @@
 @property (nonatomic, strong, readonly, nonnull) UITableView *tableView;
 @property (nonatomic, strong, readonly, nullable) NSFetchedResultsController *resultsController;
 @property (nonatomic, weak, nullable) id<WPTableViewHandlerDelegate> delegate;
+/**
+ Caches the row heights by object, so that they survive inserts, deletes and moves. A row's height is
+ invalidated when its object is updated, or when the width of the table view changes.
+ */
 @property (nonatomic) BOOL cacheRowHeights;
+/// The number of row heights found in the cache, and the number of row heights that had to be computed.
+@property (nonatomic, readonly) NSUInteger cachedRowHeightHits;
+@property (nonatomic, readonly) NSUInteger cachedRowHeightMisses;
+/// The number of row heights in the cache, for all widths.
+@property (nonatomic, readonly) NSUInteger cachedRowHeightCount;
 @property (nonatomic, readonly) BOOL isScrolling;
 @property (nonatomic) UITableViewRowAnimation updateRowAnimation;
 @property (nonatomic) UITableViewRowAnimation insertRowAnimation;
@@ -109,6 +118,10 @@
 
 - (nonnull instancetype)initWithTableView:(nonnull UITableView *)tableView;
 - (void)clearCachedRowHeights;
+/**
+ Computes the heights of all rows for the given width. The visible rows are computed right away, the other ones
+ in small batches on the next run loop iterations, starting with the ones closest to the visible rows.
+ */
 - (void)refreshCachedRowHeightsForWidth:(CGFloat)width;
 - (void)invalidateCachedRowHeightAtIndexPath:(nonnull NSIndexPath *)indexPath;
 - (void)resetResultsController;
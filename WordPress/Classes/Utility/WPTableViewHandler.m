@@ -7,6 +7,51 @@
 
 static NSString * const DefaultCellIdentifier = @"DefaultCellIdentifier";
 static CGFloat const DefaultCellHeight = 44.0;
+/// The time spent precomputing row heights before yielding to the main run loop.
+static CFTimeInterval const RowHeightPrecomputationBudget = 0.008;
+
+/// Identifies the height of a row by the object it displays, rather than by its index path, so the cached
+/// heights stay valid when rows are inserted, deleted or moved.
+@interface WPTableViewRowHeightKey : NSObject <NSCopying>
+@property (nonatomic, strong, readonly) NSManagedObjectID *objectID;
+/// Incremented every time the object changes.
+@property (nonatomic, assign, readonly) NSUInteger contentVersion;
+@property (nonatomic, assign, readonly) CGFloat width;
+@end
+
+@implementation WPTableViewRowHeightKey
+
+- (instancetype)initWithObjectID:(NSManagedObjectID *)objectID contentVersion:(NSUInteger)contentVersion width:(CGFloat)width
+{
+    self = [super init];
+    if (self) {
+        _objectID = objectID;
+        _contentVersion = contentVersion;
+        _width = width;
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    return self;
+}
+
+- (BOOL)isEqual:(id)object
+{
+    if (![object isKindOfClass:[WPTableViewRowHeightKey class]]) {
+        return NO;
+    }
+    WPTableViewRowHeightKey *other = object;
+    return other.contentVersion == self.contentVersion && other.width == self.width && [other.objectID isEqual:self.objectID];
+}
+
+- (NSUInteger)hash
+{
+    return self.objectID.hash ^ (self.contentVersion * 31) ^ (NSUInteger)(self.width * 1000);
+}
+
+@end
 
 @interface WPTableViewHandler ()
 
@@ -15,8 +60,14 @@ static CGFloat const DefaultCellHeight = 44.0;
 @property (nonatomic, strong) NSIndexPath *indexPathSelectedBeforeUpdates;
 @property (nonatomic, strong) NSIndexPath *indexPathSelectedAfterUpdates;
 @property (nonatomic, strong) NSMutableArray *sectionHeaders;
-@property (nonatomic, strong) NSMutableDictionary *cachedRowHeights;
-@property (nonatomic, strong) NSMutableArray *rowsWithInvalidatedHeights;
+@property (nonatomic, strong) NSMutableDictionary<WPTableViewRowHeightKey *, NSNumber *> *cachedRowHeights;
+@property (nonatomic, strong) NSMutableDictionary<NSManagedObjectID *, NSNumber *> *rowContentVersions;
+/// The keys of the heights cached for each object, for all widths and versions.
+@property (nonatomic, strong) NSMutableDictionary<NSManagedObjectID *, NSMutableSet<WPTableViewRowHeightKey *> *> *rowHeightKeysByObjectID;
+@property (nonatomic, strong) NSMutableSet<NSManagedObjectID *> *rowsWithInvalidatedHeights;
+@property (nonatomic) NSUInteger rowHeightPrecomputationGeneration;
+@property (nonatomic, readwrite) NSUInteger cachedRowHeightHits;
+@property (nonatomic, readwrite) NSUInteger cachedRowHeightMisses;
 @property (nonatomic, readwrite) BOOL isScrolling;
 @property (nonatomic, strong) NSArray *fetchedResultsBeforeChange;
 @property (nonatomic, strong) NSArray *fetchedResultsIndexPathsBeforeChange;
@@ -40,7 +91,9 @@ static CGFloat const DefaultCellHeight = 44.0;
     if (self) {
         _sectionHeaders = [NSMutableArray array];
         _cachedRowHeights = [NSMutableDictionary dictionary];
-        _rowsWithInvalidatedHeights = [NSMutableArray array];
+        _rowContentVersions = [NSMutableDictionary dictionary];
+        _rowHeightKeysByObjectID = [NSMutableDictionary dictionary];
+        _rowsWithInvalidatedHeights = [NSMutableSet set];
         _updateRowAnimation = UITableViewRowAnimationFade;
         _insertRowAnimation = UITableViewRowAnimationFade;
         _deleteRowAnimation = UITableViewRowAnimationFade;
@@ -73,9 +126,18 @@ static CGFloat const DefaultCellHeight = 44.0;
 
 #pragma mark - Public Methods
 
+- (NSUInteger)cachedRowHeightCount
+{
+    return self.cachedRowHeights.count;
+}
+
 - (void)clearCachedRowHeights
 {
     [self.cachedRowHeights removeAllObjects];
+    [self.rowContentVersions removeAllObjects];
+    [self.rowHeightKeysByObjectID removeAllObjects];
+    [self.rowsWithInvalidatedHeights removeAllObjects];
+    [self cancelRowHeightPrecomputation];
 }
 
 - (void)refreshTableView
@@ -216,14 +278,56 @@ static CGFloat const DefaultCellHeight = 44.0;
 
 #pragma mark - Private Methods
 
+- (nullable NSManagedObjectID *)objectIDForIndexPath:(NSIndexPath *)indexPath
+{
+    NSArray<id<NSFetchedResultsSectionInfo>> *sections = self.resultsController.sections;
+    if (indexPath.section >= (NSInteger)sections.count || indexPath.row >= (NSInteger)sections[indexPath.section].numberOfObjects) {
+        return nil;
+    }
+    id object = [self.resultsController objectAtIndexPath:indexPath];
+    return [object isKindOfClass:[NSManagedObject class]] ? [object objectID] : nil;
+}
+
+- (nullable WPTableViewRowHeightKey *)rowHeightKeyForIndexPath:(NSIndexPath *)indexPath width:(CGFloat)width
+{
+    NSManagedObjectID *objectID = [self objectIDForIndexPath:indexPath];
+    if (!objectID) {
+        return nil;
+    }
+    NSUInteger contentVersion = [self.rowContentVersions[objectID] unsignedIntegerValue];
+    return [[WPTableViewRowHeightKey alloc] initWithObjectID:objectID contentVersion:contentVersion width:width];
+}
+
 - (void)cacheRowHeight:(CGFloat)height forIndexPath:(NSIndexPath *)indexPath
 {
-    [self.cachedRowHeights setObject:@(height) forKey:indexPath];
+    WPTableViewRowHeightKey *key = [self rowHeightKeyForIndexPath:indexPath width:CGRectGetWidth(self.tableView.bounds)];
+    if (key) {
+        [self setCachedRowHeight:height forKey:key];
+    }
+}
+
+- (void)setCachedRowHeight:(CGFloat)height forKey:(WPTableViewRowHeightKey *)key
+{
+    self.cachedRowHeights[key] = @(height);
+
+    NSMutableSet<WPTableViewRowHeightKey *> *keys = self.rowHeightKeysByObjectID[key.objectID];
+    if (!keys) {
+        keys = [NSMutableSet set];
+        self.rowHeightKeysByObjectID[key.objectID] = keys;
+    }
+    [keys addObject:key];
 }
 
 - (CGFloat)cachedRowHeightForIndexPath:(NSIndexPath *)indexPath
 {
-    return [[self.cachedRowHeights numberForKey:indexPath] floatValue];
+    WPTableViewRowHeightKey *key = [self rowHeightKeyForIndexPath:indexPath width:CGRectGetWidth(self.tableView.bounds)];
+    NSNumber *height = key ? self.cachedRowHeights[key] : nil;
+    if (height) {
+        self.cachedRowHeightHits += 1;
+    } else {
+        self.cachedRowHeightMisses += 1;
+    }
+    return [height floatValue];
 }
 
 - (void)refreshCachedRowHeightsForWidth:(CGFloat)width
@@ -232,62 +336,119 @@ static CGFloat const DefaultCellHeight = 44.0;
         return;
     }
 
-    NSMutableDictionary *cachedRowHeights = [NSMutableDictionary dictionary];
-    for (NSObject<NSFetchRequestResult> *obj in self.resultsController.fetchedObjects) {
-        NSIndexPath *indexPath = [self.resultsController indexPathForObject:obj];
-        if (!indexPath) {
-            continue;
+    [self cancelRowHeightPrecomputation];
+
+    // The visible rows are computed right away, the other ones are computed in small batches on the
+    // following run loop iterations, nearest to the visible rows first, so the UI doesn't freeze.
+    NSArray<NSIndexPath *> *indexPaths = [self indexPathsInVisibleFirstOrder];
+    [self precomputeRowHeightsForIndexPaths:indexPaths
+                                  fromIndex:0
+                                      width:width
+                                 generation:self.rowHeightPrecomputationGeneration];
+}
+
+- (NSArray<NSIndexPath *> *)indexPathsInVisibleFirstOrder
+{
+    NSMutableArray<NSIndexPath *> *allIndexPaths = [NSMutableArray array];
+    NSArray<id<NSFetchedResultsSectionInfo>> *sections = self.resultsController.sections;
+    for (NSUInteger section = 0; section < sections.count; section++) {
+        NSUInteger numberOfObjects = sections[section].numberOfObjects;
+        for (NSUInteger row = 0; row < numberOfObjects; row++) {
+            [allIndexPaths addObject:[NSIndexPath indexPathForRow:row inSection:section]];
         }
-        CGFloat height = [self.delegate tableView:self.tableView heightForRowAtIndexPath:indexPath forWidth:width];
-        [cachedRowHeights setObject:@(height) forKey:indexPath];
     }
 
-    self.cachedRowHeights = cachedRowHeights;
+    NSArray<NSIndexPath *> *visibleIndexPaths = [self.tableView indexPathsForVisibleRows];
+    NSUInteger first = visibleIndexPaths.count > 0 ? [allIndexPaths indexOfObject:visibleIndexPaths.firstObject] : NSNotFound;
+    NSUInteger last = visibleIndexPaths.count > 0 ? [allIndexPaths indexOfObject:visibleIndexPaths.lastObject] : NSNotFound;
+    if (first == NSNotFound || last == NSNotFound) {
+        return allIndexPaths;
+    }
+
+    NSMutableArray<NSIndexPath *> *indexPaths = [NSMutableArray arrayWithCapacity:allIndexPaths.count];
+    [indexPaths addObjectsFromArray:[allIndexPaths subarrayWithRange:NSMakeRange(first, last - first + 1)]];
+    // Then alternate between the rows below and above the visible ones.
+    NSInteger below = last + 1;
+    NSInteger above = (NSInteger)first - 1;
+    while (below < (NSInteger)allIndexPaths.count || above >= 0) {
+        if (below < (NSInteger)allIndexPaths.count) {
+            [indexPaths addObject:allIndexPaths[below++]];
+        }
+        if (above >= 0) {
+            [indexPaths addObject:allIndexPaths[above--]];
+        }
+    }
+    return indexPaths;
 }
 
-- (void)clearCachedRowHeightsBelowIndexPath:(NSIndexPath *)indexPath
+- (void)precomputeRowHeightsForIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+                                fromIndex:(NSUInteger)startIndex
+                                    width:(CGFloat)width
+                               generation:(NSUInteger)generation
 {
-    if (!self.cacheRowHeights) {
+    if (generation != self.rowHeightPrecomputationGeneration) {
+        // The content changed, or a new precomputation started.
         return;
     }
 
-    NSMutableArray *invalidKeys = [NSMutableArray array];
-
-    for (NSIndexPath *key in [self.cachedRowHeights allKeys]) {
-        if ([key compare:indexPath] == NSOrderedDescending) {
-            [invalidKeys addObject:key];
+    NSUInteger visibleCount = [self.tableView indexPathsForVisibleRows].count;
+    CFTimeInterval start = CACurrentMediaTime();
+    NSUInteger index = startIndex;
+    for (; index < indexPaths.count; index++) {
+        if (index >= visibleCount && CACurrentMediaTime() - start > RowHeightPrecomputationBudget) {
+            break;
         }
+        NSIndexPath *indexPath = indexPaths[index];
+        WPTableViewRowHeightKey *key = [self rowHeightKeyForIndexPath:indexPath width:width];
+        if (!key || self.cachedRowHeights[key]) {
+            continue;
+        }
+        CGFloat height = [self.delegate tableView:self.tableView heightForRowAtIndexPath:indexPath forWidth:width];
+        [self setCachedRowHeight:height forKey:key];
     }
 
-    [self.cachedRowHeights removeObjectForKey:indexPath];
-    [self.cachedRowHeights removeObjectsForKeys:invalidKeys];
+    if (index >= indexPaths.count) {
+        DDLogDebug(@"TableViewHandler: Precomputed %lu row heights (hits: %lu, misses: %lu)", (unsigned long)indexPaths.count, (unsigned long)self.cachedRowHeightHits, (unsigned long)self.cachedRowHeightMisses);
+        return;
+    }
+
+    __weak __typeof(self) weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [weakSelf precomputeRowHeightsForIndexPaths:indexPaths fromIndex:index width:width generation:generation];
+    });
 }
 
-- (void)clearCachedRowHeightAtIndexPath:(NSIndexPath *)indexPath
+- (void)cancelRowHeightPrecomputation
 {
-    if (!self.cacheRowHeights) {
-        return;
-    }
-    [self.cachedRowHeights removeObjectForKey:indexPath];
+    self.rowHeightPrecomputationGeneration += 1;
 }
 
-- (void)invalidateCachedRowHeightAtIndexPath:(NSIndexPath *)indexPath
+- (void)invalidateCachedRowHeightForObjectID:(NSManagedObjectID *)objectID
 {
-    if (!self.cacheRowHeights) {
+    if (!self.cacheRowHeights || !objectID) {
         return;
     }
 
-    NSNumber *height = [self.cachedRowHeights objectForKey:indexPath];
-    if (!height) {
-        return;
+    // The heights computed for the previous version of the object, for any width, won't be used anymore.
+    NSUInteger contentVersion = [self.rowContentVersions[objectID] unsignedIntegerValue];
+    self.rowContentVersions[objectID] = @(contentVersion + 1);
+
+    NSSet<WPTableViewRowHeightKey *> *keys = self.rowHeightKeysByObjectID[objectID];
+    [self.rowHeightKeysByObjectID removeObjectForKey:objectID];
+    if (keys.count > 0) {
+        [self.cachedRowHeights removeObjectsForKeys:keys.allObjects];
+        [self.rowsWithInvalidatedHeights addObject:objectID];
     }
+}
 
-    [self.rowsWithInvalidatedHeights addObject:indexPath];
-    [self clearCachedRowHeightAtIndexPath:indexPath];
+- (void)invalidateCachedRowHeightAtIndexPath:(NSIndexPath *)indexPath
+{
+    [self invalidateCachedRowHeightForObjectID:[self objectIDForIndexPath:indexPath]];
 }
 
 - (void)resetResultsController
 {
+    [self cancelRowHeightPrecomputation];
     _resultsController = nil;
 }
 
@@ -410,9 +571,10 @@ static CGFloat const DefaultCellHeight = 44.0;
             return height;
         }
 
-        if ([self.rowsWithInvalidatedHeights containsObject:indexPath]) {
+        NSManagedObjectID *objectID = [self objectIDForIndexPath:indexPath];
+        if (objectID && [self.rowsWithInvalidatedHeights containsObject:objectID]) {
             // Recompute and return the real height.  It will end up in the cache automatically.
-            [self.rowsWithInvalidatedHeights removeObject:indexPath];
+            [self.rowsWithInvalidatedHeights removeObject:objectID];
             height = [self tableView:tableView heightForRowAtIndexPath:indexPath];
             return height;
         }
@@ -635,6 +797,8 @@ static CGFloat const DefaultCellHeight = 44.0;
     }
 
     self.indexPathSelectedBeforeUpdates = [self.tableView indexPathForSelectedRow];
+    // The precomputation works on index paths, which are about to change.
+    [self cancelRowHeightPrecomputation];
     [self.tableView beginUpdates];
 }
 
@@ -701,13 +865,11 @@ static CGFloat const DefaultCellHeight = 44.0;
     switch(type) {
         case NSFetchedResultsChangeInsert:
         {
-            [self clearCachedRowHeightsBelowIndexPath:newIndexPath];
             [self.tableView insertRowsAtIndexPaths:@[newIndexPath] withRowAnimation:self.insertRowAnimation];
         }
             break;
         case NSFetchedResultsChangeDelete:
         {
-            [self clearCachedRowHeightsBelowIndexPath:indexPath];
             [self.tableView deleteRowsAtIndexPaths:@[indexPath] withRowAnimation:self.deleteRowAnimation];
             if ([self.indexPathSelectedBeforeUpdates isEqual:indexPath]) {
                 [self deletingSelectedRowAtIndexPath:indexPath];
@@ -721,19 +883,16 @@ static CGFloat const DefaultCellHeight = 44.0;
             && [self.delegate shouldCancelUpdateAnimation];
 
             if (!shouldCancelUpdateAnimation) {
-                [self invalidateCachedRowHeightAtIndexPath:indexPath];
+                if ([anObject isKindOfClass:[NSManagedObject class]]) {
+                    [self invalidateCachedRowHeightForObjectID:[anObject objectID]];
+                }
                 [self.tableView reloadRowsAtIndexPaths:@[indexPath] withRowAnimation:self.updateRowAnimation];
             }
         }
             break;
         case NSFetchedResultsChangeMove:
         {
-            NSIndexPath *lowerIndexPath = indexPath;
-            if ([indexPath compare:newIndexPath] == NSOrderedDescending) {
-                lowerIndexPath = newIndexPath;
-            }
-            [self clearCachedRowHeightsBelowIndexPath:lowerIndexPath];
-
+            // The cached heights are keyed by object, so moving a row doesn't invalidate any of them.
             [self.tableView deleteRowsAtIndexPaths:@[indexPath] withRowAnimation:self.moveRowAnimation];
             [self.tableView insertRowsAtIndexPaths:@[newIndexPath] withRowAnimation:self.moveRowAnimation];
             if ([self.indexPathSelectedBeforeUpdates isEqual:indexPath] && self.indexPathSelectedAfterUpdates == nil) {
@@ -11,7 +11,10 @@ class DocumentUploadProcessor: Processor {
     private let remoteURLString: String
     private let title: String
 
-    private lazy var processor = HTMLProcessor(for: "img", replacer: { [mediaUploadID, remoteURLString, title] img in
+    private lazy var processor = HTMLProcessor(for: "img", replacer: replacer)
+
+    /// Replaces the placeholder `img` tag with the given upload ID.
+    lazy var replacer: HTMLProcessor.Replacer = { [mediaUploadID, remoteURLString, title] img in
         guard
             let uploadKeyValue = img.attributes[MediaAttachment.uploadKey]?.value,
             case let .string(imageUploadIdentifier) = uploadKeyValue,
@@ -22,7 +25,7 @@ class DocumentUploadProcessor: Processor {
 
         var html = "<a href=\"\(remoteURLString)\">\(title)</a><br />"
         return html
-    })
+    }
 
     init(mediaUploadID: String, remoteURLString: String, title: String) {
         self.mediaUploadID = mediaUploadID
@@ -15,7 +15,10 @@ class ImgUploadProcessor: Processor {
         self.height = height
     }
 
-    lazy var imgPostMediaUploadProcessor = HTMLProcessor(for: "img", replacer: { (img) in
+    lazy var imgPostMediaUploadProcessor = HTMLProcessor(for: "img", replacer: replacer)
+
+    /// Replaces the `img` tag with the given upload ID.
+    lazy var replacer: HTMLProcessor.Replacer = { (img) in
         guard let imgUploadValue = img.attributes[MediaAttachment.uploadKey]?.value,
             case let .string(imgUploadID) = imgUploadValue,
             self.mediaUploadID == imgUploadID else {
@@ -37,7 +40,7 @@ class ImgUploadProcessor: Processor {
         html += attributeSerializer.serialize(attributes)
         html += ">"
         return html
-    })
+    }
 
     func process(_ text: String) -> String {
         return imgPostMediaUploadProcessor.process(text)
@@ -14,7 +14,10 @@ class VideoUploadProcessor: Processor {
         self.videoPressID = videoPressID
     }
 
-    lazy var videoPostMediaUploadProcessor = ShortcodeProcessor(tag: "video", replacer: { (shortcode) in
+    lazy var videoPostMediaUploadProcessor = ShortcodeProcessor(tag: "video", replacer: replacer)
+
+    /// Replaces the `video` shortcode with the given upload ID.
+    lazy var replacer: ShortcodeProcessor.Replacer = { (shortcode) in
         guard let uploadValue = shortcode.attributes[MediaAttachment.uploadKey]?.value,
             case let .string(uploadID) = uploadValue,
             self.mediaUploadID == uploadID else {
@@ -39,7 +42,7 @@ class VideoUploadProcessor: Processor {
         }
 
         return html
-    })
+    }
 
     func process(_ text: String) -> String {
         return videoPostMediaUploadProcessor.process(text)
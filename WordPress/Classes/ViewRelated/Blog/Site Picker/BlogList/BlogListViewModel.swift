@@ -13,6 +13,7 @@ final class BlogListViewModel: NSObject, ObservableObject {
 
     private let configuration: BlogListConfiguration
     private var rawSites: [Blog] = []
+    private var searchIndex = StringRankedSearchIndex<BlogListSiteViewModel>(input: \.searchTags)
     private let fetchedResultsController: NSFetchedResultsController<Blog>
     private let contextManager: ContextManager
     private let blogService: BlogService
@@ -96,16 +97,31 @@ final class BlogListViewModel: NSObject, ObservableObject {
         allSites = rawSites.map(BlogListSiteViewModel.init)
             .sorted { $0.title.localizedCaseInsensitiveCompare($1.title) == .orderedAscending }
 
+        updateSearchIndex()
         updateSearchResults()
     }
 
+    /// The sites are only tokenized when they are added or changed, not on every search.
+    private func updateSearchIndex() {
+        let siteIDs = Set(allSites.map(\.id))
+        for id in searchIndex.ids.filter({ !siteIDs.contains($0) }) {
+            searchIndex.remove(id: id)
+        }
+        for site in allSites {
+            searchIndex.insert(site)
+        }
+        // The sites with the same score are shown in the same order as in the list.
+        searchIndex.setOrder(allSites.map(\.id))
+    }
+
     private func updateSearchResults() {
         if searchText.isEmpty {
             searchResults = []
         } else {
             let searchText = searchText
+            let searchIndex = searchIndex
             Task { @MainActor in
-                let searchResults = await search(searchTerm: searchText, sites: allSites)
+                let searchResults = await search(searchTerm: searchText, in: searchIndex)
                 if searchText == self.searchText {
                     self.searchResults = searchResults
                 }
@@ -178,7 +194,6 @@ private func createFetchedResultsController(in context: NSManagedObjectContext)
     return NSFetchedResultsController(fetchRequest: request, managedObjectContext: context, sectionNameKeyPath: nil, cacheName: nil)
 }
 
-private func search(searchTerm: String, sites: [BlogListSiteViewModel]) async -> [BlogListSiteViewModel] {
-    let ranking = StringRankedSearch(searchTerm: searchTerm)
-    return ranking.search(in: sites, input: \.searchTags)
+private func search(searchTerm: String, in searchIndex: StringRankedSearchIndex<BlogListSiteViewModel>) async -> [BlogListSiteViewModel] {
+    searchIndex.search(searchTerm)
 }
@@ -351,10 +351,12 @@ class GutenbergViewController: UIViewController, PostEditor, FeaturedImageDelega
         super.viewDidAppear(animated)
         // Handles refreshing controls with state context after options screen is dismissed
         editorContentWasUpdated()
+        MediaCoordinator.shared.prioritizeUploads(for: post)
     }
 
     override func viewWillDisappear(_ animated: Bool) {
         super.viewWillDisappear(animated)
+        MediaCoordinator.shared.prioritizeUploads(for: nil)
     }
 
     override func viewLayoutMarginsDidChange() {
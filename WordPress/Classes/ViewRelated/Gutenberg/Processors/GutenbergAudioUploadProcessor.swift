@@ -1,7 +1,7 @@
 import Foundation
 import Aztec
 
-class GutenbergAudioUploadProcessor: Processor {
+class GutenbergAudioUploadProcessor: GutenbergBlockProcessorGroup {
     private struct AudioBlockKeys {
         static let name = "wp:audio"
         static let id = "id"
@@ -48,7 +48,7 @@ class GutenbergAudioUploadProcessor: Processor {
         return block
     })
 
-    func process(_ text: String) -> String {
-        return fileBlockProcessor.process(text)
+    var blockProcessors: [GutenbergBlockProcessor] {
+        return [fileBlockProcessor]
     }
 }
@@ -0,0 +1,112 @@
+import Foundation
+
+/// The block delimiters of a post, found with a single scan of its content.
+///
+/// Opening and closing delimiters are paired up front, so that any number of
+/// `GutenbergBlockProcessor`s can resolve their blocks without scanning the
+/// content again.
+///
+struct GutenbergBlockIndex {
+
+    struct Block {
+        /// The lowercased block name, e.g. `wp:image`.
+        let name: String
+
+        /// The range of the opening delimiter, or of the whole block if it's self-closing.
+        let openingRange: NSRange
+
+        /// The range of the attributes inside the opening delimiter.
+        let attributesRange: NSRange
+
+        let isSelfClosing: Bool
+
+        /// The range of the closing delimiter. `nil` for self-closing blocks and
+        /// for blocks that are never closed.
+        fileprivate(set) var closingRange: NSRange?
+
+        /// The range from the opening to the closing delimiter, or `nil` if the
+        /// block is never closed.
+        var range: NSRange? {
+            if isSelfClosing {
+                return openingRange
+            }
+            guard let closingRange else {
+                return nil
+            }
+            return NSRange(location: openingRange.location, length: closingRange.upperBound - openingRange.location)
+        }
+
+        /// The range between the opening and closing delimiters.
+        var contentRange: NSRange? {
+            guard !isSelfClosing, let closingRange else {
+                return nil
+            }
+            return NSRange(location: openingRange.upperBound, length: closingRange.location - openingRange.upperBound)
+        }
+    }
+
+    /// The blocks, in the order of their opening delimiters.
+    let blocks: [Block]
+
+    init(text: NSString) {
+        var blocks: [Block] = []
+        var unclosedBlocks: [String: [Int]] = [:]
+
+        let matches = GutenbergBlockIndex.delimiterRegex.matches(in: text as String, options: [], range: NSRange(location: 0, length: text.length))
+        for match in matches {
+            let name = text.substring(with: match.range(at: CaptureGroups.name.rawValue)).lowercased()
+
+            if match.range(at: CaptureGroups.closingSlash.rawValue).location != NSNotFound {
+                if let index = unclosedBlocks[name]?.popLast() {
+                    blocks[index].closingRange = match.range
+                }
+                continue
+            }
+
+            let isSelfClosing = match.range(at: CaptureGroups.selfClosingSlash.rawValue).location != NSNotFound
+            blocks.append(Block(name: name,
+                                openingRange: match.range,
+                                attributesRange: match.range(at: CaptureGroups.attributes.rawValue),
+                                isSelfClosing: isSelfClosing,
+                                closingRange: nil))
+            if !isSelfClosing {
+                unclosedBlocks[name, default: []].append(blocks.count - 1)
+            }
+        }
+
+        self.blocks = blocks
+    }
+
+    /// Returns the index of the first block that opens at or after the given location.
+    func firstBlock(from location: Int) -> Int {
+        var lowerBound = 0
+        var upperBound = blocks.count
+        while lowerBound < upperBound {
+            let middle = (lowerBound + upperBound) / 2
+            if blocks[middle].openingRange.location < location {
+                lowerBound = middle + 1
+            } else {
+                upperBound = middle
+            }
+        }
+        return lowerBound
+    }
+
+    // MARK: - Tokenizing
+
+    private enum CaptureGroups: Int {
+        case all = 0
+        case closingSlash
+        case name
+        case attributes
+        case selfClosingSlash
+    }
+
+    /// Matches opening (`<!-- wp:name {...} -->`), self-closing (`<!-- wp:name {...} /-->`)
+    /// and closing (`<!-- /wp:name -->`) block delimiters.
+    ///
+    private static let delimiterRegex: NSRegularExpression = {
+        let pattern = "<!--\\s*(/)?(wp:[a-z0-9_-]+(?:/[a-z0-9_-]+)?)([\\s\\S]*?)(/)?-->"
+        return try! NSRegularExpression(pattern: pattern, options: .caseInsensitive)
+    }()
+}
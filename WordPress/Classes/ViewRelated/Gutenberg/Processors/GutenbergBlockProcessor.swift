@@ -19,16 +19,8 @@ public class GutenbergBlockProcessor: Processor {
 
     let name: String
 
-    private enum CaptureGroups: Int {
-        case all = 0
-        case name
-        case attributes
-
-        static let allValues: [CaptureGroups] = [.all, .name, .attributes]
-    }
-
     // MARK: - Parsing & processing properties
-    private let replacer: Replacer
+    fileprivate let replacer: Replacer
 
     // MARK: - Initializers
 
@@ -37,52 +29,49 @@ public class GutenbergBlockProcessor: Processor {
         self.replacer = replacer
     }
 
-    /// Regular expression to detect attributes of the opening tag of a block
-    /// Capture groups:
-    ///
-    /// 1. The block id
-    /// 2. The block attributes
-    ///
-    var openTagRegex: NSRegularExpression {
-        let pattern = "\\<!--[ ]?(\(name))([\\s\\S]*?)\\/?-->"
-        return try! NSRegularExpression(pattern: pattern, options: .caseInsensitive)
-    }
-
-    /// Regular expression to detect the closing tag of a block
-    ///
-    var closingTagRegex: NSRegularExpression {
-        let pattern = "\\<!-- \\/\(name) -->"
-        return try! NSRegularExpression(pattern: pattern, options: .caseInsensitive)
-    }
-
     // MARK: - Processing
 
-    /// Processes the block and for any needed replacements from a given opening tag match.
+    /// Processes the blocks and performs any needed replacements.
     ///     - Parameters:
     ///         - text: The string that the following parameter is found in.
     ///     - Returns: The resulting string after the necessary replacements have occured
     ///
     public func process(_ text: String) -> String {
-        let matches = openTagRegex.matches(in: text, options: [], range: text.utf16NSRange(from: text.startIndex ..< text.endIndex))
-        var replacements = [(NSRange, String)]()
+        return GutenbergBlockProcessor.process(text, with: [self])
+    }
 
-        var lastReplacementBound = 0
-        for match in matches {
-            if match.range.lowerBound >= lastReplacementBound, let replacement = process(match, in: text) {
-                replacements.append(replacement)
-                lastReplacementBound = replacement.0.upperBound
-            }
+    /// Runs several processors over the same text, scanning its block delimiters only once.
+    /// When more than one processor handles the same block name, they are asked in order and
+    /// the first replacement wins.
+    ///     - Parameters:
+    ///         - text: The string to process.
+    ///         - processors: The processors to run.
+    ///     - Returns: The resulting string after the necessary replacements have occured
+    ///
+    static func process(_ text: String, with processors: [GutenbergBlockProcessor]) -> String {
+        let nsText = text as NSString
+        guard !processors.isEmpty, nsText.range(of: "<!--").location != NSNotFound else {
+            return text
         }
-        let resultText = replace(replacements, in: text)
-        return resultText
+
+        var resolver = BlockResolver(text: nsText, index: GutenbergBlockIndex(text: nsText), processors: processors)
+        let replacements = resolver.replacements(in: NSRange(location: 0, length: nsText.length))
+        return replace(replacements, in: text)
     }
 
-    /// Replaces the
+    /// Replaces the given ranges of text.
     ///     - Parameters:
     ///         - replacements: An array of tuples representing first a range of text that needs to be replaced then the string to replace
     ///         - text: The string to perform the replacements on
     ///
     func replace(_ replacements: [(NSRange, String)], in text: String) -> String {
+        return GutenbergBlockProcessor.replace(replacements, in: text)
+    }
+
+    fileprivate static func replace(_ replacements: [(NSRange, String)], in text: String) -> String {
+        guard !replacements.isEmpty else {
+            return text
+        }
         let mutableString = NSMutableString(string: text)
         var offset = 0
         for (range, replacement) in replacements {
@@ -95,103 +84,93 @@ public class GutenbergBlockProcessor: Processor {
         return mutableString as String
     }
 }
-// MARK: - Regex Match Processing Logic
 
-private extension GutenbergBlockProcessor {
-    /// Processes the block and for any needed replacements from a given opening tag match.
-    ///     - Parameters:
-    ///         - match: The match reperesenting an opening block tag
-    ///         - text: The string that the following parameter is found in.
-    ///     - Returns: Any necessary replacements within the provided string
-    ///
-    private func process(_ match: NSTextCheckingResult, in text: String) -> (NSRange, String)? {
+/// A processor made of `GutenbergBlockProcessor`s, which can run in the same pass over the
+/// content as other ones with `GutenbergBlockProcessor.process(_:with:)`.
+///
+protocol GutenbergBlockProcessorGroup: Processor {
+    var blockProcessors: [GutenbergBlockProcessor] { get }
+}
 
-        var result: (NSRange, String)? = nil
-        if isSelfClosingTag(forMatch: match, in: text) {
-            let attributes = readAttributes(from: match, in: text)
-            let block = GutenbergBlock(name: name, attributes: attributes, content: "")
+extension GutenbergBlockProcessorGroup {
+    func process(_ text: String) -> String {
+        return GutenbergBlockProcessor.process(text, with: blockProcessors)
+    }
+}
 
-            if let replacement = replacer(block) {
-                result = (match.range, replacement)
-            }
-        }
-        else if let closingRange = locateClosingTag(forMatch: match, in: text) {
-            let attributes = readAttributes(from: match, in: text)
-            let content = readContent(from: match, withClosingRange: closingRange, in: text)
-            let parsedContent = process(content) // Recurrsively parse nested blocks and process those seperatly
-            let block = GutenbergBlock(name: name, attributes: attributes, content: parsedContent)
-
-            if let replacement = replacer(block) {
-                let length = closingRange.upperBound - match.range.lowerBound
-                let range = NSRange(location: match.range.lowerBound, length: length)
-                result = (range, replacement)
-            }
-        }
+// MARK: - Block Resolution
 
-        return result
+/// Resolves the replacements for the blocks of a `GutenbergBlockIndex`.
+///
+private struct BlockResolver {
+    let text: NSString
+    let index: GutenbergBlockIndex
+    let processors: [String: [GutenbergBlockProcessor]]
+
+    /// The replacements of the blocks that were already resolved, by block index, so that
+    /// nested blocks are only resolved once.
+    private var resolvedBlocks: [Int: String?] = [:]
+
+    init(text: NSString, index: GutenbergBlockIndex, processors: [GutenbergBlockProcessor]) {
+        self.text = text
+        self.index = index
+        self.processors = Dictionary(grouping: processors, by: { $0.name.lowercased() })
     }
 
-    /// Determines the location of the closing block tag for the matching open tag
-    ///     - Parameters:
-    ///         - openTag: The match reperesenting an opening block tag
-    ///         - text: The string that the following parameter is found in.
-    ///     - Returns: The Range of the closing tag for the block
+    /// Returns the replacements for the outermost processed blocks within the given range.
     ///
-    func locateClosingTag(forMatch openTag: NSTextCheckingResult, in text: String) -> NSRange? {
-        guard let index = text.indexFromLocation(openTag.range.upperBound) else {
-            return nil
-        }
-
-        let matches = closingTagRegex.matches(in: text, options: [], range: text.utf16NSRange(from: index ..< text.endIndex))
-
-        for match in matches {
-            let content = readContent(from: openTag, withClosingRange: match.range, in: text)
-
-            if tagsAreBalanced(in: content) {
-                return match.range
+    mutating func replacements(in range: NSRange) -> [(NSRange, String)] {
+        var replacements = [(NSRange, String)]()
+        var lastReplacementBound = range.location
+
+        var blockIndex = index.firstBlock(from: range.location)
+        while blockIndex < index.blocks.count, index.blocks[blockIndex].openingRange.location < range.upperBound {
+            defer { blockIndex += 1 }
+
+            let block = index.blocks[blockIndex]
+            guard block.openingRange.location >= lastReplacementBound,
+                  let blockRange = block.range,
+                  blockRange.upperBound <= range.upperBound,
+                  let replacement = replacement(forBlockAt: blockIndex) else {
+                continue
             }
+            replacements.append((blockRange, replacement))
+            lastReplacementBound = blockRange.upperBound
         }
 
-        return nil
+        return replacements
     }
 
-    /// Determines if the block tag is self-closing.
-    /// E.g.: <!-- wp:videopress/video {"guid":"AbCdE","id":100} /-->
-    ///     - Parameters:
-    ///         - openTag: The match reperesenting an opening block tag
-    ///         - text: The string that the following parameter is found in.
-    ///     - Returns: True if the block tag is self-closing.
-    func isSelfClosingTag(forMatch openTag: NSTextCheckingResult, in text: String) -> Bool {
-        guard let tagRange = Range(openTag.range, in: text) else {
-            return false
+    private mutating func replacement(forBlockAt blockIndex: Int) -> String? {
+        if let resolved = resolvedBlocks[blockIndex] {
+            return resolved
+        }
+        let block = index.blocks[blockIndex]
+        guard let processors = processors[block.name] else {
+            return nil
         }
-        let tagSubstring = String(text[tagRange])
-        return tagSubstring.hasSuffix("/-->")
-    }
-
-    /// Determines if there are an equal number of opening and closing block tags in the provided text.
-    ///     - Parameters:
-    ///         - text: The string to test assumes that a block with an even number represents a valid block sequence.
-    ///     - Returns: A boolean where true represents an equal number of opening and closing block tags of the desired type
-    ///
-    func tagsAreBalanced(in text: String) -> Bool {
 
-        let range = text.utf16NSRange(from: text.startIndex ..< text.endIndex)
-        let openTags = openTagRegex.matches(in: text, options: [], range: range)
-        let closingTags = closingTagRegex.matches(in: text, options: [], range: range)
+        let attributes = readAttributes(of: block)
+        let content = readContent(of: block)
 
-        return openTags.count == closingTags.count
+        var result: String? = nil
+        for processor in processors {
+            let gutenbergBlock = GutenbergBlock(name: processor.name, attributes: attributes, content: content)
+            if let replacement = processor.replacer(gutenbergBlock) {
+                result = replacement
+                break
+            }
+        }
+        resolvedBlocks[blockIndex] = .some(result)
+        return result
     }
 
-    /// Obtains the block attributes from a regex match.
-    ///     - Parameters:
-    ///         - match: The `NSTextCheckingResult` from a successful regex detection of an opening block tag
-    ///         - text: The string that the following parameter is found in.
+    /// Obtains the block attributes from the opening delimiter.
     ///     - Returns: A JSON dictionary of the block attributes
     ///
-    func readAttributes(from match: NSTextCheckingResult, in text: String) -> [String: Any] {
-        guard let attributesText = match.captureGroup(in: CaptureGroups.attributes.rawValue, text: text),
-            let data = attributesText.data(using: .utf8 ),
+    private func readAttributes(of block: GutenbergBlockIndex.Block) -> [String: Any] {
+        guard block.attributesRange.location != NSNotFound,
+            let data = text.substring(with: block.attributesRange).data(using: .utf8),
             let json = try? JSONSerialization.jsonObject(with: data, options: .allowFragments),
             let jsonDictionary = json as? [String: Any] else {
                 return [:]
@@ -200,22 +179,15 @@ private extension GutenbergBlockProcessor {
         return jsonDictionary
     }
 
-    /// Obtains the block content from a regex match and range.
-    ///     - Parameters:
-    ///         - match: The `NSTextCheckingResult` from a successful regex detection of an opening block tag
-    ///         - closingRange: The `NSRange` of the closing block tag
-    ///         - text: The string that the following parameters are found in.
-    ///     - Returns: The content between the opening and closing tags of a block
+    /// Obtains the block content, with any nested blocks already processed.
     ///
-    func readContent(from match: NSTextCheckingResult, withClosingRange closingRange: NSRange, in text: String) -> String {
-        guard let index = text.indexFromLocation(match.range.upperBound) else {
+    private mutating func readContent(of block: GutenbergBlockIndex.Block) -> String {
+        guard let contentRange = block.contentRange else {
             return ""
         }
-
-        guard let closingBound = text.indexFromLocation(closingRange.lowerBound) else {
-            return ""
+        let replacements = replacements(in: contentRange).map { range, replacement in
+            (NSRange(location: range.location - contentRange.location, length: range.length), replacement)
         }
-
-        return String(text[index..<closingBound])
+        return GutenbergBlockProcessor.replace(replacements, in: text.substring(with: contentRange))
     }
 }
@@ -3,61 +3,175 @@ import SwiftSoup
 
 public class GutenbergParsedBlock {
     public let name: String
-    public var elements: Elements
-    public var blocks: [GutenbergParsedBlock]
+    public var blocks: [GutenbergParsedBlock] = []
     public weak var parentBlock: GutenbergParsedBlock?
-    public let isCloseTag: Bool
 
+    /// The block attributes. They are decoded from the original content on first
+    /// access, and encoded back only when the content is serialized.
     public var attributes: [String: Any] {
         get {
-            guard let data = self.attributesData.data(using: .utf8 ),
+            if let decodedAttributes {
+                return decodedAttributes
+            }
+            let attributesData = source.substring(with: delimiters.attributesRange).trimmingCharacters(in: .whitespacesAndNewlines)
+            guard let data = attributesData.data(using: .utf8),
                   let jsonObject = try? JSONSerialization.jsonObject(with: data, options: .allowFragments),
                   let attributes = jsonObject as? [String: Any]
             else {
+                decodedAttributes = [:]
                 return [:]
             }
+            decodedAttributes = attributes
             return attributes
         }
 
         set(newValue) {
-            guard let data = try? JSONSerialization.data(withJSONObject: newValue, options: .sortedKeys),
-                  let attributes = String(data: data, encoding: .utf8) else {
-                return
-            }
-            self.attributesData = attributes
-            // Update comment tag data with new attributes
-            try! self.comment.attr("comment", " \(self.name) \(attributes) ")
+            decodedAttributes = newValue
+            hasModifiedAttributes = true
         }
     }
 
+    /// The HTML elements between the block delimiters.
+    ///
+    /// Accessing them parses the outermost block containing this one, which is
+    /// then serialized from its DOM so that any changes to the elements are kept.
+    public var elements: Elements {
+        root.materialize()
+        root.hasModifiedElements = true
+        return materializedElements ?? Elements()
+    }
+
     public var content: String {
         get {
-            (try? elements.outerHtml()) ?? ""
+            root.materialize()
+            return (try? materializedElements?.outerHtml()) ?? ""
         }
     }
 
-    private var comment: SwiftSoup.Comment
-    private var attributesData: String
+    /// The range of the block in the original content, from its opening to its
+    /// closing delimiter. Blocks that are self-closing or never closed span their
+    /// opening delimiter only.
+    var range: NSRange {
+        delimiters.range ?? delimiters.openingRange
+    }
+
+    private let source: NSString
+    private let delimiters: GutenbergBlockIndex.Block
+    private var decodedAttributes: [String: Any]?
+    private var hasModifiedAttributes = false
+
+    // Set once the subtree containing the block is materialized.
+    private var comment: SwiftSoup.Comment?
+    private var materializedElements: Elements?
+
+    // Only set on the outermost block of a subtree.
+    private var fragment: Document?
+    private var hasModifiedElements = false
+
+    init(source: NSString, delimiters: GutenbergBlockIndex.Block) {
+        self.name = delimiters.name
+        self.source = source
+        self.delimiters = delimiters
+    }
+
+    private var root: GutenbergParsedBlock {
+        parentBlock?.root ?? self
+    }
 
-    public init?(comment: SwiftSoup.Comment, parentBlock: GutenbergParsedBlock? = nil) {
-        let data = comment.getData().trim()
-        if let separatorRange = data.range(of: " ") {
-            self.name = String(data[data.startIndex..<separatorRange.lowerBound])
-            self.attributesData = String(data[separatorRange.upperBound..<data.endIndex])
+    /// The block and its nested blocks, in document order.
+    private var subtree: [GutenbergParsedBlock] {
+        [self] + blocks.flatMap { $0.subtree }
+    }
+
+    /// The data of the opening delimiter comment, with the current attributes.
+    private var delimiterData: String? {
+        guard let decodedAttributes,
+              let data = try? JSONSerialization.data(withJSONObject: decodedAttributes, options: .sortedKeys),
+              let attributes = String(data: data, encoding: .utf8) else {
+            return nil
         }
-        else {
-            self.name = data
-            self.attributesData = ""
+        return " \(name) \(attributes) " + (delimiters.isSelfClosing ? "/" : "")
+    }
+
+    // MARK: - DOM
+
+    private func materialize() {
+        guard fragment == nil,
+              let document = try? SwiftSoup.parseBodyFragment(source.substring(with: range)),
+              let body = document.outputSettings(OutputSettings().prettyPrint(pretty: false)).body() else {
+            return
         }
-        self.comment = comment
-        self.elements = SwiftSoup.Elements()
-        self.blocks = []
-        self.isCloseTag = self.name.hasPrefix("/")
-        if !self.isCloseTag {
-            self.parentBlock = parentBlock
-            parentBlock?.blocks.append(self)
+        fragment = document
+
+        let subtree = self.subtree
+        subtree.forEach { $0.materializedElements = Elements() }
+        var pending = subtree[...]
+        GutenbergParsedBlock.attach(body, to: &pending)
+    }
+
+    /// Pairs the delimiter comments found in `element` with the blocks waiting for
+    /// one, in document order, and collects the elements between each block's
+    /// delimiters.
+    private static func attach(_ element: Element, to pending: inout ArraySlice<GutenbergParsedBlock>) {
+        var currentBlock: GutenbergParsedBlock?
+        for node in element.getChildNodes() {
+            switch node {
+            case let comment as SwiftSoup.Comment:
+                var name = comment.getData().trim().prefix { !$0.isWhitespace }.lowercased()
+                if name.hasSuffix("/") {
+                    name.removeLast()
+                }
+
+                // Identify close tag
+                if let block = currentBlock, name == "/\(block.name)" {
+                    currentBlock = nil
+                    continue
+                }
+
+                guard let index = pending.firstIndex(where: { $0.name == name }) else {
+                    continue
+                }
+                let block = pending[index]
+                pending = pending[(index + 1)...]
+                block.comment = comment
+                currentBlock = block.delimiters.isSelfClosing ? nil : block
+            // Insert HTML elements into block being processed
+            case let child as SwiftSoup.Element:
+                currentBlock?.materializedElements?.add(child)
+                if child.childNodeSize() > 0 {
+                    attach(child, to: &pending)
+                }
+            default: break
+            }
         }
     }
+
+    // MARK: - Serialization
+
+    /// Appends the replacements for the changes made to the block and its nested
+    /// blocks, in document order.
+    ///
+    /// A subtree whose elements were accessed is serialized from its DOM. Otherwise,
+    /// only the opening delimiters of the blocks with modified attributes are.
+    ///
+    func appendChanges(to changes: inout [(range: NSRange, replacement: String)]) {
+        if hasModifiedElements, let body = fragment?.body() {
+            for block in subtree where block.hasModifiedAttributes {
+                if let comment = block.comment, let data = block.delimiterData {
+                    _ = try? comment.attr("comment", data)
+                }
+            }
+            if let html = try? body.html() {
+                changes.append((range, html))
+                return
+            }
+        }
+
+        if hasModifiedAttributes, let data = delimiterData {
+            changes.append((delimiters.openingRange, "<!--\(data)-->"))
+        }
+        blocks.forEach { $0.appendChanges(to: &changes) }
+    }
 }
 
 /// Parses content generated in the Gutenberg editor to allow modifications.
@@ -108,53 +222,51 @@ public class GutenbergParsedBlock {
 /// let contentHTML = parser.html()
 /// ```
 ///
+/// > Note: Parsing only finds the block delimiters. The HTML of a block is parsed the
+/// first time its `elements` or `content` are accessed, and only the blocks that were
+/// modified are serialized again: the rest of the content is kept as is.
+///
 public class GutenbergContentParser {
     public var blocks: [GutenbergParsedBlock]
 
-    private let htmlDocument: Document?
+    private let content: NSString
 
     public init(for content: String) {
-        self.htmlDocument = try? SwiftSoup.parseBodyFragment(content).outputSettings(OutputSettings().prettyPrint(pretty: false))
+        let text = content as NSString
+        self.content = text
         self.blocks = []
 
-        guard let htmlContent = self.htmlDocument?.body() else {
-            return
+        var ancestors: [GutenbergParsedBlock] = []
+        for delimiters in GutenbergBlockIndex(text: text).blocks {
+            let block = GutenbergParsedBlock(source: text, delimiters: delimiters)
+            while let ancestor = ancestors.last, block.range.upperBound > ancestor.range.upperBound {
+                ancestors.removeLast()
+            }
+            if let parentBlock = ancestors.last {
+                block.parentBlock = parentBlock
+                parentBlock.blocks.append(block)
+            }
+            blocks.append(block)
+            ancestors.append(block)
         }
-        traverseChildNodes(element: htmlContent)
     }
 
     public func html() -> String {
-        return (try? self.htmlDocument?.body()?.html()) ?? ""
-    }
-
-    private func traverseChildNodes(element: Element, parentBlock: GutenbergParsedBlock? = nil) {
-        var currentBlock: GutenbergParsedBlock?
-        element.getChildNodes().forEach { node in
-            switch node {
-            // Convert comment tag into block
-            case let comment as SwiftSoup.Comment:
-                guard let block = GutenbergParsedBlock(comment: comment, parentBlock: parentBlock) else {
-                    return
-                }
-
-                // Identify close tag
-                if let currrentBlock = currentBlock, block.name == "/\(currrentBlock.name)" {
-                    currentBlock = nil
-                    return
-                }
+        var changes: [(range: NSRange, replacement: String)] = []
+        for block in blocks where block.parentBlock == nil {
+            block.appendChanges(to: &changes)
+        }
+        guard !changes.isEmpty else {
+            return content as String
+        }
 
-                self.blocks.append(block)
-                currentBlock = block
-            // Insert HTML elements into block being processed
-            case let element as SwiftSoup.Element:
-                if let currentBlock = currentBlock {
-                    currentBlock.elements.add(element)
-                }
-                if element.childNodeSize() > 0 {
-                    traverseChildNodes(element: element, parentBlock: currentBlock ?? parentBlock)
-                }
-            default: break
-            }
+        // Splice from the end so that the ranges of the earlier changes stay valid
+        let html = NSMutableString(string: content)
+        var upperBound = html.length
+        for change in changes.reversed() where change.range.upperBound <= upperBound {
+            html.replaceCharacters(in: change.range, with: change.replacement)
+            upperBound = change.range.location
         }
+        return html as String
     }
 }
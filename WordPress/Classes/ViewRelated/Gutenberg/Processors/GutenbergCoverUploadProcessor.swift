@@ -1,7 +1,7 @@
 import Foundation
 import Aztec
 
-class GutenbergCoverUploadProcessor: Processor {
+class GutenbergCoverUploadProcessor: GutenbergBlockProcessorGroup {
     public typealias InnerBlockProcessor = (String) -> String?
 
     private struct CoverBlockKeys {
@@ -46,8 +46,8 @@ class GutenbergCoverUploadProcessor: Processor {
         return block
     })
 
-    func process(_ text: String) -> String {
-        return coverBlockProcessor.process(text)
+    var blockProcessors: [GutenbergBlockProcessor] {
+        return [coverBlockProcessor]
     }
 }
 
@@ -1,7 +1,7 @@
 import Foundation
 import Aztec
 
-class GutenbergVideoPressUploadProcessor: Processor {
+class GutenbergVideoPressUploadProcessor: GutenbergBlockProcessorGroup {
 
     let mediaUploadID: Int32
     let serverMediaID: Int
@@ -40,7 +40,7 @@ class GutenbergVideoPressUploadProcessor: Processor {
         return block
     })
 
-    func process(_ text: String) -> String {
-        return videoPressBlockProcessor.process(text)
+    var blockProcessors: [GutenbergBlockProcessor] {
+        return [videoPressBlockProcessor]
     }
 }
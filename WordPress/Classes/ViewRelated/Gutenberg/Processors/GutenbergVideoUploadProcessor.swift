@@ -1,7 +1,7 @@
 import Foundation
 import Aztec
 
-class GutenbergVideoUploadProcessor: Processor {
+class GutenbergVideoUploadProcessor: GutenbergBlockProcessorGroup {
 
     let mediaUploadID: Int32
     let remoteURLString: String
@@ -71,10 +71,8 @@ class GutenbergVideoUploadProcessor: Processor {
         return block
     })
 
-    func process(_ text: String) -> String {
-        var result = videoBlockProcessor.process(text)
-        result = mediaTextVideoBlockProcessor.process(result)
-        return result
+    var blockProcessors: [GutenbergBlockProcessor] {
+        return [videoBlockProcessor, mediaTextVideoBlockProcessor]
     }
 
 }
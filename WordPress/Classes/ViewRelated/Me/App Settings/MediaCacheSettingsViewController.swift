@@ -117,6 +117,7 @@ class MediaCacheSettingsViewController: UITableViewController {
         WPAnalytics.track(.appSettingsClearMediaCacheTapped)
 
         setMediaCacheRowDescription(status: .clearingCache)
+        ThumbnailDiskCache.clearCaches()
         MediaFileManager.clearAllMediaCacheFiles(onCompletion: { [weak self] in
             self?.updateMediaCacheSize()
             }, onError: { [weak self] (error) in
@@ -77,6 +77,10 @@ final class SiteMediaCollectionCellViewModel {
     func onAppear() {
         guard !isVisible else { return }
         isVisible = true
+        if imageTask != nil, supportsThumbnails {
+            // The thumbnail is already being prefetched – it's needed now
+            service.setPriority(.visible, forThumbnailOf: media, size: .small)
+        }
         fetchThumbnailIfNeeded()
     }
 
@@ -117,9 +121,10 @@ final class SiteMediaCollectionCellViewModel {
         guard getCachedThubmnail() == nil else {
             return // Already cached  in memory
         }
+        let priority: ImageRequestPriority = isVisible ? .visible : .prefetch
         imageTask = Task { @MainActor [service, media, weak self] in
             do {
-                let image = try await service.image(for: media, size: .small)
+                let image = try await service.image(for: media, size: .small, priority: priority)
                 self?.didFinishLoading(with: image)
             } catch {
                 self?.didFinishLoading(with: nil)
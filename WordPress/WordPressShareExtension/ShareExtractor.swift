@@ -220,6 +220,7 @@ private protocol ExtensionContentExtractor {
     func canHandle(context: NSExtensionContext) -> Bool
     func extract(context: NSExtensionContext, completion: @escaping ([ExtractedItem]) -> Void)
     func saveToSharedContainer(image: UIImage) -> URL?
+    func saveToSharedContainer(imageData: Data) -> URL?
     func saveToSharedContainer(wrapper: FileWrapper) -> URL?
     func copyToSharedContainer(url: URL) -> URL?
 }
@@ -232,11 +233,16 @@ private protocol TypeBasedExtensionContentExtractor: ExtensionContentExtractor {
 
 private extension TypeBasedExtensionContentExtractor {
 
+    /// Maximum Image Dimension, in pixels
+    ///
+    var maximumImageDimension: Int {
+        ShareExtensionService.retrieveShareExtensionMaximumMediaDimension() ?? Constants.defaultMaxDimension
+    }
+
     /// Maximum Image Size
     ///
     var maximumImageSize: CGSize {
-        let dimension = ShareExtensionService.retrieveShareExtensionMaximumMediaDimension() ?? Constants.defaultMaxDimension
-        return CGSize(width: dimension, height: dimension)
+        CGSize(width: maximumImageDimension, height: maximumImageDimension)
     }
 
     func canHandle(context: NSExtensionContext) -> Bool {
@@ -246,32 +252,41 @@ private extension TypeBasedExtensionContentExtractor {
     func extract(context: NSExtensionContext, completion: @escaping ([ExtractedItem]) -> Void) {
         let itemProviders = context.itemProviders(ofType: acceptedType)
         print(acceptedType)
-        var results = [ExtractedItem]()
         guard itemProviders.count > 0 else {
             DispatchQueue.main.async {
-                completion(results)
+                completion([])
             }
             return
         }
 
-        // There 1 or more valid item providers here, lets work through them
+        // There 1 or more valid item providers here, lets work through them. Only a few items
+        // are loaded and converted at the same time, so that the extension doesn't hold several
+        // large images in memory at once.
         let syncGroup = DispatchGroup()
-        for provider in itemProviders {
+        let slots = DispatchSemaphore(value: Constants.maxConcurrentExtractions)
+        let resultsLock = NSLock()
+        var orderedResults = [ExtractedItem?](repeating: nil, count: itemProviders.count)
+        for (index, provider) in itemProviders.enumerated() {
             syncGroup.enter()
-            // Remember, this is an async call....
-            provider.loadItem(forTypeIdentifier: acceptedType, options: nil) { (payload, error) in
-                let payload = payload as? Payload
-                let result = payload.flatMap(self.convert(payload:))
-                if let result = result {
-                    results.append(result)
+            Constants.extractionQueue.async {
+                slots.wait()
+                // Remember, this is an async call....
+                provider.loadItem(forTypeIdentifier: self.acceptedType, options: nil) { (payload, error) in
+                    let result = autoreleasepool {
+                        (payload as? Payload).flatMap(self.convert(payload:))
+                    }
+                    resultsLock.lock()
+                    orderedResults[index] = result
+                    resultsLock.unlock()
+                    slots.signal()
+                    syncGroup.leave()
                 }
-                syncGroup.leave()
             }
         }
 
         // Call the completion handler after all of the provider items are loaded
         syncGroup.notify(queue: DispatchQueue.main) {
-            completion(results)
+            completion(orderedResults.compactMap { $0 })
         }
     }
 
@@ -290,6 +305,21 @@ private extension TypeBasedExtensionContentExtractor {
         return fullPath
     }
 
+    /// Saves a JPEG version of the encoded image, without decoding the image at full size.
+    func saveToSharedContainer(imageData: Data) -> URL? {
+        guard let fullPath = tempPath(for: "jpg") else {
+            return nil
+        }
+
+        do {
+            try ImageDownsampler.downsampleImage(from: imageData, to: fullPath, maxPixelSize: maximumImageDimension)
+        } catch {
+            DDLogError("Error saving \(fullPath) to shared container: \(String(describing: error))")
+            return nil
+        }
+        return fullPath
+    }
+
     func saveToSharedContainer(wrapper: FileWrapper) -> URL? {
         guard let wrappedFileName = wrapper.filename?.addingPercentEncoding(withAllowedCharacters: .urlPathAllowed),
             let wrappedURL = URL(string: wrappedFileName),
@@ -409,8 +439,7 @@ private struct URLExtractor: TypeBasedExtensionContentExtractor {
             case "heic":
                 autoreleasepool {
                     if let file = fileWrapper.regularFileContents,
-                        let tmpImage = UIImage(data: file),
-                        let cachedURL = saveToSharedContainer(image: tmpImage) {
+                        let cachedURL = saveToSharedContainer(imageData: file) {
                         cachedImages["assets/\(fileName)"] = ExtractedImage(url: cachedURL, insertionState: .requiresInsertion)
 
                     }
@@ -510,8 +539,7 @@ private struct ImageExtractor: TypeBasedExtensionContentExtractor {
                 returnedItem.images = [ExtractedImage(url: imageURL, insertionState: .requiresInsertion)]
             }
         case let data as Data:
-            if let image = UIImage(data: data),
-                let imageURL = saveToSharedContainer(image: image) {
+            if let imageURL = saveToSharedContainer(imageData: data) {
                 returnedItem.images = [ExtractedImage(url: imageURL, insertionState: .requiresInsertion)]
             }
         case let image as UIImage:
@@ -630,4 +658,6 @@ private struct ShareBlogExtractor: TypeBasedExtensionContentExtractor {
 
 private enum Constants {
     static let defaultMaxDimension = 3000
+    static let maxConcurrentExtractions = 2
+    static let extractionQueue = DispatchQueue(label: "org.wordpress.share-extractor", qos: .userInitiated)
 }
@@ -92,6 +92,23 @@ class AccountServiceTests: CoreDataTestCase {
         try XCTAssertEqual(mainContext.count(for: WPAccount.fetchRequest()), 0)
     }
 
+    func testRemoveDefaultWordPressComAccountRemovesThumbnails() throws {
+        let thumbnailCache = ThumbnailDiskCache.shared
+        let key = "https://example.files.wordpress.com/private.jpg?w=100"
+        let image = UIGraphicsImageRenderer(size: CGSize(width: 10, height: 10)).image { context in
+            UIColor.red.setFill()
+            context.fill(CGRect(x: 0, y: 0, width: 10, height: 10))
+        }
+        thumbnailCache.store(image, forKey: key)
+        let stored = expectation(for: NSPredicate { _, _ in thumbnailCache.data(forKey: key) != nil }, evaluatedWith: nil)
+        wait(for: [stored], timeout: 2)
+
+        accountService.removeDefaultWordPressComAccount()
+
+        let removed = expectation(for: NSPredicate { _, _ in thumbnailCache.data(forKey: key) == nil }, evaluatedWith: nil)
+        wait(for: [removed], timeout: 2)
+    }
+
     func testCreateAccountSetsDefaultAccount() throws {
         XCTAssertNil(try WPAccount.lookupDefaultWordPressComAccount(in: contextManager.mainContext))
 
@@ -0,0 +1,79 @@
+import XCTest
+
+@testable import WordPress
+
+class BlogSyncSchedulerTests: CoreDataTestCase {
+
+    func testConcurrencyIsBounded() {
+        let scheduler = BlogSyncScheduler(maxConcurrentTasks: 2)
+        let plan = BlogSyncPlan(blog: BlogBuilder(mainContext).build())
+
+        var running = 0
+        var maxRunning = 0
+        for index in 0..<6 {
+            plan.addTask(named: "task\(index)", priority: .normal, dependencies: []) { done in
+                running += 1
+                maxRunning = max(maxRunning, running)
+                DispatchQueue.main.asyncAfter(deadline: .now() + 0.01) {
+                    running -= 1
+                    done()
+                }
+            }
+        }
+
+        let completed = expectation(description: "The plan is completed")
+        scheduler.run(plan, completion: completed.fulfill)
+        wait(for: [completed], timeout: 1)
+
+        XCTAssertEqual(maxRunning, 2)
+        XCTAssertEqual(scheduler.metrics.tasks, 6)
+    }
+
+    func testPrioritiesAndDependencies() {
+        let scheduler = BlogSyncScheduler(maxConcurrentTasks: 1)
+        let plan = BlogSyncPlan(blog: BlogBuilder(mainContext).build())
+
+        var started: [String] = []
+        let addTask: (String, BlogSyncTaskPriority, [String]) -> Void = { name, priority, dependencies in
+            plan.addTask(named: name, priority: priority, dependencies: dependencies) { done in
+                started.append(name)
+                DispatchQueue.main.async(execute: done)
+            }
+        }
+        addTask("low", .low, [])
+        addTask("details", .normal, [])
+        addTask("dependent", .high, ["details"])
+        addTask("high", .high, [])
+
+        let completed = expectation(description: "The plan is completed")
+        scheduler.run(plan, completion: completed.fulfill)
+        wait(for: [completed], timeout: 1)
+
+        XCTAssertEqual(started, ["high", "details", "dependent", "low"])
+    }
+
+    func testAccountTasksAreDeduplicated() {
+        let scheduler = BlogSyncScheduler(maxConcurrentTasks: 1)
+        let account = AccountBuilder(mainContext).build()
+
+        var plansFetched = 0
+        let plans = (0..<3).map { _ in
+            let plan = BlogSyncPlan(blog: BlogBuilder(mainContext).build())
+            plan.addAccountTask(named: "wpcomPlans", account: account, priority: .low) { done in
+                plansFetched += 1
+                DispatchQueue.main.async(execute: done)
+            }
+            return plan
+        }
+
+        let completions = plans.enumerated().map { index, plan in
+            let completed = expectation(description: "Plan \(index) is completed")
+            scheduler.run(plan, completion: completed.fulfill)
+            return completed
+        }
+        wait(for: completions, timeout: 1)
+
+        XCTAssertEqual(plansFetched, 1)
+        XCTAssertEqual(scheduler.metrics.deduplicated, 2)
+    }
+}
@@ -0,0 +1,158 @@
+import XCTest
+
+@testable import WordPress
+
+class StatsTieredCacheTests: XCTestCase {
+    private var name: String!
+    private var cache: StatsTieredCache<TestKey>!
+
+    override func setUp() {
+        super.setUp()
+
+        name = "Tests-\(UUID().uuidString)"
+        cache = StatsTieredCache(name: name, memoryCapacity: 2)
+    }
+
+    override func tearDown() {
+        cache.removeAll()
+        cache = nil
+        name = nil
+
+        super.tearDown()
+    }
+
+    func testValuesAreServedFromMemory() {
+        // Given
+        cache.setValue(TestValue(count: 1), forKey: TestKey(id: 1))
+
+        // When
+        let value: TestValue? = cache.value(forKey: TestKey(id: 1))
+
+        // Then
+        XCTAssertEqual(value, TestValue(count: 1))
+        XCTAssertEqual(cache.statistics.memoryHits, 1)
+        XCTAssertEqual(cache.statistics.misses, 0)
+    }
+
+    func testValuesSurviveANewInstance() {
+        // Given
+        cache.setValue(TestValue(count: 2), forKey: TestKey(id: 1))
+        cache.waitForPendingWrites()
+
+        // When
+        let relaunched = StatsTieredCache<TestKey>(name: name)
+        let value: TestValue? = relaunched.value(forKey: TestKey(id: 1))
+
+        // Then
+        XCTAssertEqual(value, TestValue(count: 2))
+        XCTAssertTrue(relaunched.hasValue(forKey: TestKey(id: 1)))
+        XCTAssertEqual(relaunched.statistics.diskHits, 1)
+    }
+
+    func testLeastRecentlyUsedValueIsEvictedFromMemory() {
+        // Given
+        let memoryOnly = StatsTieredCache<TestKey>(name: nil, memoryCapacity: 2)
+        memoryOnly.setValue(TestValue(count: 1), forKey: TestKey(id: 1))
+        memoryOnly.setValue(TestValue(count: 2), forKey: TestKey(id: 2))
+        let _: TestValue? = memoryOnly.value(forKey: TestKey(id: 1))
+
+        // When
+        memoryOnly.setValue(TestValue(count: 3), forKey: TestKey(id: 3))
+
+        // Then
+        XCTAssertTrue(memoryOnly.hasValue(forKey: TestKey(id: 1)))
+        XCTAssertFalse(memoryOnly.hasValue(forKey: TestKey(id: 2)))
+        XCTAssertTrue(memoryOnly.hasValue(forKey: TestKey(id: 3)))
+    }
+
+    func testExpiredValuesAreMisses() {
+        // Given
+        cache.setValue(TestValue(count: 1), forKey: TestKey(id: 1, timeToLive: -1))
+
+        // When
+        let value: TestValue? = cache.value(forKey: TestKey(id: 1, timeToLive: -1))
+
+        // Then
+        XCTAssertNil(value)
+        XCTAssertEqual(cache.statistics.misses, 1)
+    }
+
+    func testConcurrentReadsFromDisk() {
+        // Given
+        cache.setValue(TestValue(count: 4), forKey: TestKey(id: 1))
+        cache.waitForPendingWrites()
+        let relaunched = StatsTieredCache<TestKey>(name: name)
+
+        // When
+        let values = LockedValues()
+        DispatchQueue.concurrentPerform(iterations: 20) { _ in
+            let value: TestValue? = relaunched.value(forKey: TestKey(id: 1))
+            values.append(value)
+        }
+
+        // Then
+        XCTAssertEqual(values.values, Array(repeating: TestValue(count: 4), count: 20))
+        let statistics = relaunched.statistics
+        XCTAssertEqual(statistics.memoryHits + statistics.diskHits, 20)
+        XCTAssertEqual(statistics.misses, 0)
+    }
+
+    func testInsightsRecordsExpireAtTheirOwnPace() {
+        let todaysStats = StatsInsightsCache.CacheKey(record: .todaysStats, siteID: 1)
+        let allTimeStats = StatsInsightsCache.CacheKey(record: .allTimeStats, siteID: 1)
+
+        XCTAssertLessThan(todaysStats.timeToLive, allTimeStats.timeToLive)
+    }
+
+    func testRemoveAllClearsBothTiers() {
+        // Given
+        cache.setValue(TestValue(count: 1), forKey: TestKey(id: 1))
+        cache.waitForPendingWrites()
+
+        // When
+        cache.removeAll()
+
+        // Then
+        let relaunched = StatsTieredCache<TestKey>(name: name)
+        XCTAssertFalse(cache.hasValue(forKey: TestKey(id: 1)))
+        XCTAssertFalse(relaunched.hasValue(forKey: TestKey(id: 1)))
+    }
+}
+
+private struct TestKey: StatsTieredCacheKey {
+    let id: Int
+    var timeToLive: TimeInterval = 60
+
+    var fileName: String {
+        "test-\(id)"
+    }
+
+    static func == (lhs: TestKey, rhs: TestKey) -> Bool {
+        lhs.id == rhs.id
+    }
+
+    func hash(into hasher: inout Hasher) {
+        hasher.combine(id)
+    }
+}
+
+private struct TestValue: Codable, Equatable {
+    let count: Int
+}
+
+private final class LockedValues {
+    private let lock = NSLock()
+    private var _values: [TestValue?] = []
+
+    var values: [TestValue?] {
+        lock.lock()
+        defer { lock.unlock() }
+        return _values
+    }
+
+    func append(_ value: TestValue?) {
+        lock.lock()
+        _values.append(value)
+        lock.unlock()
+    }
+}
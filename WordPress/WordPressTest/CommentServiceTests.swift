@@ -1,5 +1,7 @@
 import Foundation
 import Nimble
+import OHHTTPStubs
+import OHHTTPStubsSwift
 import XCTest
 
 @testable import WordPress
@@ -7,6 +9,7 @@ import XCTest
 final class CommentServiceTests: CoreDataTestCase {
 
     private var remoteMock: CommentServiceRemoteRESTMock!
+    private var remoteFactory: CommentServiceRemoteFactoryMock!
     private var service: CommentService!
 
     // MARK: Lifecycle
@@ -17,7 +20,7 @@ final class CommentServiceTests: CoreDataTestCase {
         contextManager.useAsSharedInstance(untilTestFinished: self)
         remoteMock = CommentServiceRemoteRESTMock()
 
-        let remoteFactory = CommentServiceRemoteFactoryMock()
+        remoteFactory = CommentServiceRemoteFactoryMock()
         remoteFactory.restRemote = remoteMock
         service = CommentService(coreDataStack: contextManager, commentServiceRemoteFactory: remoteFactory)
     }
@@ -25,7 +28,9 @@ final class CommentServiceTests: CoreDataTestCase {
     override func tearDown() {
         super.tearDown()
 
+        HTTPStubs.removeAllStubs()
         service = nil
+        remoteFactory = nil
         remoteMock = nil
     }
 
@@ -42,6 +47,44 @@ final class CommentServiceTests: CoreDataTestCase {
 
         return RemoteLikeUser(dictionary: userDict, commentID: NSNumber(value: 1), siteID: NSNumber(value: 2))
     }
+
+    /// Makes the service talk to a REST remote, with its responses stubbed.
+    private func useStubbedRESTRemote(siteID: Int) {
+        remoteFactory.restRemote = CommentServiceRemoteREST(wordPressComRestApi: WordPressComRestApi(oAuthToken: "token"), siteID: NSNumber(value: siteID))
+    }
+
+    private func stubComments(_ comments: [[String: Any]], forPathContaining path: String) {
+        stub(condition: { $0.url?.path.contains(path) == true }) { _ in
+            HTTPStubsResponse(jsonObject: ["found": comments.count, "comments": comments], statusCode: 200, headers: nil)
+        }
+    }
+
+    private func remoteComment(id: Int, postID: Int, content: String) -> [String: Any] {
+        [
+            "ID": id,
+            "post": ["ID": postID, "title": "Post", "type": "post"],
+            "author": ["ID": 5, "login": "", "name": "Author", "URL": "", "avatar_URL": ""],
+            "date": "2023-03-17T19:27:43+00:00",
+            "URL": "https://example.com/post/#comment-\(id)",
+            "content": content,
+            "raw_content": content,
+            "status": "approved",
+            "parent": false,
+            "type": "comment",
+            "like_count": 0,
+            "i_like": false
+        ]
+    }
+
+    @discardableResult
+    private func makeComment(id: Int32, content: String, blog: Blog? = nil, post: ReaderPost? = nil) -> Comment {
+        let comment = Comment(context: mainContext)
+        comment.commentID = id
+        comment.content = content
+        comment.blog = blog
+        comment.post = post
+        return comment
+    }
 }
 
 // MARK: - Tests
@@ -92,12 +135,132 @@ extension CommentServiceTests {
     }
 }
 
+// MARK: - Merging Comments
+
+extension CommentServiceTests {
+
+    func testSyncingCommentsMergesUpdatedDeletedAndUnchangedComments() throws {
+        // Arrange
+        useStubbedRESTRemote(siteID: 1)
+        let blog = BlogBuilder(mainContext).with(dotComID: 1).build()
+        let updated = makeComment(id: 1, content: "Old", blog: blog)
+        let unchanged = makeComment(id: 2, content: "Unchanged", blog: blog)
+        makeComment(id: 3, content: "Deleted", blog: blog)
+        let unpublished = makeComment(id: 0, content: "Unpublished", blog: blog)
+        contextManager.saveContextAndWait(mainContext)
+
+        stubComments([
+            remoteComment(id: 1, postID: 10, content: "Updated"),
+            remoteComment(id: 2, postID: 10, content: "Unchanged"),
+            remoteComment(id: 4, postID: 10, content: "New")
+        ], forPathContaining: "/sites/1/comments")
+
+        // Act
+        waitUntil(timeout: .seconds(2)) { done in
+            self.service.syncComments(for: blog, withStatus: CommentStatusFilterAll, success: { _ in
+                done()
+            }, failure: { error in
+                fail("Unexpected error: \(String(describing: error))")
+                done()
+            })
+        }
+
+        // Assert
+        let comments = blog.comments as? Set<Comment> ?? []
+        let commentsByID = Dictionary(grouping: comments, by: \.commentID)
+        expect(comments.count) == 4
+        expect(commentsByID[1]) == [updated]
+        expect(updated.content) == "Updated"
+        expect(commentsByID[2]) == [unchanged]
+        expect(unchanged.content) == "Unchanged"
+        expect(commentsByID[3]).to(beNil())
+        expect(commentsByID[4]?.first?.content) == "New"
+        expect(commentsByID[0]) == [unpublished]
+    }
+
+    func testLoadingMoreCommentsKeepsTheCommentsMissingFromThePage() throws {
+        // Arrange
+        useStubbedRESTRemote(siteID: 1)
+        let blog = BlogBuilder(mainContext).with(dotComID: 1).build()
+        let updated = makeComment(id: 1, content: "Old", blog: blog)
+        let kept = makeComment(id: 3, content: "Kept", blog: blog)
+        contextManager.saveContextAndWait(mainContext)
+
+        stubComments([
+            remoteComment(id: 1, postID: 10, content: "Updated"),
+            remoteComment(id: 4, postID: 10, content: "New")
+        ], forPathContaining: "/sites/1/comments")
+
+        // Act
+        waitUntil(timeout: .seconds(2)) { done in
+            self.service.loadMoreComments(for: blog, withStatus: CommentStatusFilterAll, success: { _ in
+                done()
+            }, failure: { error in
+                fail("Unexpected error: \(String(describing: error))")
+                done()
+            })
+        }
+
+        // Assert
+        let comments = blog.comments as? Set<Comment> ?? []
+        let commentsByID = Dictionary(grouping: comments, by: \.commentID)
+        expect(comments.count) == 3
+        expect(commentsByID[1]) == [updated]
+        expect(updated.content) == "Updated"
+        expect(commentsByID[3]) == [kept]
+        expect(commentsByID[4]?.first?.content) == "New"
+    }
+
+    func testSyncingHierarchicalCommentsMergesUpdatedDeletedAndUnchangedComments() throws {
+        // Arrange
+        useStubbedRESTRemote(siteID: 1)
+        let post = ReaderPost(context: mainContext)
+        post.siteID = 1
+        post.postID = 10
+        let updated = makeComment(id: 1, content: "Old", post: post)
+        let unchanged = makeComment(id: 2, content: "Unchanged", post: post)
+        makeComment(id: 3, content: "Deleted", post: post)
+        contextManager.saveContextAndWait(mainContext)
+
+        stubComments([
+            remoteComment(id: 1, postID: 10, content: "Updated"),
+            remoteComment(id: 2, postID: 10, content: "Unchanged"),
+            remoteComment(id: 4, postID: 10, content: "New")
+        ], forPathContaining: "/sites/1/posts/10/replies")
+
+        // Act
+        waitUntil(timeout: .seconds(2)) { done in
+            self.service.syncHierarchicalComments(for: post, page: 1, success: { _, _ in
+                done()
+            }, failure: { error in
+                fail("Unexpected error: \(String(describing: error))")
+                done()
+            })
+        }
+
+        // Assert
+        let comments = post.comments as? Set<Comment> ?? []
+        let commentsByID = Dictionary(grouping: comments, by: \.commentID)
+        expect(comments.count) == 3
+        expect(commentsByID[1]) == [updated]
+        expect(updated.content) == "Updated"
+        expect(commentsByID[2]) == [unchanged]
+        expect(unchanged.content) == "Unchanged"
+        expect(commentsByID[3]).to(beNil())
+        expect(commentsByID[4]?.first?.content) == "New"
+    }
+}
+
 // MARK: - Mocks
 
 private class CommentServiceRemoteFactoryMock: CommentServiceRemoteFactory {
 
     var restRemote: CommentServiceRemoteREST = CommentServiceRemoteRESTMock()
 
+    override func remote(blog: Blog) -> CommentServiceRemote? {
+        return restRemote
+    }
+
     override func restRemote(siteID: NSNumber, api: WordPressComRestApi) -> CommentServiceRemoteREST {
         return restRemote
     }
@@ -321,6 +321,46 @@ class ContextManagerTests: XCTestCase {
         try XCTAssertEqual(contextManager.mainContext.count(for: request), 1)
     }
 
+    func testCoalescedWrites() throws {
+        let contextManager = ContextManager.forTesting()
+        contextManager.coalescesWrites = true
+
+        var allCompleted: [XCTestExpectation] = []
+        for userID in 1...20 {
+            let expectation = self.expectation(description: "Account \(userID) saved")
+            allCompleted.append(expectation)
+            contextManager.performAndSave({ context in
+                _ = WPAccount.fixture(context: context, userID: userID)
+                if userID == 10 {
+                    throw NSError.testInstance()
+                }
+            }, completion: { _ in expectation.fulfill() }, on: .main)
+        }
+        wait(for: allCompleted, timeout: 1, enforceOrder: true)
+
+        XCTAssertEqual(contextManager.mainContext.countObjects(ofType: WPAccount.self), 19, "Only the changes of the block that throws should be discarded")
+        try XCTAssertNil(WPAccount.lookup(withUserID: 10, in: contextManager.mainContext))
+
+        let metrics = try XCTUnwrap(contextManager.coalescedWriteMetrics)
+        XCTAssertEqual(metrics.blocks, 20)
+        XCTAssertGreaterThanOrEqual(metrics.changes, 19)
+        XCTAssertLessThan(metrics.batches, 20)
+    }
+
+    func testSyncAPISavesCoalescedWritesFirst() throws {
+        let contextManager = ContextManager.forTesting()
+        contextManager.coalescesWrites = true
+
+        contextManager.performAndSave({ context in
+            _ = WPAccount.fixture(context: context, userID: 1, username: "First User")
+        }, completion: nil, on: .main)
+
+        contextManager.performAndSave { context in
+            let account = try? WPAccount.lookup(withUserID: 1, in: context)
+            XCTAssertEqual(account?.username, "First User")
+        }
+    }
+
     func testConcurrencySyncAPI() throws {
         let contextManager = ContextManager.forTesting()
 
@@ -0,0 +1,88 @@
+import Foundation
+import XCTest
+@testable import WordPress
+
+class GutenbergBlockProcessorTests: XCTestCase {
+
+    func testSelfClosingAndNestedBlocks() {
+        let content = """
+<!-- wp:group --><div><!-- wp:group {"id":2} --><p>Inner</p><!-- /wp:group --></div><!-- /wp:group -->
+<!-- wp:group {"id":3} /-->
+"""
+        var contents: [String] = []
+        let processor = GutenbergBlockProcessor(for: "wp:group") { block in
+            contents.append(block.content)
+            guard let id = block.attributes["id"] as? Int else {
+                return nil
+            }
+            return "[\(id)]"
+        }
+
+        let result = processor.process(content)
+
+        XCTAssertEqual(result, """
+<!-- wp:group --><div>[2]</div><!-- /wp:group -->
+[3]
+""")
+        XCTAssertEqual(contents, ["<p>Inner</p>", "<div>[2]</div>", ""], "Each block should be resolved once, innermost first")
+    }
+
+    func testUnclosedBlocksAreIgnored() {
+        let content = "<!-- wp:video {\"id\":1} --><video></video>"
+        let processor = GutenbergBlockProcessor(for: "wp:video") { _ in "replaced" }
+
+        XCTAssertEqual(processor.process(content), content)
+    }
+
+    func testBlockNamesMustMatchExactly() {
+        let content = "<!-- wp:videopress/video {\"id\":1} /-->"
+        let processor = GutenbergBlockProcessor(for: "wp:video") { _ in "replaced" }
+
+        XCTAssertEqual(processor.process(content), content)
+    }
+
+    func testSeveralProcessorsInOnePass() {
+        let content = makeGallery(count: 3)
+        let processors = (0..<3).map { index in
+            GutenbergBlockProcessor(for: "wp:image") { block in
+                guard block.attributes["id"] as? Int == -index else {
+                    return nil
+                }
+                return "<!-- wp:image {\"id\":\(index + 100)} /-->"
+            }
+        }
+
+        let result = GutenbergBlockProcessor.process(content, with: processors)
+
+        XCTAssertEqual(result, """
+<!-- wp:gallery --><figure>\
+<!-- wp:image {"id":100} /-->\
+<!-- wp:image {"id":101} /-->\
+<!-- wp:image {"id":102} /-->\
+</figure><!-- /wp:gallery -->
+""")
+    }
+
+    func xtestPerformanceLargeGallery() {
+        let content = makeGallery(count: 200)
+        let processors = (0..<200).map { index in
+            GutenbergBlockProcessor(for: "wp:image") { block in
+                guard block.attributes["id"] as? Int == -index else {
+                    return nil
+                }
+                return "<!-- wp:image {\"id\":\(index + 100)} /-->"
+            }
+        }
+
+        measure {
+            _ = GutenbergBlockProcessor.process(content, with: processors)
+        }
+    }
+
+    private func makeGallery(count: Int) -> String {
+        let images = (0..<count).map { index in
+            "<!-- wp:image {\"id\":\(-index)} --><figure class=\"wp-block-image\"><img src=\"file:///\(index).jpg\" class=\"wp-image-\(-index)\"/></figure><!-- /wp:image -->"
+        }
+        return "<!-- wp:gallery --><figure>" + images.joined() + "</figure><!-- /wp:gallery -->"
+    }
+}
@@ -188,4 +188,42 @@ class GutenbergContentParserTests: XCTestCase {
 
         XCTAssertEqual(parser.html(), expectedResult, "Parsed content should contain the modifications")
     }
+
+    func testParserOnlySerializesModifiedBlocks() {
+        let content = """
+        <!-- wp:image {"id":1} -->
+        <figure class="wp-block-image"><img src="file:///1.jpg"/></figure>
+        <!-- /wp:image -->
+        <p>Classic<br>content</p>
+        <!-- wp:image {"id":2} -->
+        <figure class="wp-block-image"><img src="file:///2.jpg"/></figure>
+        <!-- /wp:image -->
+        """
+        let parser = GutenbergContentParser(for: content)
+        try! parser.blocks[1].elements.select("img").first()?.attr("src", "remote-url")
+
+        let expectedResult = """
+        <!-- wp:image {"id":1} -->
+        <figure class="wp-block-image"><img src="file:///1.jpg"/></figure>
+        <!-- /wp:image -->
+        <p>Classic<br>content</p>
+        <!-- wp:image {"id":2} -->
+        <figure class="wp-block-image"><img src="remote-url" /></figure>
+        <!-- /wp:image -->
+        """
+
+        XCTAssertEqual(parser.html(), expectedResult, "Only the modified block should be serialized again")
+    }
+
+    func testParserModifySelfClosingBlockAttributes() {
+        let parser = GutenbergContentParser(for: "<p>Text</p><!-- wp:spacer {\"height\":10} /--><p>Text</p>")
+        let block = parser.blocks[0]
+
+        XCTAssertEqual(block.attributes["height"] as? Int, 10, "Height attribute matches block's attribute")
+        XCTAssertEqual(block.content, "", "Self-closing blocks shouldn't have content")
+
+        block.attributes["height"] = 20
+
+        XCTAssertEqual(parser.html(), "<p>Text</p><!-- wp:spacer {\"height\":20} /--><p>Text</p>", "Parsed content should contain the modifications")
+    }
 }
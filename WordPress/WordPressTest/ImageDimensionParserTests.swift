@@ -57,7 +57,129 @@ class ImageDimensionParserTests: XCTestCase {
         XCTAssertEqual(parser.imageSize, CGSize(width: 100, height: 100))
     }
 
+    /// Test a 1024x772 lossy WebP file
+    func testWebPDimensions() {
+        let data = dataForFile(with: "test-webp.webp")
+        let parser = ImageDimensionParser(with: data)
+
+        XCTAssertEqual(parser.format, ImageDimensionFormat.webp)
+        XCTAssertEqual(parser.imageSize, CGSize(width: 1024, height: 772))
+    }
+
+    /// Test a lossless WebP header
+    func testWebPLosslessDimensions() {
+        // 14 bits for width - 1 (399) and 14 bits for height - 1 (299)
+        let bits = UInt32(399) | UInt32(299) << 14
+        let payload = [0x2F] + withUnsafeBytes(of: bits.littleEndian, Array.init)
+        let parser = ImageDimensionParser(with: webpData(chunk: "VP8L", payload: payload))
+
+        XCTAssertEqual(parser.format, ImageDimensionFormat.webp)
+        XCTAssertEqual(parser.imageSize, CGSize(width: 400, height: 300))
+    }
+
+    /// Test an extended WebP header
+    func testWebPExtendedDimensions() {
+        // Flags, then 24 bits for canvas width - 1 (4999) and height - 1 (2999)
+        let payload: [UInt8] = [0x10, 0, 0, 0, 0x87, 0x13, 0x00, 0xB7, 0x0B, 0x00]
+        let parser = ImageDimensionParser(with: webpData(chunk: "VP8X", payload: payload))
+
+        XCTAssertEqual(parser.format, ImageDimensionFormat.webp)
+        XCTAssertEqual(parser.imageSize, CGSize(width: 5000, height: 3000))
+    }
+
+    /// Test a HEIC file with a thumbnail, delivered in small chunks
+    func testHEICDimensions() {
+        let data = isoData(brands: ["heic", "mif1"], extents: [(320, 240), (4032, 3024)])
+        let parser = ImageDimensionParser()
+        for chunk in stride(from: 0, to: data.count, by: 7) {
+            parser.append(bytes: data.subdata(in: chunk..<min(chunk + 7, data.count)))
+        }
+
+        XCTAssertEqual(parser.format, ImageDimensionFormat.heic)
+        XCTAssertEqual(parser.imageSize, CGSize(width: 4032, height: 3024))
+    }
+
+    /// Test an AVIF file
+    func testAVIFDimensions() {
+        let data = isoData(brands: ["avif", "mif1"], extents: [(1920, 1080)])
+        let parser = ImageDimensionParser(with: data)
+
+        XCTAssertEqual(parser.format, ImageDimensionFormat.avif)
+        XCTAssertEqual(parser.imageSize, CGSize(width: 1920, height: 1080))
+    }
+
+    /// Test HEIC files with a box after `ftyp` whose 64 bit size is too large to be real
+    func testHEICWithOversizedBox() {
+        let ftyp = isoData(brands: ["heic", "mif1"], extents: []).prefix(24)
+        for type in ["meta", "free"] {
+            let largeBox = Data([0, 0, 0, 1]) + Data(type.utf8) + Data(repeating: 0xFF, count: 8)
+            let parser = ImageDimensionParser(with: ftyp + largeBox + Data(count: 16))
+
+            XCTAssertEqual(parser.format, ImageDimensionFormat.heic)
+            XCTAssertNil(parser.imageSize, "Unexpected size after a \(type) box")
+        }
+    }
+
+    // MARK: - Streaming
+
+    /// Test a 100x100 JPEG file delivered one byte at a time
+    func testJPEGDimensionsFromSingleBytes() {
+        let data = dataForFile(with: "100x100.jpg")
+        let parser = ImageDimensionParser()
+        for byte in data {
+            parser.append(bytes: Data([byte]))
+        }
+
+        XCTAssertEqual(parser.format, ImageDimensionFormat.jpeg)
+        XCTAssertEqual(parser.imageSize, CGSize(width: 100, height: 100))
+    }
+
+    /// Test a JPEG file with a segment that is larger than the chunks it arrives in
+    func testJPEGDimensionsAfterLargeSegment() {
+        let app1 = [0xFF, 0xE1, 0xFF, 0xFE] + [UInt8](repeating: 0, count: 0xFFFC)
+        let sof2: [UInt8] = [0xFF, 0xC2, 0x00, 0x11, 0x08, 0x02, 0x58, 0x03, 0x20]
+        let data = Data([0xFF, 0xD8] + app1 + sof2)
+        let parser = ImageDimensionParser()
+        for chunk in stride(from: 0, to: data.count, by: 4096) {
+            parser.append(bytes: data.subdata(in: chunk..<min(chunk + 4096, data.count)))
+        }
+
+        XCTAssertEqual(parser.imageSize, CGSize(width: 800, height: 600))
+    }
+
     // MARK: - Private: Helpers
+    private func webpData(chunk: String, payload: [UInt8]) -> Data {
+        var data = Data("RIFF".utf8)
+        data.append(contentsOf: [0, 0, 0, 0])
+        data.append(contentsOf: Data("WEBP".utf8))
+        data.append(contentsOf: Data(chunk.utf8))
+        data.append(contentsOf: withUnsafeBytes(of: UInt32(payload.count).littleEndian, Array.init))
+        data.append(contentsOf: payload)
+        return data
+    }
+
+    /// Builds `ftyp` and `meta/iprp/ipco/ispe` boxes, followed by some image data.
+    private func isoData(brands: [String], extents: [(UInt32, UInt32)]) -> Data {
+        func box(_ type: String, _ payload: Data) -> Data {
+            var data = Data(withUnsafeBytes(of: UInt32(payload.count + 8).bigEndian, Array.init))
+            data.append(contentsOf: Data(type.utf8))
+            data.append(payload)
+            return data
+        }
+        let fullBoxHeader = Data([0, 0, 0, 0])
+
+        let ftyp = box("ftyp", Data(brands[0].utf8) + fullBoxHeader + brands.map { Data($0.utf8) }.reduce(Data(), +))
+        let properties = extents.map { width, height in
+            box("ispe", fullBoxHeader
+                + withUnsafeBytes(of: width.bigEndian, Array.init)
+                + withUnsafeBytes(of: height.bigEndian, Array.init))
+        }
+        let ipco = box("ipco", box("hvcC", Data(count: 32)) + properties.reduce(Data(), +))
+        let meta = box("meta", fullBoxHeader + box("hdlr", Data(count: 24)) + box("iprp", ipco))
+        return ftyp + meta + box("mdat", Data(count: 64))
+    }
+
+
     private func dataForFile(with name: String) -> Data {
         let url = Bundle(for: ImageDimensionParserTests.self).url(forResource: name, withExtension: nil)!
         return try! Data(contentsOf: url)
@@ -125,6 +125,96 @@ class ImageDownloaderTests: CoreDataTestCase {
         XCTAssertEqual(image.size, CGSize(width: 1024, height: 680))
     }
 
+    func testRequestsOverCapacityAllComplete() async throws {
+        // GIVEN more requests than the downloader runs concurrently
+        try mockResponse(withResource: "test-image", fileExtension: "jpg", delay: 0.1)
+        let imageURLs = try (0..<20).map {
+            try XCTUnwrap(URL(string: "https://example.files.wordpress.com/2023/09/image-\($0).jpg"))
+        }
+
+        // WHEN
+        let sizes = try await withThrowingTaskGroup(of: CGSize.self) { group in
+            for (index, imageURL) in imageURLs.enumerated() {
+                let options = ImageRequestOptions(
+                    size: CGSize(width: 256, height: 256),
+                    isMemoryCacheEnabled: false,
+                    isDiskCacheEnabled: false,
+                    priority: index.isMultiple(of: 2) ? .visible : .prefetch
+                )
+                group.addTask { try await self.sut.image(from: imageURL, options: options).size }
+            }
+            return try await group.reduce(into: []) { $0.append($1) }
+        }
+
+        // THEN
+        XCTAssertEqual(sizes.count, 20)
+        XCTAssertTrue(sizes.allSatisfy { $0 == CGSize(width: 386, height: 256) })
+    }
+
+    func testCancelledRequestWaitingForCapacity() async throws {
+        // GIVEN the downloader is at capacity
+        try mockResponse(withResource: "test-image", fileExtension: "jpg", delay: 1)
+        let options = ImageRequestOptions(isMemoryCacheEnabled: false, isDiskCacheEnabled: false, priority: .prefetch)
+        let busy = try (0..<6).map { index in
+            let imageURL = try XCTUnwrap(URL(string: "https://example.files.wordpress.com/2023/09/busy-\(index).jpg"))
+            return Task { try await sut.image(from: imageURL, options: options) }
+        }
+
+        // WHEN a pending request is cancelled
+        let imageURL = try XCTUnwrap(URL(string: "https://example.files.wordpress.com/2023/09/image.jpg"))
+        let task = Task { try await sut.image(from: imageURL, options: options) }
+        try await Task.sleep(nanoseconds: 100_000_000)
+        task.cancel()
+
+        // THEN it fails without waiting for a slot
+        do {
+            _ = try await task.value
+            XCTFail("Expected the request to be cancelled")
+        } catch {
+            XCTAssertTrue(error is CancellationError)
+        }
+        busy.forEach { $0.cancel() }
+    }
+
+    func testSetPriorityForPrivateSiteImage() async throws {
+        // GIVEN the downloader is at capacity, and one slot frees up first
+        let sourceURL = try XCTUnwrap(Bundle.test.url(forResource: "test-image", withExtension: "jpg"))
+        let data = try Data(contentsOf: sourceURL)
+        let startedURLs = LockedURLs()
+        stub(condition: { _ in true }) { request in
+            startedURLs.append(request.url)
+            let path = request.url?.lastPathComponent ?? ""
+            let delay: TimeInterval = path.hasPrefix("busy-0") ? 0.3 : (path.hasPrefix("busy") ? 1 : 0)
+            return HTTPStubsResponse(data: data, statusCode: 200, headers: nil)
+                .requestTime(delay, responseTime: 0)
+        }
+        let options = ImageRequestOptions(isMemoryCacheEnabled: false, isDiskCacheEnabled: false, priority: .prefetch)
+        let busy = try (0..<6).map { index in
+            let imageURL = try XCTUnwrap(URL(string: "https://example.files.wordpress.com/2023/09/busy-\(index).jpg"))
+            return Task { try await sut.data(from: imageURL, host: .publicSite, options: options) }
+        }
+        try await Task.sleep(nanoseconds: 50_000_000)
+
+        // GIVEN two prefetched images are waiting, the private one last. The
+        // authenticated request of the private one uses HTTPS.
+        let publicURL = try XCTUnwrap(URL(string: "https://example.files.wordpress.com/2023/09/public.jpg"))
+        let privateURL = try XCTUnwrap(URL(string: "http://private.files.wordpress.com/2023/09/private.jpg"))
+        let publicTask = Task { try await sut.data(from: publicURL, host: .publicSite, options: options) }
+        try await Task.sleep(nanoseconds: 50_000_000)
+        let privateTask = Task { try await sut.data(from: privateURL, host: .privateWPComSite(authToken: "token"), options: options) }
+        try await Task.sleep(nanoseconds: 50_000_000)
+
+        // WHEN the private image becomes visible
+        await sut.setPriority(.visible, for: privateURL, host: .privateWPComSite(authToken: "token"))
+
+        // THEN it takes the first free slot
+        _ = try await privateTask.value
+        _ = try await publicTask.value
+        let started = startedURLs.urls.map(\.lastPathComponent).filter { !$0.hasPrefix("busy") }
+        XCTAssertEqual(started, ["private.jpg", "public.jpg"])
+        busy.forEach { $0.cancel() }
+    }
+
     // MARK: - Helpers
 
     /// `Media` is hardcoded to work with a specific direcoty URL managed by `MediaFileManager`
@@ -159,3 +249,21 @@ private final class MockMemoryCache: MemoryCacheProtocol {
         set { cache[key] = newValue }
     }
 }
+
+private final class LockedURLs {
+    private let lock = NSLock()
+    private var _urls: [URL] = []
+
+    var urls: [URL] {
+        lock.lock()
+        defer { lock.unlock() }
+        return _urls
+    }
+
+    func append(_ url: URL?) {
+        guard let url else { return }
+        lock.lock()
+        _urls.append(url)
+        lock.unlock()
+    }
+}
@@ -0,0 +1,106 @@
+import XCTest
+import ImageIO
+import UniformTypeIdentifiers
+@testable import WordPress
+
+class ImageDownsamplerTests: XCTestCase {
+
+    private var directoryURL: URL!
+
+    override func setUpWithError() throws {
+        try super.setUpWithError()
+        directoryURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(at: directoryURL, withIntermediateDirectories: true)
+    }
+
+    override func tearDownWithError() throws {
+        try FileManager.default.removeItem(at: directoryURL)
+        try super.tearDownWithError()
+    }
+
+    func testDownsampledImageIsRotatedAndFitsTheMaximumSize() throws {
+        // A landscape image shown in portrait.
+        let sourceURL = try makeImage(width: 400, height: 200, orientation: .right)
+        let destinationURL = directoryURL.appendingPathComponent("output.jpg")
+
+        try ImageDownsampler.downsampleImage(at: sourceURL, to: destinationURL, maxPixelSize: 100)
+
+        let properties = try imageProperties(at: destinationURL)
+        XCTAssertEqual(properties[kCGImagePropertyPixelWidth] as? Int, 50)
+        XCTAssertEqual(properties[kCGImagePropertyPixelHeight] as? Int, 100)
+        XCTAssertEqual(properties[kCGImagePropertyOrientation] as? UInt32, CGImagePropertyOrientation.up.rawValue)
+    }
+
+    func testSmallImagesAreNotUpscaled() throws {
+        let sourceURL = try makeImage(width: 80, height: 60)
+        let data = try Data(contentsOf: sourceURL)
+        let destinationURL = directoryURL.appendingPathComponent("output.jpg")
+
+        try ImageDownsampler.downsampleImage(from: data, to: destinationURL, maxPixelSize: 2000)
+
+        let properties = try imageProperties(at: destinationURL)
+        XCTAssertEqual(properties[kCGImagePropertyPixelWidth] as? Int, 80)
+        XCTAssertEqual(properties[kCGImagePropertyPixelHeight] as? Int, 60)
+    }
+
+    func testInvalidDataThrows() {
+        let destinationURL = directoryURL.appendingPathComponent("output.jpg")
+
+        XCTAssertThrowsError(try ImageDownsampler.downsampleImage(from: Data("not an image".utf8), to: destinationURL, maxPixelSize: 100))
+    }
+
+    // MARK: - Performance
+
+    // Records the peak memory used to downsample a photo to the default share extension size.
+
+    func xtestMemory12MP() throws {
+        try measureDownsampling(width: 4032, height: 3024)
+    }
+
+    func xtestMemory24MP() throws {
+        try measureDownsampling(width: 6000, height: 4000)
+    }
+
+    func xtestMemory48MP() throws {
+        try measureDownsampling(width: 8064, height: 6048)
+    }
+
+    // MARK: - Helpers
+
+    private func measureDownsampling(width: Int, height: Int) throws {
+        let sourceURL = try makeImage(width: width, height: height)
+        let destinationURL = directoryURL.appendingPathComponent("output.jpg")
+
+        measure(metrics: [XCTMemoryMetric(), XCTClockMetric()]) {
+            XCTAssertNoThrow(try ImageDownsampler.downsampleImage(at: sourceURL, to: destinationURL, maxPixelSize: 3000))
+        }
+    }
+
+    /// Writes a JPEG with a gradient, so that it doesn't compress to almost nothing.
+    private func makeImage(width: Int, height: Int, orientation: CGImagePropertyOrientation = .up) throws -> URL {
+        let context = try XCTUnwrap(CGContext(
+            data: nil,
+            width: width,
+            height: height,
+            bitsPerComponent: 8,
+            bytesPerRow: 0,
+            space: CGColorSpaceCreateDeviceRGB(),
+            bitmapInfo: CGImageAlphaInfo.noneSkipLast.rawValue
+        ))
+        let colors = [CGColor(red: 1, green: 0, blue: 0, alpha: 1), CGColor(red: 0, green: 0, blue: 1, alpha: 1)] as CFArray
+        let gradient = try XCTUnwrap(CGGradient(colorsSpace: CGColorSpaceCreateDeviceRGB(), colors: colors, locations: nil))
+        context.drawLinearGradient(gradient, start: .zero, end: CGPoint(x: width, y: height), options: [])
+        let image = try XCTUnwrap(context.makeImage())
+
+        let url = directoryURL.appendingPathComponent("\(UUID().uuidString).jpg")
+        let destination = try XCTUnwrap(CGImageDestinationCreateWithURL(url as CFURL, UTType.jpeg.identifier as CFString, 1, nil))
+        CGImageDestinationAddImage(destination, image, [kCGImagePropertyOrientation: orientation.rawValue] as CFDictionary)
+        XCTAssertTrue(CGImageDestinationFinalize(destination))
+        return url
+    }
+
+    private func imageProperties(at url: URL) throws -> [CFString: Any] {
+        let source = try XCTUnwrap(CGImageSourceCreateWithURL(url as CFURL, nil))
+        return try XCTUnwrap(CGImageSourceCopyPropertiesAtIndex(source, 0, nil) as? [CFString: Any])
+    }
+}
@@ -0,0 +1,58 @@
+import XCTest
+
+@testable import WordPress
+
+class MediaReferenceRewriterTests: CoreDataTestCase {
+
+    func testRewritesEveryMediaInOnePass() throws {
+        // Given
+        let first = try makeImage(mediaID: 101, remoteURL: "https://example.com/first.jpg")
+        let second = try makeImage(mediaID: 102, remoteURL: "https://example.com/second.jpg")
+        let content = """
+<!-- wp:gallery {"linkTo":"none"} -->
+<figure class="wp-block-gallery"><!-- wp:image {"id":\(first.gutenbergUploadID)} -->
+<figure class="wp-block-image"><img src="file:///first.jpg" class="wp-image-\(first.gutenbergUploadID)"/></figure>
+<!-- /wp:image --><!-- wp:image {"id":\(second.gutenbergUploadID)} -->
+<figure class="wp-block-image"><img src="file:///second.jpg" class="wp-image-\(second.gutenbergUploadID)"/></figure>
+<!-- /wp:image --></figure>
+<!-- /wp:gallery -->
+<!-- wp:cover {"id":\(second.gutenbergUploadID),"url":"file:///second.jpg"} -->
+<div class="wp-block-cover"></div>
+<!-- /wp:cover -->
+"""
+
+        // When
+        let result = MediaReferenceRewriter(media: [first, second]).rewrite(content)
+
+        // Then the image blocks are updated
+        XCTAssertTrue(result.contains("<!-- wp:image {\"id\":101} -->"))
+        XCTAssertTrue(result.contains("src=\"https://example.com/first.jpg\" class=\"wp-image-101\""))
+        XCTAssertTrue(result.contains("<!-- wp:image {\"id\":102} -->"))
+        XCTAssertTrue(result.contains("src=\"https://example.com/second.jpg\" class=\"wp-image-102\""))
+
+        // Then the cover block is updated too
+        XCTAssertTrue(result.contains("<!-- wp:cover {\"id\":102,\"url\":\"https:\\/\\/example.com\\/second.jpg\"} -->"))
+        XCTAssertFalse(result.contains("file:///"))
+    }
+
+    func testSkipsMediaThatFailedToUpload() throws {
+        // Given
+        let media = try makeImage(mediaID: 101, remoteURL: "https://example.com/first.jpg")
+        media.remoteStatus = .failed
+
+        // When
+        let rewriter = MediaReferenceRewriter(media: [media])
+
+        // Then
+        XCTAssertTrue(rewriter.isEmpty)
+    }
+
+    private func makeImage(mediaID: Int, remoteURL: String) throws -> Media {
+        let media = MediaBuilder(mainContext).with(remoteStatus: .sync).build()
+        media.mediaType = .image
+        media.mediaID = NSNumber(value: mediaID)
+        media.remoteURL = remoteURL
+        try mainContext.obtainPermanentIDs(for: [media])
+        return media
+    }
+}
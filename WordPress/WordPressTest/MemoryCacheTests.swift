@@ -0,0 +1,105 @@
+import XCTest
+@testable import WordPress
+
+class MemoryCacheTests: XCTestCase {
+
+    // MARK: - LRUCache
+
+    func testLeastRecentlyUsedEntriesAreEvictedFirst() {
+        // GIVEN
+        let cache = LRUCache<String, Int>(costLimit: 30)
+        cache.setValue(1, forKey: "a", cost: 10)
+        cache.setValue(2, forKey: "b", cost: 10)
+        cache.setValue(3, forKey: "c", cost: 10)
+
+        // WHEN "a" is accessed and a new entry pushes the cache over the limit
+        _ = cache.value(forKey: "a")
+        cache.setValue(4, forKey: "d", cost: 10)
+
+        // THEN "b" is evicted
+        XCTAssertEqual(cache.value(forKey: "a"), 1)
+        XCTAssertNil(cache.value(forKey: "b"))
+        XCTAssertEqual(cache.value(forKey: "c"), 3)
+        XCTAssertEqual(cache.value(forKey: "d"), 4)
+        XCTAssertEqual(cache.totalCost, 30)
+    }
+
+    func testReplacingAnEntryUpdatesTheCost() {
+        // GIVEN
+        let cache = LRUCache<String, Int>(costLimit: 100)
+        cache.setValue(1, forKey: "a", cost: 40)
+
+        // WHEN
+        cache.setValue(2, forKey: "a", cost: 10)
+
+        // THEN
+        XCTAssertEqual(cache.value(forKey: "a"), 2)
+        XCTAssertEqual(cache.totalCost, 10)
+    }
+
+    func testEntriesLargerThanTheLimitAreNotStored() {
+        // GIVEN
+        let cache = LRUCache<String, Int>(costLimit: 10)
+
+        // WHEN
+        cache.setValue(1, forKey: "a", cost: 11)
+
+        // THEN
+        XCTAssertNil(cache.value(forKey: "a"))
+        XCTAssertEqual(cache.totalCost, 0)
+    }
+
+    func testTrimAndMetrics() {
+        // GIVEN
+        let cache = LRUCache<String, Int>(costLimit: 100)
+        for index in 0..<10 {
+            cache.setValue(index, forKey: "\(index)", cost: 10)
+        }
+
+        // WHEN
+        cache.trim(toCost: 50)
+
+        // THEN the oldest half is gone
+        XCTAssertNil(cache.value(forKey: "0"))
+        XCTAssertEqual(cache.value(forKey: "9"), 9)
+        XCTAssertEqual(cache.totalCost, 50)
+        XCTAssertEqual(cache.metrics.hits, 1)
+        XCTAssertEqual(cache.metrics.misses, 1)
+        XCTAssertEqual(cache.metrics.hitRate, 0.5)
+    }
+
+    // MARK: - MemoryCache
+
+    func testMemoryWarningsTrimInStages() throws {
+        // GIVEN
+        let cache = MemoryCache()
+        let image = try XCTUnwrap(makeImage())
+        for index in 0..<4 {
+            cache.setImage(image, forKey: "image-\(index)")
+        }
+        cache.setData(Data(count: 1000), forKey: "data")
+
+        // WHEN
+        cache.didReceiveMemoryWarning()
+
+        // THEN the least recently used half of the bitmaps is gone
+        XCTAssertNil(cache.getImage(forKey: "image-0"))
+        XCTAssertNil(cache.getImage(forKey: "image-1"))
+        XCTAssertNotNil(cache.getImage(forKey: "image-3"))
+
+        // WHEN another warning follows shortly after
+        cache.didReceiveMemoryWarning()
+
+        // THEN all bitmaps are gone
+        XCTAssertNil(cache.getImage(forKey: "image-3"))
+    }
+
+    private func makeImage() -> UIImage? {
+        let format = UIGraphicsImageRendererFormat()
+        format.scale = 1
+        return UIGraphicsImageRenderer(size: CGSize(width: 10, height: 10), format: format).image { context in
+            UIColor.red.setFill()
+            context.fill(CGRect(x: 0, y: 0, width: 10, height: 10))
+        }
+    }
+}
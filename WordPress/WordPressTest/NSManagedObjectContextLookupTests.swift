@@ -0,0 +1,56 @@
+import CoreData
+import XCTest
+
+@testable import WordPress
+
+class NSManagedObjectContextLookupTests: CoreDataTestCase {
+
+    func testLookupChecksCachedObjects() throws {
+        // Given
+        let blog = BlogBuilder(mainContext).build()
+        let comment = NSEntityDescription.insertNewObject(forEntityName: Comment.entityName(), into: mainContext) as! Comment
+        comment.commentID = 1
+        comment.blog = blog
+        contextManager.saveContextAndWait(mainContext)
+
+        XCTAssertEqual(blog.comment(withID: 1), comment)
+
+        // When the key changes
+        comment.commentID = 2
+
+        // Then the cached object isn't returned for the old key
+        XCTAssertNil(blog.comment(withID: 1))
+        XCTAssertEqual(blog.comment(withID: 2), comment)
+
+        // When the object is deleted
+        mainContext.delete(comment)
+        contextManager.saveContextAndWait(mainContext)
+
+        // Then
+        XCTAssertNil(blog.comment(withID: 2))
+    }
+
+    func testLookupBlogByDotComID() throws {
+        // Given
+        let blog = BlogBuilder(mainContext).withAnAccount().build()
+        let account = try XCTUnwrap(blog.account)
+        contextManager.saveContextAndWait(mainContext)
+
+        // Then
+        XCTAssertEqual(Blog.lookup(dotComID: try XCTUnwrap(blog.dotComID), in: account), blog)
+        XCTAssertNil(Blog.lookup(dotComID: NSNumber(value: -1), in: account))
+    }
+
+    func testFetchIndexAudit() throws {
+        let comment = try XCTUnwrap(NSEntityDescription.entity(forEntityName: "Comment", in: mainContext))
+        let readerPost = try XCTUnwrap(NSEntityDescription.entity(forEntityName: "ReaderPost", in: mainContext))
+
+        XCTAssertTrue(FetchIndexAudit.isIndexed(NSPredicate(format: "post == nil AND commentID == 1"), for: comment))
+        XCTAssertTrue(FetchIndexAudit.isIndexed(NSPredicate(format: "globalID IN %@", ["1", "2"]), for: readerPost))
+        XCTAssertTrue(FetchIndexAudit.isIndexed(NSPredicate(format: "authorID == 1"), for: readerPost), "Indexes of the parent entity should be used")
+
+        XCTAssertFalse(FetchIndexAudit.isIndexed(NSPredicate(format: "content == 'Hello'"), for: comment))
+        XCTAssertFalse(FetchIndexAudit.isIndexed(NSPredicate(format: "commentID == 1"), for: comment), "Only the first property of an index can be looked up")
+        XCTAssertFalse(FetchIndexAudit.isIndexed(NSPredicate(format: "globalID == '1' OR postTitle == 'Hello'"), for: readerPost))
+    }
+}
@@ -0,0 +1,80 @@
+import XCTest
+
+@testable import WordPress
+
+class PostHelperMergeTests: CoreDataTestCase {
+
+    func testMergeUpdatesExistingPostsAndCreatesNewOnes() throws {
+        // Given
+        let blog = BlogBuilder(mainContext).build()
+        let existing = PostBuilder(mainContext, blog: blog).build()
+        existing.postID = 1
+
+        // When
+        let posts = PostHelper.mergePosts(
+            [try makeRemotePost(id: 1), try makeRemotePost(id: 2)],
+            ofType: PostServiceType.post.rawValue,
+            withStatuses: nil,
+            byAuthor: nil,
+            for: blog,
+            purgeExisting: false,
+            in: mainContext
+        )
+
+        // Then
+        XCTAssertEqual(posts.count, 2)
+        XCTAssertIdentical(posts.first as? AbstractPost, existing)
+        XCTAssertEqual((posts.last as? AbstractPost)?.postID, 2)
+    }
+
+    func testMergeFindsPostsByForeignID() throws {
+        // Given
+        let blog = BlogBuilder(mainContext).build()
+        let existing = PostBuilder(mainContext, blog: blog).build()
+        existing.foreignID = UUID()
+        let remotePost = try makeRemotePost(id: 3)
+        remotePost.foreignID = existing.foreignID
+
+        // When
+        let posts = PostHelper.mergePosts([remotePost], ofType: PostServiceType.post.rawValue, withStatuses: nil, byAuthor: nil, for: blog, purgeExisting: false, in: mainContext)
+
+        // Then
+        XCTAssertIdentical(posts.first as? AbstractPost, existing)
+        XCTAssertEqual(existing.postID, 3)
+    }
+
+    func testMergeSharesFeaturedMediaAndCategoriesAcrossPosts() throws {
+        // Given
+        let blog = BlogBuilder(mainContext).build()
+        let category = RemotePostCategory()
+        category.categoryID = 7
+        category.name = "News"
+
+        let remotePosts = try [4, 5].map {
+            let remotePost = try makeRemotePost(id: $0)
+            remotePost.postThumbnailID = 10
+            remotePost.categories = [category]
+            return remotePost
+        }
+
+        // When
+        let posts = PostHelper.mergePosts(remotePosts, ofType: PostServiceType.post.rawValue, withStatuses: nil, byAuthor: nil, for: blog, purgeExisting: false, in: mainContext).compactMap { $0 as? Post }
+
+        // Then
+        XCTAssertEqual(posts.count, 2)
+        XCTAssertIdentical(posts[0].featuredImage, posts[1].featuredImage)
+        XCTAssertEqual(posts[0].featuredImage?.remoteStatus, .stub)
+        XCTAssertEqual(blog.media?.count, 1)
+        XCTAssertEqual(blog.categories?.count, 1)
+        XCTAssertEqual(posts[0].categories, posts[1].categories)
+    }
+
+    // MARK: - Test Helpers
+
+    private func makeRemotePost(id: Int) throws -> RemotePost {
+        let remotePost = try XCTUnwrap(RemotePost(siteID: 1, status: "publish", title: "Post \(id)", content: "Content"))
+        remotePost.postID = NSNumber(value: id)
+        remotePost.type = PostServiceType.post.rawValue
+        return remotePost
+    }
+}
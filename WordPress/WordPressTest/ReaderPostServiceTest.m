@@ -9,6 +9,8 @@
 #import "WordPressTest-Swift.h"
 @import WordPressKit;
 
+extern NSUInteger const ReaderPostServiceMaxPosts;
+
 @interface ReaderPostService()
 
 - (ReaderPost *)createOrReplaceFromRemotePost:(RemoteReaderPost *)remotePost forTopic:(ReaderAbstractTopic *)topic inContext:(NSManagedObjectContext *)context;
@@ -49,4 +51,66 @@
     XCTAssertEqual([coreDataStack.mainContext countForFetchRequest:[ReaderPost fetchRequest] error:nil], 0, @"The post should have been deleted.");
 }
 
+
+- (void)testBatchUpsertUpdatesExistingPostsAndCollapsesDuplicates {
+    id<CoreDataStack> coreDataStack = [self coreDataStackForTesting];
+
+    [coreDataStack performAndSaveUsingBlock:^(NSManagedObjectContext *context) {
+        RemoteReaderPost *remotePost = [self remoteReaderPostForTests];
+        remotePost.globalID = @"1";
+        [ReaderPost createOrReplaceFromRemotePost:remotePost forTopic:nil context:context];
+    }];
+
+    [coreDataStack performAndSaveUsingBlock:^(NSManagedObjectContext *context) {
+        NSMutableArray<RemoteReaderPost *> *remotePosts = [NSMutableArray array];
+        for (NSString *globalID in @[@"1", @"2", @"2", @"3"]) {
+            RemoteReaderPost *remotePost = [self remoteReaderPostForTests];
+            remotePost.globalID = globalID;
+            remotePost.content = [NSString stringWithFormat:@"<p style=\"color: red\">Post %@</p><script>alert(1)</script>", globalID];
+            [remotePosts addObject:remotePost];
+        }
+
+        NSArray<ReaderPost *> *posts = [ReaderPost createOrReplaceFromRemotePosts:remotePosts forTopic:nil context:context];
+        XCTAssertEqual(posts.count, 4);
+        XCTAssertEqual(posts[1], posts[2]);
+        XCTAssertEqualObjects(posts[0].content, @"<p>Post 1</p>");
+    }];
+
+    XCTAssertEqual([coreDataStack.mainContext countForFetchRequest:[ReaderPost fetchRequest] error:nil], 3);
+}
+
+- (void)testDeletePostsInExcessOfMaxAllowedKeepsSavedPosts {
+    id<CoreDataStack> coreDataStack = [self coreDataStackForTesting];
+    ReaderPostService *service = [[ReaderPostService alloc] initWithCoreDataStack:coreDataStack];
+
+    NSUInteger excess = 5;
+    __block NSManagedObjectID *topicID;
+    [coreDataStack performAndSaveUsingBlock:^(NSManagedObjectContext *context) {
+        NSManagedObject *topic = [NSEntityDescription insertNewObjectForEntityForName:@"ReaderTagTopic" inManagedObjectContext:context];
+        [topic setValue:@"/tags/test" forKey:@"path"];
+        for (NSUInteger i = 0; i < ReaderPostServiceMaxPosts + excess; i++) {
+            ReaderPost *post = [NSEntityDescription insertNewObjectForEntityForName:@"ReaderPost" inManagedObjectContext:context];
+            post.globalID = [NSString stringWithFormat:@"%lu", (unsigned long)i];
+            post.sortRank = @(i);
+            post.topic = (ReaderAbstractTopic *)topic;
+            post.isSavedForLater = (i == 0);
+        }
+        [context obtainPermanentIDsForObjects:@[topic] error:nil];
+        topicID = topic.objectID;
+    }];
+
+    ReaderAbstractTopic *topic = (ReaderAbstractTopic *)[coreDataStack.mainContext existingObjectWithID:topicID error:nil];
+    [service deletePostsInExcessOfMaxAllowedForTopic:topic];
+
+    NSFetchRequest *request = [ReaderPost fetchRequest];
+    request.predicate = [NSPredicate predicateWithFormat:@"topic = %@", topic];
+    XCTAssertEqual([coreDataStack.mainContext countForFetchRequest:request error:nil], ReaderPostServiceMaxPosts);
+
+    request.predicate = [NSPredicate predicateWithFormat:@"globalID = %@", @"0"];
+    ReaderPost *savedPost = [[coreDataStack.mainContext executeFetchRequest:request error:nil] firstObject];
+    XCTAssertNotNil(savedPost, @"Posts saved for later should be kept.");
+    XCTAssertNil(savedPost.topic, @"Posts saved for later should be removed from the topic.");
+    XCTAssertEqual([coreDataStack.mainContext countForFetchRequest:[ReaderPost fetchRequest] error:nil], ReaderPostServiceMaxPosts + 1);
+}
+
 @end
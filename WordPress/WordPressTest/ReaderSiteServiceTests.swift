@@ -97,6 +97,24 @@ class ReaderSiteServiceTests: CoreDataTestCase {
         }
     }
 
+    func testFlagPostsFromSiteAsBlocked() throws {
+        let blockedPost = ReaderPostBuilder(mainContext).build()
+        blockedPost.siteID = 42
+        let otherPost = ReaderPostBuilder(mainContext).build()
+        otherPost.siteID = 43
+        contextManager.saveContextAndWait(mainContext)
+
+        let service = makeService()
+        service.flagPosts(fromSite: 42, asBlocked: true)
+
+        expect(blockedPost.isSiteBlocked).toEventually(beTrue())
+        expect(otherPost.isSiteBlocked) == false
+
+        service.flagPosts(fromSite: 42, asBlocked: false)
+
+        expect(blockedPost.isSiteBlocked).toEventually(beFalse())
+    }
+
     func testFlagAsBlockedFailurePath() {
         let service = makeService()
         let siteID: NSNumber = 42
@@ -124,6 +124,41 @@ class RouteMatcherTests: XCTestCase {
         XCTAssertEqual(values2["test"], "group")
     }
 
+    func testMatchesAreReturnedInRouteOrder() {
+        routes = [ TestRoute(path: "/me/:first"),
+                   TestRoute(path: "/me/account"),
+                   TestRoute(path: "/:section/account"),
+                   TestRoute(path: "/me/:second") ]
+        matcher = RouteMatcher(routes: routes)
+
+        let matches = matcher.routesMatching(URL(string: "/me/account")!) as [Route]
+        XCTAssert(matches.elementsEqual(routes, by: { $0.isEqual(to: $1) }))
+    }
+
+    func testDefaultRoutesMatchInTheSameOrderAsIndividualRoutes() {
+        let routes = UniversalLinkRouter.defaultRoutes
+        matcher = RouteMatcher(routes: routes)
+
+        for url in deepLinks {
+            let matches = matcher.routesMatching(url)
+            let expected = routes.flatMap { RouteMatcher(routes: [$0]).routesMatching(url) }
+            XCTAssertEqual(matches.map(\.path), expected.map(\.path), "Matches differ for \(url)")
+            XCTAssertEqual(matches.map(\.values), expected.map(\.values), "Values differ for \(url)")
+        }
+    }
+
+    func xtestPerformance() {
+        matcher = RouteMatcher(routes: UniversalLinkRouter.defaultRoutes)
+
+        measure {
+            for _ in 0..<100 {
+                for url in deepLinks {
+                    _ = matcher.routesMatching(url)
+                }
+            }
+        }
+    }
+
     // MARK: - Source query item
 
     func testRouteWithNoSourceQueryItem() {
@@ -197,3 +232,38 @@ class RouteMatcherTests: XCTestCase {
         AppBannerRoute().perform(match.values, router: router)
     }
 }
+
+/// A sample of the links handled by the app.
+private let deepLinks: [URL] = [
+    "https://wordpress.com/me",
+    "https://wordpress.com/me/account",
+    "https://wordpress.com/me/notifications",
+    "https://wordpress.com/domains/manage",
+    "https://wordpress.com/post",
+    "https://wordpress.com/post/example.wordpress.com",
+    "https://wordpress.com/posts/example.wordpress.com",
+    "https://wordpress.com/pages/example.wordpress.com",
+    "https://wordpress.com/media/example.wordpress.com",
+    "https://wordpress.com/comments/example.wordpress.com",
+    "https://wordpress.com/notifications",
+    "https://wordpress.com/read",
+    "https://wordpress.com/read/search",
+    "https://wordpress.com/read/blogs/12345",
+    "https://wordpress.com/read/blogs/12345/posts/678",
+    "https://wordpress.com/read/feeds/12345/posts/678",
+    "https://wordpress.com/read/list/alice/favorites",
+    "https://wordpress.com/tag/swift",
+    "https://wordpress.com/discover",
+    "https://wordpress.com/stats",
+    "https://wordpress.com/stats/example.wordpress.com",
+    "https://wordpress.com/stats/day/example.wordpress.com?source=widget",
+    "https://wordpress.com/stats/day/posts/example.wordpress.com",
+    "https://wordpress.com/stats/insights/example.wordpress.com",
+    "https://wordpress.com/stats/subscribers/day/example.wordpress.com",
+    "https://wordpress.com/plugins/manage/example.wordpress.com",
+    "https://wordpress.com/site-monitoring/example.wordpress.com/php",
+    "https://example.wordpress.com/2024/01/15/hello-world",
+    "https://apps.wordpress.com/get/?campaign=qr-code-media#%2Fmedia%2F1234567",
+    "https://wordpress.com/mbar/?redirect_to=%2Fme",
+    "https://wordpress.com/unknown/link",
+].map { URL(string: $0)! }
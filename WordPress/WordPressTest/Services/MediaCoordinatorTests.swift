@@ -5,16 +5,19 @@ import Nimble
 
 class MediaCoordinatorTests: CoreDataTestCase {
     private var coordinator: MediaCoordinator!
+    private var mediaServiceFactory: MediaServiceFactoryMock!
 
     override func setUp() {
         super.setUp()
         contextManager.useAsSharedInstance(untilTestFinished: self)
-        coordinator = MediaCoordinator(MediaServiceFactoryMock(), coreDataStack: contextManager)
+        mediaServiceFactory = MediaServiceFactoryMock()
+        coordinator = MediaCoordinator(mediaServiceFactory, coreDataStack: contextManager)
     }
 
     override func tearDown() {
         super.tearDown()
         coordinator = nil
+        mediaServiceFactory = nil
     }
 
     func testUploadMediaReturnsTrueIfAllPendingMediaAreQueuedForUpload() {
@@ -42,19 +45,134 @@ class MediaCoordinatorTests: CoreDataTestCase {
 
         expect(isPushingAllPendingMedia).to(beFalse())
     }
+
+    func testProgressUpdatesAreCoalescedAndDeliveredBeforeTheNextState() throws {
+        let post = PostBuilder(mainContext).with(image: "test.jpg").build()
+        let otherPost = PostBuilder(mainContext).with(image: "test-002.jpg").build()
+        try mainContext.save()
+        let media = try XCTUnwrap(post.media.first)
+
+        var received: [String: [MediaCoordinator.MediaState]] = [:]
+        let ended = expectation(description: "All observers received the end of the upload")
+        ended.expectedFulfillmentCount = 3
+        func observer(_ name: String) -> MediaCoordinator.ObserverBlock {
+            return { _, state in
+                received[name, default: []].append(state)
+                if case .ended = state {
+                    ended.fulfill()
+                }
+            }
+        }
+        coordinator.addObserver(observer("media"), for: media)
+        coordinator.addObserver(observer("post"), forMediaFor: post)
+        coordinator.addObserver(observer("all"))
+        let removed = coordinator.addObserver(observer("removed"))
+        coordinator.removeObserver(withUUID: removed)
+        coordinator.addObserver(observer("otherPost"), forMediaFor: otherPost)
+
+        for step in 1...10 {
+            coordinator.progress(Double(step) / 10, media: media)
+        }
+        coordinator.end(media)
+        wait(for: [ended], timeout: 1)
+
+        for name in ["media", "post", "all"] {
+            let states = try XCTUnwrap(received[name])
+            let progress = states.compactMap { state -> Double? in
+                guard case .progress(let value) = state else { return nil }
+                return value
+            }
+            XCTAssertEqual(progress, progress.sorted(), "\(name) received progress updates out of order")
+            XCTAssertEqual(progress.last, 1.0)
+            XCTAssertEqual(states.count, progress.count + 1)
+        }
+        XCTAssertNil(received["removed"])
+        XCTAssertNil(received["otherPost"])
+
+        // The coordinator also observes all media items to detect missing files.
+        let observerCount = 4
+        let metrics = coordinator.observerMetrics
+        XCTAssertEqual(metrics.delivered, received.values.map(\.count).reduce(0, +) + received["all"]!.count)
+        XCTAssertEqual(metrics.delivered + metrics.coalesced * observerCount, 11 * observerCount)
+    }
+
+    func testRetryingFailedMediaTwiceUploadsItOnce() throws {
+        let post = PostBuilder(mainContext).with(image: "test.jpg", status: .failed).build()
+        try mainContext.save()
+        let media = try XCTUnwrap(post.media.first)
+
+        let ended = expectation(description: "The upload has ended")
+        coordinator.addObserver({ _, state in
+            if case .ended = state {
+                ended.fulfill()
+            }
+        }, for: media)
+
+        coordinator.retryMedia(media)
+        coordinator.retryMedia(media)
+        expect(self.coordinator.uploadMedia(for: post)).to(beTrue())
+        wait(for: [ended], timeout: 1)
+
+        XCTAssertEqual(mediaServiceFactory.uploadCount, 1)
+    }
+
+    func testMediaDeletedBeforeItsUploadStartsIsCancelled() throws {
+        let post = PostBuilder(mainContext).with(image: "test.jpg", status: .failed).build()
+        try mainContext.save()
+        let media = try XCTUnwrap(post.media.first)
+
+        var states: [MediaCoordinator.MediaState] = []
+        coordinator.addObserver({ _, state in
+            states.append(state)
+        }, for: media)
+
+        // The upload starts asynchronously, after the media is deleted.
+        coordinator.retryMedia(media)
+        coordinator.cancelUploadAndDeleteMedia(media)
+        let cancelled = expectation(for: NSPredicate { _, _ in self.coordinator.uploadScheduler.metrics.cancellations == 1 }, evaluatedWith: nil)
+        wait(for: [cancelled], timeout: 1)
+
+        XCTAssertEqual(mediaServiceFactory.uploadCount, 0)
+        XCTAssertEqual(coordinator.uploadScheduler.metrics.failures, 0)
+        XCTAssertFalse(states.contains { if case .failed = $0 { return true } else { return false } })
+    }
+
+    func testUploadsOfUnknownSizeReportNoBytes() throws {
+        let post = PostBuilder(mainContext)
+            .with(image: "test.jpg", status: .failed)
+            .with(image: "test-002.jpg", status: .failed)
+            .build()
+        try mainContext.save()
+        XCTAssertTrue(post.media.allSatisfy { $0.filesize == nil })
+
+        expect(self.coordinator.uploadMedia(for: post)).to(beTrue())
+        let finished = expectation(for: NSPredicate { _, _ in self.coordinator.uploadScheduler.metrics.uploads == 2 }, evaluatedWith: nil)
+        wait(for: [finished], timeout: 1)
+
+        XCTAssertEqual(coordinator.uploadScheduler.metrics.bytes, 0)
+    }
 }
 
 private class MediaServiceFactoryMock: MediaService.Factory {
+    private(set) var uploadCount = 0
+
     override func create(_ context: NSManagedObjectContext) -> MediaService {
-        return MediaServiceMock(managedObjectContext: context)
+        let service = MediaServiceMock(managedObjectContext: context)
+        service.onUpload = { [weak self] in
+            self?.uploadCount += 1
+        }
+        return service
     }
 }
 
 private class MediaServiceMock: MediaService {
+    var onUpload: (() -> Void)?
+
     override func uploadMedia(_ media: Media, automatedRetry: Bool,
                               progress: AutoreleasingUnsafeMutablePointer<Progress?>?,
                               success: (() -> Void)?,
                               failure: ((Error?) -> Void)? = nil) {
+        onUpload?()
         DispatchQueue.global().async {
             success?()
         }
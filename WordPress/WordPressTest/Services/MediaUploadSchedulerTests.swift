@@ -0,0 +1,114 @@
+import XCTest
+
+@testable import WordPress
+
+class MediaUploadSchedulerTests: XCTestCase {
+
+    func testConcurrencyIsBounded() {
+        let scheduler = MediaUploadScheduler(maxConcurrentUploads: 2)
+        let remote = RemoteStub()
+
+        let completed = expectation(description: "All uploads are completed")
+        completed.expectedFulfillmentCount = 6
+        for index in 0..<6 {
+            scheduler.enqueue(group: "post", size: 100) { completion in
+                remote.upload("file\(index)", bytes: 100, duration: 0.01) { bytes, succeeded in
+                    completion(bytes, succeeded)
+                    completed.fulfill()
+                }
+            }
+        }
+        wait(for: [completed], timeout: 1)
+
+        XCTAssertEqual(remote.maxRunning, 2)
+        XCTAssertEqual(scheduler.metrics.uploads, 6)
+        XCTAssertEqual(scheduler.metrics.bytes, 600)
+    }
+
+    func testPrioritizedPostAndSmallFilesStartFirstAndPostsTakeTurns() {
+        let scheduler = MediaUploadScheduler(maxConcurrentUploads: 1)
+        scheduler.prioritizedGroup = "open"
+        let remote = RemoteStub()
+
+        // Keeps the only slot busy until all the uploads are queued.
+        var releaseGate: (() -> Void)?
+        scheduler.enqueue(group: "gate", size: 0) { completion in
+            releaseGate = { completion(0, true) }
+        }
+
+        let completed = expectation(description: "All uploads are completed")
+        completed.expectedFulfillmentCount = 5
+        let uploads: [(name: String, group: String, size: Int64)] = [
+            ("a", "post1", 300),
+            ("b", "post1", 100),
+            ("c", "post2", 200),
+            ("d", "post2", 50),
+            ("e", "open", 500)
+        ]
+        for upload in uploads {
+            scheduler.enqueue(group: upload.group, size: upload.size) { completion in
+                remote.upload(upload.name, bytes: upload.size, duration: 0) { bytes, succeeded in
+                    completion(bytes, succeeded)
+                    completed.fulfill()
+                }
+            }
+        }
+
+        waitUntil(scheduler.metrics.queueDepth == 5)
+        DispatchQueue.main.async { releaseGate?() }
+        wait(for: [completed], timeout: 1)
+
+        XCTAssertEqual(remote.started, ["e", "b", "d", "a", "c"])
+        XCTAssertEqual(scheduler.metrics.maxQueueDepth, 5)
+        XCTAssertEqual(scheduler.metrics.queueDepth, 0)
+    }
+
+    func testDelayedUploadsWaitAndCancelledUploadsDontStart() {
+        let scheduler = MediaUploadScheduler(maxConcurrentUploads: 2)
+        let remote = RemoteStub()
+
+        let completed = expectation(description: "The delayed upload is completed")
+        let start = CFAbsoluteTimeGetCurrent()
+        scheduler.enqueue(group: "post", size: 100, delay: 0.2) { completion in
+            XCTAssertGreaterThanOrEqual(CFAbsoluteTimeGetCurrent() - start, 0.2)
+            remote.upload("retry", bytes: 100, duration: 0, succeeds: false) { bytes, succeeded in
+                completion(bytes, succeeded)
+                completed.fulfill()
+            }
+        }
+        scheduler.enqueue(group: "post", size: 100, isCancelled: { true }) { _ in
+            XCTFail("A cancelled upload shouldn't start")
+        }
+        wait(for: [completed], timeout: 1)
+
+        XCTAssertEqual(remote.started, ["retry"])
+        XCTAssertEqual(scheduler.metrics.uploads, 1)
+        XCTAssertEqual(scheduler.metrics.failures, 1)
+        XCTAssertEqual(scheduler.metrics.bytes, 0)
+    }
+
+    private func waitUntil(_ condition: @autoclosure () -> Bool, timeout: TimeInterval = 1) {
+        let deadline = Date(timeIntervalSinceNow: timeout)
+        while !condition() && Date() < deadline {
+            RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.01))
+        }
+        XCTAssertTrue(condition())
+    }
+}
+
+/// Simulates the uploads of a `MediaServiceRemote`, on the main queue.
+private final class RemoteStub {
+    private(set) var started: [String] = []
+    private(set) var maxRunning = 0
+    private var running = 0
+
+    func upload(_ name: String, bytes: Int64, duration: TimeInterval, succeeds: Bool = true, completion: @escaping (Int64, Bool) -> Void) {
+        started.append(name)
+        running += 1
+        maxRunning = max(maxRunning, running)
+        DispatchQueue.main.asyncAfter(deadline: .now() + duration) {
+            self.running -= 1
+            completion(succeeds ? bytes : 0, succeeds)
+        }
+    }
+}
@@ -143,6 +143,10 @@ private final class CoreDataStackMock: CoreDataStack {
 
     func performAndSave(_ aBlock: @escaping (NSManagedObjectContext) -> Void) {}
     func performAndSave(_ aBlock: @escaping (NSManagedObjectContext) -> Void, completion: (() -> Void)?, on queue: DispatchQueue) {}
+
+    func execute(_ request: NSPersistentStoreRequest, in context: NSManagedObjectContext) throws -> [NSManagedObjectID] {
+        return []
+    }
 }
 
 // MARK: - KeychainUtilsMock
@@ -74,6 +74,105 @@ final class StringRankedSearchTests: XCTestCase {
             }
         }
     }
+
+    // MARK: - StringRankedSearchIndex
+
+    func testIndexFindsTheSameItemsAsSearch() {
+        let items = makeItems(count: 500) + [
+            Item(id: -1, name: "John O'Appleseed"),
+            Item(id: -2, name: "#john-appleseed"),
+            Item(id: -3, name: "Kāhu Straße"),
+            Item(id: -4, name: "   "),
+        ]
+        let index = StringRankedSearchIndex(items, input: \.name)
+
+        for term in ["App", "apseed", "j-a", "John Appleseed", "kahu", "strasse", "a", "xyz", "site 42", "blog test", "  "] {
+            let expected = StringRankedSearch(searchTerm: term).search(in: items, input: \.name)
+            XCTAssertEqual(index.search(term).map(\.id), expected.map(\.id), "Results differ for \"\(term)\"")
+        }
+    }
+
+    func testIndexUpdatesIncrementally() {
+        var index = StringRankedSearchIndex<Item>(input: \.name)
+        index.insert(Item(id: 1, name: "John Appleseed"))
+        index.insert(Item(id: 2, name: "Jane Appleseed"))
+        XCTAssertEqual(index.search("Appleseed").map(\.id), [1, 2])
+
+        index.remove(id: 1)
+        XCTAssertEqual(index.search("Appleseed").map(\.id), [2])
+
+        index.insert(Item(id: 2, name: "Jane Doe"))
+        XCTAssertEqual(index.search("Appleseed").map(\.id), [])
+        XCTAssertEqual(index.search("Doe").map(\.id), [2])
+        XCTAssertEqual(index.count, 1)
+    }
+
+    func testIndexReturnsItemsWithTheSameScoreInTheGivenOrder() {
+        var index = StringRankedSearchIndex<Item>(input: \.name)
+        index.insert(Item(id: 1, name: "Appleseed"))
+        index.insert(Item(id: 2, name: "Appleseed"))
+        index.insert(Item(id: 3, name: "Appleseed"))
+        XCTAssertEqual(index.search("Appleseed").map(\.id), [1, 2, 3])
+
+        index.setOrder([3, 1])
+        XCTAssertEqual(index.search("Appleseed").map(\.id), [3, 1, 2])
+
+        // Updating an item keeps its position.
+        index.insert(Item(id: 3, name: "Appleseed"))
+        XCTAssertEqual(index.search("Appleseed").map(\.id), [3, 1, 2])
+    }
+
+    func testIndexFindsTheSameItemsAsSearchForLongSearchTerms() {
+        let items = makeItems(count: 500)
+        let index = StringRankedSearchIndex(items, input: \.name)
+        let words = ["Travel", "Photos", "travelphotos42.wordpress.com", "Garden", "Recipes", "Journal", "News", "Blog", "Site", "Test"]
+
+        for count in [5, 10, 15, 20, 25] {
+            let term = (0..<count).map { words[$0 % words.count] }.joined(separator: " ")
+            for minScore in [0.3, 0.5, 0.7] {
+                let expected = StringRankedSearch(searchTerm: term).search(in: items, minScore: minScore, input: \.name)
+                XCTAssertEqual(index.search(term, minScore: minScore).map(\.id), expected.map(\.id), "Results differ for \(count) terms")
+            }
+        }
+    }
+
+    func xtestIndexPerformance1K() {
+        measureIndexSearch(count: 1_000)
+    }
+
+    func xtestIndexPerformance10K() {
+        measureIndexSearch(count: 10_000)
+    }
+
+    func xtestIndexPerformance50K() {
+        measureIndexSearch(count: 50_000)
+    }
+
+    private func measureIndexSearch(count: Int) {
+        let items = makeItems(count: count)
+        let index = StringRankedSearchIndex(items, input: \.name)
+        // Simulates typing a search term, one keystroke at a time.
+        let keystrokes = ["m", "my", "my ", "my b", "my bl", "my blo", "my blog"]
+
+        measure {
+            for term in keystrokes {
+                _ = index.search(term)
+            }
+        }
+    }
+}
+
+private struct Item: Identifiable {
+    let id: Int
+    let name: String
+}
+
+private func makeItems(count: Int) -> [Item] {
+    let words = ["My", "Blog", "Travel", "Photos", "Site", "Test", "Recipes", "Journal", "Garden", "News"]
+    return (0..<count).map { index in
+        let name = "\(words[index % words.count]) \(words[(index / words.count) % words.count]) \(index)"
+        return Item(id: index, name: "\(name) \(name.lowercased().replacingOccurrences(of: " ", with: "")).wordpress.com")
+    }
 }
 
 private func score(_ lhs: String, _ rhs: String) -> Double {
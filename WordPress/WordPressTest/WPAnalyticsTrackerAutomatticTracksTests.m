@@ -18,6 +18,12 @@
 @property (nonatomic, strong) TracksService *tracksService;
 @property (nonatomic, strong) TracksContextManager *contextManager;
 
+@property (nonatomic, strong) dispatch_queue_t trackingQueue;
+
+- (void)waitUntilEventsAreSent;
+- (NSUInteger)droppedEventCount;
+- (void)enqueueMetadataWithUsername:(NSString *)username accountPresent:(BOOL)accountPresent userProperties:(NSDictionary *)userProperties;
+
 @end
 
 @implementation WPAnalyticsTrackerAutomatticTracksTests
@@ -38,7 +44,8 @@
 }
 
 - (void)testVerifyTracksNamesMappings {
-    for (NSUInteger x = 0; x <= WPAnalyticsStatMaxValue; ++x) {
+    // Includes the stats declared after WPAnalyticsStatMaxValue.
+    for (NSUInteger x = 0; x <= WPAnalyticsStatDebugDeletedOrphanedEntities; ++x) {
         OCMExpect(([self.serviceMock trackEventName:[OCMArg checkWithBlock:^BOOL(id obj) {
             TracksEvent *tracksEvent = [TracksEvent new];
             tracksEvent.uuid = [NSUUID UUID];
@@ -57,6 +64,85 @@
 
         [self.subject track:(WPAnalyticsStat)x];
     }
+
+    [self.subject waitUntilEventsAreSent];
+}
+
+- (void)testStatsAfterMaxValueAreTracked {
+    OCMExpect([self.serviceMock trackEventName:@"debug_deleted_orphaned_entities" withCustomProperties:[OCMArg any]]);
+
+    [self.subject track:WPAnalyticsStatDebugDeletedOrphanedEntities];
+    [self.subject waitUntilEventsAreSent];
+
+    OCMVerifyAll(self.serviceMock);
+}
+
+- (void)testEventsAreSentInOrder {
+    NSMutableArray<NSString *> *sentEvents = [NSMutableArray new];
+    OCMStub([self.serviceMock trackEventName:[OCMArg any] withCustomProperties:[OCMArg any]]).andDo(^(NSInvocation *invocation) {
+        __unsafe_unretained NSString *eventName;
+        [invocation getArgument:&eventName atIndex:2];
+        [sentEvents addObject:eventName];
+    });
+
+    NSMutableArray<NSString *> *trackedEvents = [NSMutableArray new];
+    for (NSUInteger index = 0; index < 1000; ++index) {
+        NSString *eventName = [NSString stringWithFormat:@"event_%lu", (unsigned long)index];
+        [trackedEvents addObject:eventName];
+        [self.subject trackString:eventName withProperties:@{ @"index": @(index) }];
+        if (index % 100 == 99) {
+            [self.subject waitUntilEventsAreSent];
+        }
+    }
+    [self.subject waitUntilEventsAreSent];
+
+    XCTAssertEqualObjects(sentEvents, trackedEvents);
+    XCTAssertEqual([self.subject droppedEventCount], 0);
+}
+
+- (void)testEventsAreDroppedWhenTheBufferIsFull {
+    __block NSUInteger sentEventCount = 0;
+    OCMStub([self.serviceMock trackEventName:[OCMArg any] withCustomProperties:[OCMArg any]]).andDo(^(NSInvocation *invocation) {
+        sentEventCount += 1;
+    });
+
+    // Tracking from the tracking queue keeps the buffer from being drained, and mustn't block.
+    dispatch_sync(self.subject.trackingQueue, ^{
+        for (NSUInteger index = 0; index < 300; ++index) {
+            [self.subject trackString:@"event"];
+        }
+    });
+    [self.subject waitUntilEventsAreSent];
+
+    XCTAssertEqual(sentEventCount, 240);
+    XCTAssertEqual([self.subject droppedEventCount], 60);
+}
+
+- (void)testUserChangesBetweenTheEventsTrackedBeforeAndAfterIt {
+    NSMutableArray<NSString *> *calls = [NSMutableArray new];
+    OCMStub([self.serviceMock trackEventName:[OCMArg any] withCustomProperties:[OCMArg any]]).andDo(^(NSInvocation *invocation) {
+        __unsafe_unretained NSString *eventName;
+        [invocation getArgument:&eventName atIndex:2];
+        [calls addObject:eventName];
+    });
+    OCMStub([self.serviceMock userProperties]).andReturn([NSMutableDictionary new]);
+    OCMStub([self.serviceMock switchToAnonymousUserWithAnonymousID:[OCMArg any]]).andDo(^(NSInvocation *invocation) {
+        [calls addObject:@"anonymous"];
+    });
+
+    // The tracking queue is kept busy, so nothing is sent until all the calls are made.
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    dispatch_async(self.subject.trackingQueue, ^{
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    });
+    [self.subject trackString:@"before_logout"];
+    [self.subject enqueueMetadataWithUsername:nil accountPresent:NO userProperties:@{}];
+    [self.subject trackString:@"after_logout"];
+    dispatch_semaphore_signal(semaphore);
+    [self.subject waitUntilEventsAreSent];
+
+    NSArray *expectedCalls = @[@"before_logout", @"anonymous", @"after_logout"];
+    XCTAssertEqualObjects(calls, expectedCalls);
 }
 
 @end
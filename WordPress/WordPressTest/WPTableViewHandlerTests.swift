@@ -0,0 +1,163 @@
+import XCTest
+import CoreData
+
+@testable import WordPress
+
+class WPTableViewHandlerTests: CoreDataTestCase {
+    private var tableView: UITableView!
+    private var delegate: TableViewHandlerDelegateMock!
+    private var handler: WPTableViewHandler!
+
+    override func setUp() {
+        super.setUp()
+
+        tableView = UITableView(frame: CGRect(x: 0, y: 0, width: 320, height: 480))
+        delegate = TableViewHandlerDelegateMock(context: mainContext)
+        handler = WPTableViewHandler(tableView: tableView)
+        handler.cacheRowHeights = true
+        handler.delegate = delegate
+    }
+
+    override func tearDown() {
+        handler = nil
+        delegate = nil
+        tableView = nil
+        super.tearDown()
+    }
+
+    func testInsertsAndMovesKeepCachedHeights() throws {
+        AccountBuilder(mainContext).with(username: "b").build()
+        let account = AccountBuilder(mainContext).with(username: "d").build()
+        try mainContext.save()
+        reloadTable()
+
+        XCTAssertEqual(heights(), [44, 44])
+        XCTAssertEqual(delegate.computedUsernames.sorted(), ["b", "d"])
+
+        // Inserts "a" before the other rows.
+        AccountBuilder(mainContext).with(username: "a").build()
+        try mainContext.save()
+        // Moves "d" before the other rows.
+        account.username = "0"
+        try mainContext.save()
+
+        // Only the height of the new row is computed.
+        XCTAssertEqual(heights(), [44, 44, 44])
+        XCTAssertEqual(delegate.computedUsernames.sorted(), ["a", "b", "d"])
+    }
+
+    func testUpdateInvalidatesTheCachedHeight() throws {
+        let account = AccountBuilder(mainContext).with(username: "a").build()
+        AccountBuilder(mainContext).with(username: "b").build()
+        try mainContext.save()
+        reloadTable()
+
+        XCTAssertEqual(heights(), [44, 44])
+
+        delegate.height = 60
+        account.displayName = "Updated"
+        try mainContext.save()
+
+        XCTAssertEqual(heights(), [60, 44])
+        XCTAssertEqual(delegate.computedUsernames.sorted(), ["a", "a", "b"])
+    }
+
+    func testHitAndMissCounters() throws {
+        AccountBuilder(mainContext).with(username: "a").build()
+        AccountBuilder(mainContext).with(username: "b").build()
+        try mainContext.save()
+
+        _ = heights()
+        XCTAssertEqual(handler.cachedRowHeightHits, 0)
+        XCTAssertEqual(handler.cachedRowHeightMisses, 2)
+
+        _ = heights()
+        XCTAssertEqual(handler.cachedRowHeightHits, 2)
+        XCTAssertEqual(handler.cachedRowHeightMisses, 2)
+
+        handler.invalidateCachedRowHeight(at: IndexPath(row: 0, section: 0))
+        _ = heights()
+        XCTAssertEqual(handler.cachedRowHeightHits, 3)
+        XCTAssertEqual(handler.cachedRowHeightMisses, 3)
+        XCTAssertEqual(delegate.computedUsernames, ["a", "b", "a"])
+    }
+
+    func testInvalidationRemovesTheHeightsForAllWidths() throws {
+        AccountBuilder(mainContext).with(username: "a").build()
+        AccountBuilder(mainContext).with(username: "b").build()
+        try mainContext.save()
+
+        // The heights are cached for the table view's width, and precomputed for another width.
+        _ = heights()
+        handler.refreshCachedRowHeights(forWidth: 500)
+        handler.refreshCachedRowHeights(forWidth: 500)
+        XCTAssertEqual(delegate.precomputedUsernames, ["a", "b"])
+        XCTAssertEqual(handler.cachedRowHeightCount, 4)
+
+        handler.invalidateCachedRowHeight(at: IndexPath(row: 0, section: 0))
+
+        // Only the heights of "b" are left.
+        XCTAssertEqual(handler.cachedRowHeightCount, 2)
+        handler.refreshCachedRowHeights(forWidth: 500)
+        XCTAssertEqual(delegate.precomputedUsernames, ["a", "b", "a"])
+        XCTAssertEqual(handler.cachedRowHeightCount, 3)
+    }
+
+    // MARK: - Helpers
+
+    /// Loads the rows in the table view, so that it can apply the changes of the results controller.
+    private func reloadTable() {
+        tableView.reloadData()
+        tableView.layoutIfNeeded()
+    }
+
+    private func heights() -> [CGFloat] {
+        let count = handler.tableView(tableView, numberOfRowsInSection: 0)
+        return (0..<count).map {
+            handler.tableView(tableView, heightForRowAt: IndexPath(row: $0, section: 0))
+        }
+    }
+}
+
+private final class TableViewHandlerDelegateMock: NSObject, WPTableViewHandlerDelegate {
+    let context: NSManagedObjectContext
+    var height: CGFloat = 44
+    private(set) var computedUsernames: [String] = []
+    private(set) var precomputedUsernames: [String] = []
+
+    init(context: NSManagedObjectContext) {
+        self.context = context
+    }
+
+    func managedObjectContext() -> NSManagedObjectContext {
+        context
+    }
+
+    func fetchRequest() -> NSFetchRequest<NSFetchRequestResult>? {
+        let request = NSFetchRequest<NSFetchRequestResult>(entityName: WPAccount.entityName())
+        request.sortDescriptors = [NSSortDescriptor(key: "username", ascending: true)]
+        return request
+    }
+
+    func configureCell(_ cell: UITableViewCell, at indexPath: IndexPath) {
+    }
+
+    func tableView(_ tableView: UITableView, didSelectRowAt indexPath: IndexPath) {
+    }
+
+    func tableView(_ tableView: UITableView, heightForRowAt indexPath: IndexPath) -> CGFloat {
+        computedUsernames.append(username(at: indexPath))
+        return height
+    }
+
+    func tableView(_ tableView: UITableView, heightForRowAt indexPath: IndexPath, forWidth width: CGFloat) -> CGFloat {
+        precomputedUsernames.append(username(at: indexPath))
+        return height
+    }
+
+    private func username(at indexPath: IndexPath) -> String {
+        let request = fetchRequest()!
+        let accounts = (try? context.fetch(request)) as? [WPAccount] ?? []
+        return accounts[indexPath.row].username
+    }
+}